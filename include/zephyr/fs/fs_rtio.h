@@ -0,0 +1,77 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_FS_FS_RTIO_H_
+#define ZEPHYR_INCLUDE_FS_FS_RTIO_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief File System RTIO API
+ * @defgroup file_system_rtio_api File System RTIO API
+ * @since 4.3
+ * @version 0.1.0
+ * @ingroup file_system_api
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+
+/* File RTIO iodev data, reserved for the implementation */
+struct fs_rtio {
+	/* File the operations are made on */
+	struct fs_file_t *file;
+
+	/* Serializes the operations made by the work-queue threads */
+	struct k_mutex lock;
+};
+
+extern const struct rtio_iodev_api fs_rtio_api;
+
+/** @endcond */
+
+/**
+ * @brief Statically define a file RTIO iodev
+ *
+ * The iodev makes the @ref RTIO_OP_RX operations with fs_read() and the
+ * @ref RTIO_OP_TX and @ref RTIO_OP_TINY_TX operations with fs_write(),
+ * at the current position of @p file, which must be open before
+ * operations are submitted.  They complete with the number of bytes
+ * read or written.  Reads from the memory pool of the RTIO context take
+ * a buffer of up to @kconfig{CONFIG_FILE_SYSTEM_RTIO_POOL_RX_SIZE}
+ * bytes, and multishot reads end at the end of the file with a result
+ * of 0.
+ *
+ * The operations are made by the RTIO work-queue threads, so the
+ * submitter is not blocked by the file system.  Operations that are not
+ * chained may run in any order: chain them to keep the file position
+ * they are made at.
+ *
+ * @param name Name of the iodev
+ * @param file_ptr Pointer to the @ref fs_file_t of the file
+ */
+#define FS_RTIO_IODEV_DEFINE(name, file_ptr)                                                       \
+	static struct fs_rtio _fs_rtio_##name = {                                                  \
+		.file = (file_ptr),                                                                \
+		.lock = Z_MUTEX_INITIALIZER(_fs_rtio_##name.lock),                                 \
+	};                                                                                         \
+	RTIO_IODEV_DEFINE(name, &fs_rtio_api, &_fs_rtio_##name)
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_FS_FS_RTIO_H_ */
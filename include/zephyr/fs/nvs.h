@@ -49,7 +49,7 @@ struct nvs_fs {
 	uint32_t data_wra;
 	/** File system is split into sectors, each sector must be multiple of erase-block-size */
 	uint32_t sector_size;
-	/** Number of sectors in the file system */
+	/** Number of sectors in the file system, including the index sector if enabled */
 	uint16_t sector_count;
 	/** Flag indicating if the file system is initialized */
 	bool ready;
@@ -62,6 +62,10 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_INDEX
+	/** Next checkpoint slot in the index sector */
+	uint16_t index_slot;
+#endif
 };
 
 /**
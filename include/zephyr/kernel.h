@@ -3130,6 +3130,11 @@ struct k_mutex {
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	struct k_obj_core obj_core;
 #endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	/** Contention statistics */
+	struct k_lock_stats lock_stats;
+#endif
 };
 
 /**
@@ -3333,6 +3338,10 @@ struct k_sem {
 #ifdef CONFIG_OBJ_CORE_SEM
 	struct k_obj_core  obj_core;
 #endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	struct k_lock_stats lock_stats;
+#endif
 	/** @endcond */
 };
 
@@ -4378,9 +4387,11 @@ struct k_work_q {
 	 */
 	k_tid_t thread_id;
 
-	/* All the following fields must be accessed only while the
-	 * work module spinlock is held.
+	/* Lock protecting the following fields.  Work item state is
+	 * protected by a separate work module lock, which must be taken
+	 * before this one when both are needed.
 	 */
+	struct k_spinlock lock;
 
 	/* List of k_work items to be worked. */
 	sys_slist_t pending;
@@ -6557,6 +6568,60 @@ void k_sys_runtime_stats_enable(void);
  */
 void k_sys_runtime_stats_disable(void);
 
+#if defined(CONFIG_SCHED_WAKEUP_LATENCY_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the wakeup latency statistics of a thread
+ *
+ * The wakeup latency is the time from the thread being made ready, for
+ * example when it is given a semaphore it waits for, to the thread being
+ * switched in.
+ *
+ * @param thread ID of thread.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int k_thread_wakeup_latency_get(k_tid_t thread, struct k_sched_latency_stats *stats);
+
+/**
+ * @brief Reset the wakeup latency statistics of a thread
+ *
+ * @param thread ID of thread.
+ * @return -EINVAL if invalid thread ID, otherwise 0
+ */
+int k_thread_wakeup_latency_reset(k_tid_t thread);
+
+/**
+ * @brief Get the wakeup latency statistics of a priority level
+ *
+ * The statistics cover the wakeups of all the threads switched in at
+ * priority @a prio.
+ *
+ * @param prio Thread priority.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if invalid priority or null pointer, otherwise 0
+ */
+int k_sched_wakeup_latency_get(int prio, struct k_sched_latency_stats *stats);
+
+/**
+ * @brief Reset the wakeup latency statistics of all priority levels
+ */
+void k_sched_wakeup_latency_reset(void);
+
+/**
+ * @brief Get a percentile of wakeup latency statistics
+ *
+ * The percentile is estimated from the histogram: the upper bound of the
+ * bin holding it is returned, bounded by the shortest and longest latency.
+ *
+ * @param stats Wakeup latency statistics.
+ * @param percent Percentile, e.g. 99 for the latency 99% of the wakeups
+ *                do not exceed.
+ * @return Latency in cycles, 0 if no wakeup was measured
+ */
+uint32_t k_sched_latency_percentile(const struct k_sched_latency_stats *stats,
+				    unsigned int percent);
+#endif /* CONFIG_SCHED_WAKEUP_LATENCY_STATS */
+
 #ifdef __cplusplus
 }
 #endif
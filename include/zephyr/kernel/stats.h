@@ -30,4 +30,108 @@ struct k_cycle_stats {
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
+/**
+ * @brief Get the bin of a duration in a log2 cycle histogram
+ *
+ * Bin i of a histogram of @p num_bins bins counts the durations of 2^i to
+ * 2^(i+1) - 1 cycles, the last bin also counts all the longer durations.
+ *
+ * @param cycles Duration in cycles
+ * @param num_bins Number of bins of the histogram
+ * @return Index of the bin
+ */
+static inline unsigned int z_cycle_hist_bin(uint32_t cycles, unsigned int num_bins)
+{
+	unsigned int bin = 31U - (unsigned int)__builtin_clz(cycles | 1U);
+
+	return (bin < num_bins) ? bin : num_bins - 1U;
+}
+
+/**
+ * @brief Count a duration in a log2 cycle histogram
+ *
+ * Must be called with the histogram protected against concurrent updates.
+ *
+ * @param bins Bins of the histogram
+ * @param num_bins Number of bins of the histogram
+ * @param cycles Duration in cycles
+ */
+static inline void z_cycle_hist_record(uint32_t *bins, unsigned int num_bins, uint32_t cycles)
+{
+	bins[z_cycle_hist_bin(cycles, num_bins)]++;
+}
+
+/**
+ * @brief Estimate a percentile of the durations of a log2 cycle histogram
+ *
+ * The upper bound of the bin holding the percentile is returned, bounded by
+ * the shortest and longest duration counted.
+ *
+ * @param bins Bins of the histogram
+ * @param num_bins Number of bins of the histogram
+ * @param percent Percentile, e.g. 99 for the duration 99% of the counted
+ *                durations do not exceed
+ * @param min Shortest duration counted, in cycles
+ * @param max Longest duration counted, in cycles
+ * @return Duration in cycles, 0 if the histogram is empty
+ */
+uint32_t z_cycle_hist_percentile(const uint32_t *bins, unsigned int num_bins,
+				 unsigned int percent, uint32_t min, uint32_t max);
+
+#if defined(CONFIG_LOCK_CONTENTION_STATS) || defined(__DOXYGEN__)
+struct k_thread;
+
+/**
+ * Structure used to track contention statistics of a lock: mutex,
+ * semaphore or spinlock.
+ */
+
+struct k_lock_stats {
+	uint32_t  acquired;     /**< \# of successful acquisitions */
+	uint32_t  contended;    /**< \# of waits for the lock */
+	uint64_t  wait_total;   /**< total wait in cycles */
+	uint32_t  wait_max;     /**< longest wait in cycles */
+	/** Bin i counts the waits of 2^i to 2^(i+1) - 1 cycles */
+	uint32_t  wait_bins[CONFIG_LOCK_CONTENTION_STATS_BINS];
+	/**
+	 * Address of the thread holding the lock during the longest wait,
+	 * 0 if unknown. The thread may have exited since, so this is only
+	 * meant to be compared and must never be dereferenced.
+	 */
+	uintptr_t max_holder;
+#if defined(CONFIG_THREAD_NAME) || defined(__DOXYGEN__)
+	/** Name of that thread, copied when the wait was recorded */
+	char max_holder_name[CONFIG_THREAD_MAX_NAME_LEN];
+#endif
+};
+
+/**
+ * @brief Record a wait for a lock
+ *
+ * Must be called with the statistics protected against concurrent updates.
+ *
+ * @param stats Statistics of the lock
+ * @param cycles Wait time in cycles
+ * @param holder Thread holding the lock when the wait started, NULL if unknown
+ */
+void z_lock_stats_wait(struct k_lock_stats *stats, uint32_t cycles,
+		       struct k_thread *holder);
+#endif /* CONFIG_LOCK_CONTENTION_STATS */
+
+#if defined(CONFIG_SCHED_WAKEUP_LATENCY_STATS) || defined(__DOXYGEN__)
+/**
+ * Structure used to track the wakeup latency of threads: the time from
+ * a thread being made ready to it being switched in.
+ */
+
+struct k_sched_latency_stats {
+	uint32_t  count;        /**< \# of measured wakeups */
+	uint32_t  min;          /**< shortest latency in cycles */
+	uint32_t  max;          /**< longest latency in cycles */
+	uint64_t  total;        /**< total latency in cycles */
+	/** Bin i counts the latencies of 2^i to 2^(i+1) - 1 cycles */
+	uint32_t  bins[CONFIG_SCHED_WAKEUP_LATENCY_STATS_BINS];
+};
+#endif /* CONFIG_SCHED_WAKEUP_LATENCY_STATS */
+
 #endif /* ZEPHYR_INCLUDE_KERNEL_STATS_H_ */
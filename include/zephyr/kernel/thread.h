@@ -135,6 +135,16 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif /* CONFIG_SCHED_THREAD_USAGE */
+
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY_STATS
+	/* Cycle count when the thread was made ready */
+	uint32_t ready_stamp;
+
+	/* true if the thread was made ready and not switched in yet */
+	bool ready_pending;
+
+	struct k_sched_latency_stats wakeup_latency;
+#endif /* CONFIG_SCHED_WAKEUP_LATENCY_STATS */
 };
 
 typedef struct _thread_base _thread_base_t;
@@ -0,0 +1,64 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Header file for the flash log backend API
+ * @ingroup log_backend_flash
+ */
+
+#ifndef ZEPHYR_LOG_BACKEND_FLASH_H_
+#define ZEPHYR_LOG_BACKEND_FLASH_H_
+
+/**
+ * @brief Flash log backend API
+ * @defgroup log_backend_flash Flash log backend API
+ * @ingroup log_backend
+ * @{
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Callback receiving the log records stored in flash.
+ *
+ * @param data Dictionary based log data of one record.
+ * @param len Length of @p data.
+ * @param user_data User data given to log_backend_flash_read().
+ *
+ * @return 0 to continue reading, any other value to stop.
+ */
+typedef int (*log_backend_flash_read_cb_t)(const uint8_t *data, size_t len, void *user_data);
+
+/**
+ * @brief Read the log records stored in flash.
+ *
+ * The records are read from the oldest to the newest. Concatenated, their data forms the log
+ * stream decoded by the dictionary logging parser.
+ *
+ * @param cb Callback receiving each record.
+ * @param user_data User data passed to @p cb.
+ *
+ * @retval 0 if all records were read.
+ * @retval -ENODEV if the log partition is not usable.
+ * @retval -EIO on flash errors.
+ * @return The non-zero value @p cb returned, if it stopped the read.
+ */
+int log_backend_flash_read(log_backend_flash_read_cb_t cb, void *user_data);
+
+/**
+ * @brief Erase the log records stored in flash.
+ *
+ * @retval 0 on success.
+ * @retval -ENODEV if the log partition is not usable.
+ * @retval -EIO on flash errors.
+ */
+int log_backend_flash_clear(void);
+
+/** @} */
+
+#endif /* ZEPHYR_LOG_BACKEND_FLASH_H_ */
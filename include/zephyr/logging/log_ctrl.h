@@ -295,6 +295,69 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage);
  */
 int log_mem_get_max_usage(uint32_t *max);
 
+/** @brief Statistics of the log message buffer of a CPU. */
+struct log_cpu_stats {
+	/** Number of messages dropped because the buffer had no room for them. */
+	uint32_t dropped;
+	/** Number of pending messages overwritten by newer ones. */
+	uint32_t overwritten;
+	/** Capacity of the buffer, in bytes. */
+	uint32_t buf_size;
+	/** Number of bytes currently containing pending log messages. */
+	uint32_t usage;
+	/** Maximum number of bytes used, 0 if CONFIG_LOG_MEM_UTILIZATION is disabled. */
+	uint32_t max_usage;
+};
+
+/**
+ * @brief Get statistics of the log message buffer of a CPU.
+ *
+ * Requires CONFIG_LOG_PER_CPU_BUFFERS option.
+ *
+ * @param cpu CPU index.
+ * @param[out] stats Statistics.
+ *
+ * @retval 0 successfully collected statistics.
+ * @retval -EINVAL if @p cpu is not a valid CPU index.
+ * @retval -ENOTSUP if per-CPU buffers are not enabled.
+ */
+int log_cpu_stats_get(unsigned int cpu, struct log_cpu_stats *stats);
+
+/** @brief Message flood throttling settings. */
+struct log_throttle_config {
+	/** Messages allowed from a call site in an interval, 0 to disable rate limiting. */
+	uint32_t burst;
+	/** Rate limiting interval, in milliseconds. */
+	uint32_t interval_ms;
+	/** Collapse messages identical to the previous one. */
+	bool collapse;
+};
+
+/**
+ * @brief Set message flood throttling settings.
+ *
+ * Requires CONFIG_LOG_THROTTLE option.
+ *
+ * @param config Settings.
+ *
+ * @retval 0 on successful operation.
+ * @retval -EINVAL if interval is 0.
+ * @retval -ENOTSUP if feature is disabled.
+ */
+int log_throttle_config_set(const struct log_throttle_config *config);
+
+/**
+ * @brief Get message flood throttling settings.
+ *
+ * Requires CONFIG_LOG_THROTTLE option.
+ *
+ * @param[out] config Settings.
+ *
+ * @retval 0 on successful operation.
+ * @retval -ENOTSUP if feature is disabled.
+ */
+int log_throttle_config_get(struct log_throttle_config *config);
+
 #if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MODE_MINIMAL)
 #define LOG_CORE_INIT() log_core_init()
 #define LOG_PANIC() log_panic()
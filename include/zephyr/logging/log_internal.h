@@ -130,6 +130,25 @@ void z_log_msg_free(union log_msg_generic *msg);
  */
 bool z_log_msg_pending(void);
 
+/** @brief Check if a message shall be dropped because of throttling.
+ *
+ * Called before the message is allocated. May log a report of messages
+ * previously dropped by throttling.
+ *
+ * @param source	Source.
+ * @param level		Severity level.
+ * @param fmt		Format string identifying the call site. May be NULL.
+ * @param content	Message content (package or arguments).
+ * @param len		Length of @p content.
+ * @param data		Data. May be NULL.
+ * @param dlen		Length of @p data.
+ *
+ * @retval true if message shall be dropped.
+ * @retval false if message shall be created.
+ */
+bool z_log_msg_throttle(const void *source, uint8_t level, const char *fmt,
+			const void *content, size_t len, const void *data, size_t dlen);
+
 static inline void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
 				     const union mpsc_pbuf_generic *item)
 {
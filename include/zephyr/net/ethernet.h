@@ -202,6 +202,12 @@ enum ethernet_hw_caps {
 
 	/** TX-Injection supported */
 	ETHERNET_TXINJECTION_MODE	= BIT(20),
+
+	/** TCP segmentation offload (TSO) supported. The driver gets TCP packets
+	 *  larger than the MTU, to be split into segments carrying
+	 *  net_pkt_gso_size() bytes of payload each.
+	 */
+	ETHERNET_HW_TSO			= BIT(21),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -264,6 +264,12 @@ struct msghdr {
 	int           msg_flags;      /**< Flags on received message */
 };
 
+/** Message struct for sending or receiving multiple messages in one call */
+struct mmsghdr {
+	struct msghdr msg_hdr;        /**< Message header */
+	unsigned int  msg_len;        /**< Number of bytes transferred */
+};
+
 /** Control message ancillary data */
 struct cmsghdr {
 	socklen_t cmsg_len;    /**< Number of bytes, including header */
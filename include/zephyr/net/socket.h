@@ -78,6 +78,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: Override operation to non-blocking after the first message */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -538,6 +540,95 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Send multiple messages with a single call
+ *
+ * @details
+ * Sends up to @p vlen messages, as if zsock_sendmsg() was called for each of
+ * them, but the socket is looked up and locked only once for the whole batch.
+ * On return, the msg_len field of each sent message holds the number of bytes
+ * sent. This is mostly useful with datagram sockets.
+ * This function is also exposed as `sendmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket to send the messages to
+ * @param msgvec Array of messages
+ * @param vlen Number of messages in @p msgvec
+ * @param flags Flags passed to each zsock_sendmsg() call
+ *
+ * @return Number of messages sent. If an error occurs after at least one
+ *         message was sent, the number of messages sent so far is returned.
+ *         Otherwise -1 is returned and errno is set.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			     int flags);
+
+/**
+ * @brief Receive multiple messages with a single call
+ *
+ * @details
+ * Receives up to @p vlen messages, as if zsock_recvmsg() was called for each
+ * of them, but the socket is looked up and locked only once for the whole
+ * batch. On return, the msg_len field of each received message holds the
+ * number of bytes received. With @ref ZSOCK_MSG_WAITFORONE, only the first
+ * message is waited for and the call returns as soon as no more data is
+ * pending. This is mostly useful with datagram sockets.
+ * This function is also exposed as `recvmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket to receive the messages from
+ * @param msgvec Array of messages
+ * @param vlen Number of messages in @p msgvec
+ * @param flags Flags passed to each zsock_recvmsg() call
+ *
+ * @return Number of messages received. If an error occurs after at least one
+ *         message was received, the number of messages received so far is
+ *         returned. Otherwise -1 is returned and errno is set.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			     int flags);
+
+/**
+ * @brief Receive data without copying it to the application
+ *
+ * @details
+ * Instead of copying the received data, the iovecs of @p msg are set to
+ * point to the network buffers holding the data, and msg_iovlen is updated
+ * to the number of iovecs used. The data is read only and stays valid until
+ * @p handle is passed to zsock_recvmsg_zc_release(). For stream sockets at
+ * most the data of one received segment is returned per call. For datagram
+ * sockets, ZSOCK_MSG_TRUNC is set in msg_flags if @p msg did not have enough
+ * iovecs to describe the whole datagram. Control data is not supported.
+ *
+ * The zero-copy path is only available with
+ * @kconfig{CONFIG_NET_SOCKETS_RECV_ZEROCOPY} for native IP sockets, and
+ * only for supervisor threads. Otherwise the data is copied to the buffers
+ * given in the iovecs, exactly as zsock_recvmsg() would do, and @p handle
+ * is set to NULL. In both cases the data can be consumed by walking the
+ * iovecs until the returned number of bytes has been processed.
+ *
+ * Holding on to the received buffers for a long time will starve the
+ * network stack of RX buffers, so they should be released as soon as
+ * possible.
+ *
+ * @param sock Socket to receive the data from
+ * @param msg Message header, msg_iov must point to at least one iovec
+ * @param handle Handle of the lent data, to be released by the caller
+ * @param flags Flags as for zsock_recvmsg(), ZSOCK_MSG_PEEK and
+ *              ZSOCK_MSG_WAITALL always copy the data
+ *
+ * @return Number of bytes received, or -1 and errno set on error
+ */
+__syscall ssize_t zsock_recvmsg_zc(int sock, struct msghdr *msg, void **handle,
+				   int flags);
+
+/**
+ * @brief Release data received with zsock_recvmsg_zc()
+ *
+ * @param handle Handle returned by zsock_recvmsg_zc(), NULL is ignored
+ */
+void zsock_recvmsg_zc_release(void *handle);
+
 /**
  * @brief Receive data from a connected peer
  *
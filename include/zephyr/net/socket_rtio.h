@@ -0,0 +1,122 @@
+/**
+ * @file
+ * @brief BSD Socket RTIO API
+ *
+ * API to submit socket operations through RTIO.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+#define ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_
+
+/**
+ * @brief BSD socket RTIO API
+ * @defgroup bsd_socket_rtio BSD socket RTIO API
+ * @since 4.3
+ * @version 0.1.0
+ * @ingroup networking
+ * @{
+ */
+
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/sys/mpsc_lockfree.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Socket RTIO iodev data, reserved for the implementation */
+struct net_socket_rtio {
+	sys_snode_t node;
+
+	/* Socket the operations are made on, -1 when detached */
+	int sock;
+
+	/* Submitted receive and send operations */
+	struct mpsc rx_q;
+	struct mpsc tx_q;
+
+	/* Operations taken from the queues, waiting for the socket */
+	struct rtio_iodev_sqe *rx_curr;
+	struct rtio_iodev_sqe *tx_curr;
+};
+
+extern const struct rtio_iodev_api net_socket_rtio_api;
+
+/** @endcond */
+
+/**
+ * @brief Statically define a socket RTIO iodev
+ *
+ * The iodev accepts the @ref RTIO_OP_RX, @ref RTIO_OP_TX and
+ * @ref RTIO_OP_TINY_TX operations once a socket has been attached to it
+ * with net_socket_rtio_attach().
+ *
+ * Receive operations complete with the number of bytes received, like
+ * zsock_recv(), and send operations with the number of bytes sent, like
+ * zsock_send().  Reads from the memory pool of the RTIO context take a
+ * buffer of up to @kconfig{CONFIG_NET_SOCKETS_RTIO_POOL_RX_SIZE} bytes.
+ * Multishot reads keep receiving until an error occurs, they are
+ * canceled, or the peer closes the connection, which completes them
+ * with a result of 0.  Operations canceled with rtio_sqe_cancel()
+ * complete with -ECANCELED within
+ * @kconfig{CONFIG_NET_SOCKETS_RTIO_CANCEL_CHECK_MS}.
+ *
+ * The operations are made by a single thread polling all the attached
+ * sockets, so that no thread is blocked on any of them.
+ *
+ * @param name Name of the iodev
+ */
+#define NET_SOCKET_RTIO_IODEV_DEFINE(name)                                                         \
+	static struct net_socket_rtio _net_socket_rtio_##name = {                                  \
+		.sock = -1,                                                                        \
+		.rx_q = MPSC_INIT((_net_socket_rtio_##name.rx_q)),                                 \
+		.tx_q = MPSC_INIT((_net_socket_rtio_##name.tx_q)),                                 \
+	};                                                                                         \
+	RTIO_IODEV_DEFINE(name, &net_socket_rtio_api, &_net_socket_rtio_##name)
+
+/**
+ * @brief Attach a socket to a socket RTIO iodev
+ *
+ * The socket must not be used directly while it is attached.
+ *
+ * @param iodev Iodev defined with NET_SOCKET_RTIO_IODEV_DEFINE()
+ * @param sock Socket descriptor
+ *
+ * @retval 0 on success
+ * @retval -EBUSY if a socket is already attached to @p iodev
+ * @retval -ENOMEM if @kconfig{CONFIG_NET_SOCKETS_RTIO_MAX} sockets are
+ *         already attached
+ */
+int net_socket_rtio_attach(struct rtio_iodev *iodev, int sock);
+
+/**
+ * @brief Detach the socket of a socket RTIO iodev
+ *
+ * The operations not completed yet complete with -ECANCELED.  The socket
+ * is not closed.  Operations submitted afterwards complete with -EBADF.
+ *
+ * @param iodev Iodev defined with NET_SOCKET_RTIO_IODEV_DEFINE()
+ *
+ * @retval 0 on success
+ * @retval -EALREADY if no socket is attached to @p iodev
+ */
+int net_socket_rtio_detach(struct rtio_iodev *iodev);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_NET_SOCKET_RTIO_H_ */
@@ -67,6 +67,7 @@ struct zperf_upload_params {
 		bool wait_for_start;
 #endif
 		uint32_t report_interval_ms;
+		uint16_t udp_batch;
 	} options;
 };
 
@@ -433,6 +433,13 @@ struct rtio {
 	struct k_sem *consume_sem;
 #endif
 
+#ifdef CONFIG_RTIO_CONSUME_BATCH
+	/* Number of completions left before the consumer waiting for a
+	 * batch of them is woken up, 0 to wake it up on each of them
+	 */
+	atomic_t cq_wake_count;
+#endif
+
 	/* Total number of completions */
 	atomic_t cq_count;
 
@@ -932,15 +939,21 @@ static inline void rtio_block_pool_free(struct rtio *r, void *buf, uint32_t buf_
 	_SYS_MEM_BLOCKS_DEFINE_WITH_EXT_BUF(name, WB_UP(blk_sz), blk_cnt,                          \
 					    CONCAT(_block_pool_, name),	RTIO_DMEM)
 
+/* When completions are batched, the consume semaphore only signals that
+ * the consumer should look at the completion queue again.
+ */
+#define Z_RTIO_CONSUME_SEM_LIMIT COND_CODE_1(CONFIG_RTIO_CONSUME_BATCH, (1), (K_SEM_MAX_LIMIT))
+
 #define Z_RTIO_DEFINE(name, _sqe_pool, _cqe_pool, _block_pool)                                     \
 	IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM,                                                         \
 		   (static K_SEM_DEFINE(CONCAT(_submit_sem_, name), 0, K_SEM_MAX_LIMIT)))          \
 	IF_ENABLED(CONFIG_RTIO_CONSUME_SEM,                                                        \
-		   (static K_SEM_DEFINE(CONCAT(_consume_sem_, name), 0, K_SEM_MAX_LIMIT)))         \
+		   (static K_SEM_DEFINE(CONCAT(_consume_sem_, name), 0, Z_RTIO_CONSUME_SEM_LIMIT)))\
 	STRUCT_SECTION_ITERABLE(rtio, name) = {                                                    \
 		IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM, (.submit_sem = &CONCAT(_submit_sem_, name),))   \
 		IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM, (.submit_count = 0,))                           \
 		IF_ENABLED(CONFIG_RTIO_CONSUME_SEM, (.consume_sem = &CONCAT(_consume_sem_, name),))\
+		IF_ENABLED(CONFIG_RTIO_CONSUME_BATCH, (.cq_wake_count = ATOMIC_INIT(0),))          \
 		.cq_count = ATOMIC_INIT(0),                                                        \
 		.xcqcnt = ATOMIC_INIT(0),                                                          \
 		.sqe_pool = _sqe_pool,                                                             \
@@ -1121,7 +1134,7 @@ static inline struct rtio_cqe *rtio_cqe_consume(struct rtio *r)
 	struct mpsc_node *node;
 	struct rtio_cqe *cqe = NULL;
 
-#ifdef CONFIG_RTIO_CONSUME_SEM
+#if defined(CONFIG_RTIO_CONSUME_SEM) && !defined(CONFIG_RTIO_CONSUME_BATCH)
 	if (k_sem_take(r->consume_sem, K_NO_WAIT) != 0) {
 		return NULL;
 	}
@@ -1151,6 +1164,13 @@ static inline struct rtio_cqe *rtio_cqe_consume_block(struct rtio *r)
 	struct mpsc_node *node;
 	struct rtio_cqe *cqe;
 
+#if defined(CONFIG_RTIO_CONSUME_BATCH)
+	node = mpsc_pop(&r->cq);
+	while (node == NULL) {
+		k_sem_take(r->consume_sem, K_FOREVER);
+		node = mpsc_pop(&r->cq);
+	}
+#else
 #ifdef CONFIG_RTIO_CONSUME_SEM
 	k_sem_take(r->consume_sem, K_FOREVER);
 #endif
@@ -1159,11 +1179,88 @@ static inline struct rtio_cqe *rtio_cqe_consume_block(struct rtio *r)
 		Z_SPIN_DELAY(1);
 		node = mpsc_pop(&r->cq);
 	}
+#endif
 	cqe = CONTAINER_OF(node, struct rtio_cqe, q);
 
 	return cqe;
 }
 
+/**
+ * @brief Wait for and consume a batch of completion queue events
+ *
+ * Consumes up to @p n completion queue events, waiting until all of them
+ * are available or @p timeout expires.  With
+ * @kconfig{CONFIG_RTIO_CONSUME_BATCH}, the calling thread is only woken up
+ * once the last of them is produced, rather than on each of them, which
+ * lowers the cost of high rate completions.
+ *
+ * rtio_cqe_release() must be called at some point on each of the
+ * completion queue events returned.
+ *
+ * @warning Must not be called from an ISR with a timeout other than
+ *          K_NO_WAIT.
+ *
+ * @param r RTIO context
+ * @param cqes Array filled with the completion queue events consumed
+ * @param n Number of completion queue events to consume
+ * @param timeout Time to wait for all of them
+ *
+ * @return Number of completion queue events consumed, from 0 to @p n
+ */
+static inline size_t rtio_cqe_consume_block_n(struct rtio *r, struct rtio_cqe **cqes, size_t n,
+					      k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct rtio_cqe *cqe;
+	size_t count = 0;
+
+	while (count < n) {
+		cqe = rtio_cqe_consume(r);
+		if (cqe != NULL) {
+			cqes[count++] = cqe;
+			continue;
+		}
+
+#if defined(CONFIG_RTIO_CONSUME_BATCH)
+		atomic_set(&r->cq_wake_count, (atomic_val_t)(n - count));
+
+		/* Completions produced before the wake count was set may not
+		 * have signaled the semaphore
+		 */
+		cqe = rtio_cqe_consume(r);
+		if (cqe != NULL) {
+			cqes[count++] = cqe;
+			continue;
+		}
+
+		if (k_sem_take(r->consume_sem, sys_timepoint_timeout(end)) != 0) {
+			break;
+		}
+#elif defined(CONFIG_RTIO_CONSUME_SEM)
+		if (k_sem_take(r->consume_sem, sys_timepoint_timeout(end)) != 0) {
+			break;
+		}
+
+		/* Hand the completion taken over to rtio_cqe_consume_block() */
+		k_sem_give(r->consume_sem);
+		cqes[count++] = rtio_cqe_consume_block(r);
+#else
+		if (sys_timepoint_expired(end)) {
+			break;
+		}
+
+		Z_SPIN_DELAY(1);
+		k_yield();
+#endif
+	}
+
+#ifdef CONFIG_RTIO_CONSUME_BATCH
+	atomic_set(&r->cq_wake_count, 0);
+#endif
+
+	return count;
+}
+
 /**
  * @brief Release consumed completion queue event
  *
@@ -1313,6 +1410,22 @@ static inline void rtio_iodev_sqe_err(struct rtio_iodev_sqe *iodev_sqe, int resu
 	rtio_executor_err(iodev_sqe, result);
 }
 
+#ifdef CONFIG_RTIO_CONSUME_BATCH
+/* Count a completion towards the batch the consumer waits for, returns
+ * true if the consumer is to be woken up
+ */
+static inline bool rtio_cq_wake_count_dec(struct rtio *r)
+{
+	atomic_val_t val;
+
+	do {
+		val = atomic_get(&r->cq_wake_count);
+	} while ((val > 1) && !atomic_cas(&r->cq_wake_count, val, val - 1));
+
+	return val <= 1;
+}
+#endif
+
 /**
  * Submit a completion queue event with a given result and userdata
  *
@@ -1335,7 +1448,11 @@ static inline void rtio_cqe_submit(struct rtio *r, int result, void *userdata, u
 		cqe->userdata = userdata;
 		cqe->flags = flags;
 		rtio_cqe_produce(r, cqe);
-#ifdef CONFIG_RTIO_CONSUME_SEM
+#if defined(CONFIG_RTIO_CONSUME_BATCH)
+		if (rtio_cq_wake_count_dec(r)) {
+			k_sem_give(r->consume_sem);
+		}
+#elif defined(CONFIG_RTIO_CONSUME_SEM)
 		k_sem_give(r->consume_sem);
 #endif
 	}
@@ -20,6 +20,10 @@
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/time_units.h>
 
+#ifdef CONFIG_SPIN_LOCK_CONTENTION_STATS
+#include <zephyr/kernel/stats.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -78,6 +82,11 @@ struct k_spinlock {
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
 
+#ifdef CONFIG_SPIN_LOCK_CONTENTION_STATS
+	/* Time spent spinning on the lock, updated with the lock held */
+	struct k_lock_stats stats;
+#endif /* CONFIG_SPIN_LOCK_CONTENTION_STATS */
+
 #if defined(CONFIG_CPP) && !defined(CONFIG_SMP) && \
 	!defined(CONFIG_SPIN_VALIDATE)
 	/* If CONFIG_SMP and CONFIG_SPIN_VALIDATE are both not defined
@@ -195,6 +204,10 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 
 	z_spinlock_validate_pre(l);
 #ifdef CONFIG_SMP
+#ifdef CONFIG_SPIN_LOCK_CONTENTION_STATS
+	uint32_t spin_start = sys_clock_cycle_get_32();
+	bool contended = false;
+#endif /* CONFIG_SPIN_LOCK_CONTENTION_STATS */
 #ifdef CONFIG_TICKET_SPINLOCKS
 	/*
 	 * Enqueue ourselves to the end of a spinlock waiters queue
@@ -203,13 +216,25 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	atomic_val_t ticket = atomic_inc(&l->tail);
 	/* Spin until our ticket is served */
 	while (atomic_get(&l->owner) != ticket) {
+#ifdef CONFIG_SPIN_LOCK_CONTENTION_STATS
+		contended = true;
+#endif /* CONFIG_SPIN_LOCK_CONTENTION_STATS */
 		arch_spin_relax();
 	}
 #else
 	while (!atomic_cas(&l->locked, 0, 1)) {
+#ifdef CONFIG_SPIN_LOCK_CONTENTION_STATS
+		contended = true;
+#endif /* CONFIG_SPIN_LOCK_CONTENTION_STATS */
 		arch_spin_relax();
 	}
 #endif /* CONFIG_TICKET_SPINLOCKS */
+#ifdef CONFIG_SPIN_LOCK_CONTENTION_STATS
+	l->stats.acquired++;
+	if (contended) {
+		z_lock_stats_wait(&l->stats, sys_clock_cycle_get_32() - spin_start, NULL);
+	}
+#endif /* CONFIG_SPIN_LOCK_CONTENTION_STATS */
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
 
@@ -265,6 +290,9 @@ static ALWAYS_INLINE int k_spin_trylock(struct k_spinlock *l, k_spinlock_key_t *
 		goto busy;
 	}
 #endif /* CONFIG_TICKET_SPINLOCKS */
+#ifdef CONFIG_SPIN_LOCK_CONTENTION_STATS
+	l->stats.acquired++;
+#endif /* CONFIG_SPIN_LOCK_CONTENTION_STATS */
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
 
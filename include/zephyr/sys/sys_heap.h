@@ -94,6 +94,136 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
  */
 int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
 
+#if defined(CONFIG_SYS_HEAP_PROFILE) || defined(__DOXYGEN__)
+
+struct k_thread;
+
+/**
+ * @brief sys_heap allocation profile
+ *
+ * Bin @a i of the cycle histograms counts the operations that took
+ * between 2^i and 2^(i+1) - 1 cycles, the last bin also counts all
+ * the slower operations.
+ */
+struct sys_heap_profile {
+	/** Histogram of the cycles taken by allocations */
+	uint32_t alloc_cycles[CONFIG_SYS_HEAP_PROFILE_BINS];
+	/** Histogram of the cycles taken by frees */
+	uint32_t free_cycles[CONFIG_SYS_HEAP_PROFILE_BINS];
+	/** Number of allocations that failed */
+	uint32_t alloc_failures;
+	/** Size of the largest block that can currently be allocated */
+	size_t largest_free_bytes;
+	/**
+	 * Lowest size of the largest block that could be allocated
+	 * after any allocation, rounded down to a power of two number
+	 * of chunks
+	 */
+	size_t min_largest_free_bytes;
+};
+
+/**
+ * @brief Get the allocation profile of a sys_heap
+ *
+ * Together with sys_heap_runtime_stats_get(), the largest free block
+ * shows how fragmented the free memory is.  Like the other sys_heap
+ * calls, this must be serialized with the operations on the heap.
+ *
+ * @param heap Pointer to specified sys_heap
+ * @param profile Pointer to struct to copy the profile into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int sys_heap_profile_get(struct sys_heap *heap, struct sys_heap_profile *profile);
+
+/**
+ * @brief Reset the allocation profile of a sys_heap
+ *
+ * Clears the histograms and the failure count, and sets the lowest
+ * largest free block to the current one.
+ *
+ * @param heap Pointer to sys_heap
+ * @return -EINVAL if null pointer was passed, otherwise 0
+ */
+int sys_heap_profile_reset(struct sys_heap *heap);
+
+#if defined(CONFIG_SYS_HEAP_PROFILE_STATS) || defined(__DOXYGEN__)
+
+/**
+ * @brief Register the allocation profile of a sys_heap as statistics
+ *
+ * Registers a group of the statistics subsystem holding the number of
+ * allocations, frees and failed allocations, the slowest allocation and
+ * free in cycles and the lowest size of the largest free block of
+ * @a heap, counted from the registration or the last reset of the
+ * profile.  Groups cannot be unregistered, so a heap is registered at
+ * most once and its memory is not reused afterwards.
+ *
+ * @param heap Pointer to sys_heap
+ * @param name Name of the statistics group, must be unique
+ * @return -EINVAL if null pointers, -EALREADY if the name is already
+ *         registered, otherwise 0
+ */
+int sys_heap_profile_stats_register(struct sys_heap *heap, const char *name);
+
+#endif /* CONFIG_SYS_HEAP_PROFILE_STATS */
+
+#if defined(CONFIG_SYS_HEAP_PROFILE_SITES) || defined(__DOXYGEN__)
+
+/**
+ * @brief sys_heap usage of an allocation site
+ *
+ * Allocation sites are the threads that allocate and free memory.
+ */
+struct sys_heap_profile_site {
+	/** Thread, or NULL for interrupts and the threads not tracked */
+	const struct k_thread *thread;
+	/** Number of blocks allocated */
+	uint32_t alloc_count;
+	/** Number of blocks freed */
+	uint32_t free_count;
+	/** Total size of the blocks allocated */
+	size_t alloc_bytes;
+	/** Total size of the blocks freed */
+	size_t free_bytes;
+};
+
+/**
+ * @brief Start tracking the allocation sites of a sys_heap
+ *
+ * Registers heap listeners on @a heap that account every allocation
+ * and free to the calling thread.  Up to
+ * CONFIG_SYS_HEAP_PROFILE_SITES_NUM threads are tracked, the usage of the
+ * other ones is accounted to a site without a thread.  The site of a
+ * thread is released when it exits and its usage is moved to the site
+ * without a thread.  The sites of a single heap can be tracked at a
+ * time, starting clears them.
+ *
+ * @param heap Pointer to sys_heap
+ * @return -EINVAL if null pointer was passed, -EBUSY if the sites of
+ *         a heap are already tracked, otherwise 0
+ */
+int sys_heap_profile_sites_start(struct sys_heap *heap);
+
+/**
+ * @brief Stop tracking the allocation sites
+ *
+ * The sites tracked so far can still be read.
+ */
+void sys_heap_profile_sites_stop(void);
+
+/**
+ * @brief Get the allocation sites tracked
+ *
+ * @param sites Array to copy the sites into
+ * @param max Number of entries of @a sites
+ * @return Number of sites copied
+ */
+size_t sys_heap_profile_sites_get(struct sys_heap_profile_site *sites, size_t max);
+
+#endif /* CONFIG_SYS_HEAP_PROFILE_SITES */
+
+#endif /* CONFIG_SYS_HEAP_PROFILE */
+
 /** @brief Initialize sys_heap
  *
  * Initializes a sys_heap struct to manage the specified memory.
@@ -0,0 +1,151 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_SYS_WSQ_H_
+#define ZEPHYR_INCLUDE_SYS_WSQ_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+/* Zephyr Work-Stealing Queues */
+
+struct k_wsq;
+
+/**
+ * Work-stealing queue parallel-for callback.
+ *
+ * Invoked for a range of indexes [@p start, @p end) of a
+ * k_wsq_parallel_for() call, possibly on several CPUs at the same time.
+ */
+typedef void (*k_wsq_for_fn_t)(size_t start, size_t end, void *user_data);
+
+/**
+ * @brief Work-Stealing Queue Worker
+ *
+ * One worker thread of a work-stealing queue, with its local queue of
+ * work items.  Reserved for the implementation.
+ */
+struct k_wsq_worker {
+	struct k_spinlock lock;
+
+	/* Work items local to this worker */
+	sys_slist_t pending;
+
+	struct k_thread thread;
+	struct k_wsq *wsq;
+};
+
+/**
+ * @brief Work-Stealing Queue
+ *
+ * Pool of worker threads, one per CPU, executing standard k_work
+ * items.  Each worker runs the items of its local queue, and steals
+ * items from the local queues of the other workers when its own is
+ * empty.
+ */
+struct k_wsq {
+	struct k_spinlock lock;
+
+	/* Workers with nothing to run or to steal */
+	_wait_q_t idleq;
+
+	struct k_wsq_worker *workers;
+	struct z_thread_stack_element *stacks;
+	size_t stack_size;
+	uint32_t num_workers;
+
+	/* Number of work items in the local queues */
+	atomic_t pending;
+
+	/* Number of workers in idleq */
+	atomic_t idle;
+
+	/* Round robin index for items not submitted by a worker */
+	atomic_t next;
+};
+
+/**
+ * @brief Statically define a Work-Stealing Queue
+ *
+ * Defines a struct k_wsq object with storage for one worker thread per
+ * possible CPU.  The queue must be started with k_wsq_start() before
+ * use.
+ *
+ * @param name Symbol name of the struct k_wsq that will be defined
+ * @param stack_sz Requested stack size of each worker thread, in bytes
+ */
+#define K_WSQ_DEFINE(name, stack_sz)					\
+	static K_THREAD_STACK_ARRAY_DEFINE(_wsqstacks_##name,		\
+					   CONFIG_MP_MAX_NUM_CPUS,	\
+					   stack_sz);			\
+	static struct k_wsq_worker					\
+		_wsqworkers_##name[CONFIG_MP_MAX_NUM_CPUS];		\
+	struct k_wsq name = {						\
+		.workers = _wsqworkers_##name,				\
+		.stacks = &(_wsqstacks_##name[0][0]),			\
+		.stack_size = stack_sz,					\
+	}
+
+/**
+ * @brief Start a Work-Stealing Queue
+ *
+ * Creates and starts one worker thread per CPU.  With
+ * CONFIG_SCHED_CPU_MASK each worker is pinned to its CPU.
+ *
+ * @param wsq Work-stealing queue defined with K_WSQ_DEFINE()
+ * @param prio Priority of the worker threads
+ */
+void k_wsq_start(struct k_wsq *wsq, int prio);
+
+/**
+ * @brief Submit a work item to a Work-Stealing Queue
+ *
+ * The work item is added to the local queue of the submitting worker
+ * when called from a work handler running on @p wsq, otherwise to the
+ * local queues of the workers in turn.  It may be executed by any of
+ * the workers.
+ *
+ * The semantics follow k_work_submit_to_queue(): a work item that is
+ * already queued is left alone, and a work item that is running is
+ * queued again once its handler returns, so the handler of an item is
+ * never invoked on two CPUs at the same time.
+ *
+ * k_work_busy_get() and k_work_is_pending() can be used on the work
+ * item.  The other k_work API functions (cancelling, flushing,
+ * submitting to a k_work_q) must not be used on it while it is
+ * submitted to a work-stealing queue.
+ *
+ * @param wsq Work-stealing queue
+ * @param work Work item initialized with k_work_init()
+ *
+ * @retval 0 if the work was already queued
+ * @retval 1 if the work was not queued and has been queued
+ * @retval 2 if the work was running and has been queued again
+ * @retval -ENODEV if @p wsq has not been started
+ */
+int k_wsq_submit(struct k_wsq *wsq, struct k_work *work);
+
+/**
+ * @brief Run a loop on all the CPUs of a Work-Stealing Queue
+ *
+ * Splits the indexes [0, @p count) into ranges of @p grain indexes and
+ * invokes @p fn on every range exactly once, in no particular order and
+ * possibly concurrently on all the workers of @p wsq.  The calling
+ * thread takes part in the loop, and returns once all the ranges have
+ * been processed.
+ *
+ * May be called from a work handler running on @p wsq.
+ *
+ * @param wsq Work-stealing queue
+ * @param count Number of indexes
+ * @param grain Number of indexes handed to @p fn at once, 0 to select
+ *        it from @p count and the number of workers
+ * @param fn Function invoked on each range
+ * @param user_data User data passed to @p fn
+ */
+void k_wsq_parallel_for(struct k_wsq *wsq, size_t count, size_t grain,
+			k_wsq_for_fn_t fn, void *user_data);
+
+#endif /* ZEPHYR_INCLUDE_SYS_WSQ_H_ */
@@ -11,6 +11,12 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/iterable_sections.h>
 
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+#include <zephyr/net_buf.h>
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
+struct net_buf;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -45,6 +51,18 @@ struct zbus_channel_data {
 	 */
 	struct k_sem sem;
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK) || defined(__DOXYGEN__)
+	/** Message sequence counter. Odd while the message is being changed, so that readers
+	 * copying the message without taking the semaphore can detect torn reads.
+	 */
+	atomic_t seq;
+
+	/** Set while the channel is claimed, readers then wait for the semaphore instead of
+	 * retrying the copy.
+	 */
+	bool claimed;
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 #if defined(CONFIG_ZBUS_PRIORITY_BOOST)
 	/** Highest observer priority. Indicates the priority that the VDED will use to boost the
 	 * notification process avoiding preemptions.
@@ -65,6 +83,13 @@ struct zbus_channel_data {
 	struct net_buf_pool *msg_subscriber_pool;
 #endif /* ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_ISOLATION */
 
+#if defined(CONFIG_ZBUS_MSG_LOAN) || defined(__DOXYGEN__)
+	/** Loaned buffer of the last zbus_chan_commit(). It holds the channel's message, instead
+	 * of the message field, until the channel is published or claimed again.
+	 */
+	struct net_buf *loan;
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
 #if defined(CONFIG_ZBUS_CHANNEL_PUBLISH_STATS) || defined(__DOXYGEN__)
 	/** Kernel timestamp of the last publish action on this channel */
 	k_ticks_t publish_timestamp;
@@ -583,6 +608,11 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
  *
  * This routine reads a message from a channel.
  *
+ * With @kconfig{CONFIG_ZBUS_CHANNEL_SEQLOCK}, the message is copied without taking the channel,
+ * and copied again if it was changed meanwhile. The routine only blocks while the channel is
+ * claimed, and retries while a message is being copied to the channel by a publisher, which is
+ * never delayed by readers.
+ *
  * @param[in] chan The channel's reference.
  * @param[out] msg Reference to the message where the read function copies the channel's
  * message data to.
@@ -656,6 +686,59 @@ int zbus_chan_finish(const struct zbus_channel *chan);
  */
 int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout);
 
+#if defined(CONFIG_ZBUS_MSG_LOAN) || defined(__DOXYGEN__)
+
+/**
+ * @brief Loan a message buffer to publish to a channel.
+ *
+ * This routine allocates a buffer from the channel's msg subscriber pool, for the publisher to
+ * write the message to directly, at the buffer's data. The buffer must then be published with
+ * zbus_chan_commit(), or released with net_buf_unref().
+ *
+ * @param[in] chan The channel's reference.
+ * @param[out] buf The loaned buffer, with a length of the channel's message size.
+ * @param[in] timeout Waiting period to allocate the buffer,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Buffer loaned.
+ * @retval -ENOMEM The pool has no buffer available.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_chan_loan(const struct zbus_channel *chan, struct net_buf **buf, k_timeout_t timeout);
+
+/**
+ * @brief Publish a loaned message buffer to a channel.
+ *
+ * This routine publishes the message written to a buffer from zbus_chan_loan() without copying
+ * it. The buffer becomes the channel's message, and msg subscribers receive references to it,
+ * that they can get with zbus_sub_wait_msg_buf(). The buffer is released by the channel once
+ * published or claimed again.
+ *
+ * The reference to the buffer is always taken over, even if the routine fails, and the buffer
+ * must no longer be written to.
+ *
+ * @warning Listeners must not change the message of a channel published with this routine,
+ * since msg subscribers share it.
+ *
+ * @param chan The channel's reference.
+ * @param buf The buffer loaned for @p chan.
+ * @param timeout Waiting period to publish the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Channel published.
+ * @retval -ENOMSG The message is invalid based on the validator function or some of the
+ * observers could not receive the notification.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect, the notification could not be sent to one or more
+ * observer, or the function context is invalid (inside an ISR). The function only returns this
+ * value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_chan_commit(const struct zbus_channel *chan, struct net_buf *buf, k_timeout_t timeout);
+
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
 #if defined(CONFIG_ZBUS_CHANNEL_NAME) || defined(__DOXYGEN__)
 
 /**
@@ -706,6 +789,12 @@ static inline void *zbus_chan_msg(const struct zbus_channel *chan)
 {
 	__ASSERT(chan != NULL, "chan is required");
 
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+	if (chan->data->loan != NULL) {
+		return chan->data->loan->data;
+	}
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
 	return chan->message;
 }
 
@@ -727,7 +816,7 @@ static inline const void *zbus_chan_const_msg(const struct zbus_channel *chan)
 {
 	__ASSERT(chan != NULL, "chan is required");
 
-	return chan->message;
+	return zbus_chan_msg(chan);
 }
 
 /**
@@ -1126,6 +1215,27 @@ int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **c
 int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
 		      k_timeout_t timeout);
 
+/**
+ * @brief Wait for a channel message buffer.
+ *
+ * This routine makes the subscriber wait for the new message in case of channel publication,
+ * like zbus_sub_wait_msg(), but hands over the buffer holding the message instead of copying it.
+ * The message is at the buffer's data, and must not be changed.
+ *
+ * @param[in] sub The subscriber's reference.
+ * @param[out] chan The notification channel's reference.
+ * @param[out] buf The buffer holding the message, to be released with net_buf_unref().
+ * @param[in] timeout Waiting period for a notification arrival,
+ *                or one of the special values, K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Could not retrieve the net_buf from the subscriber FIFO.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_sub_wait_msg_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+			  struct net_buf **buf, k_timeout_t timeout);
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 /**
@@ -0,0 +1,132 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZBUS_PROXY_AGENT_H_
+#define ZEPHYR_INCLUDE_ZBUS_PROXY_AGENT_H_
+
+#include <zephyr/init.h>
+#include <zephyr/ipc/ipc_service.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Zbus proxy agent API
+ * @defgroup zbus_proxy_agent_apis Zbus proxy agent APIs
+ * @since 4.3
+ * @version 0.1.0
+ * @ingroup zbus_apis
+ * @{
+ */
+
+/**
+ * @brief Type used to represent a proxy agent.
+ *
+ * Every field is reserved for the implementation, use ZBUS_PROXY_AGENT_DEFINE() to define
+ * proxy agents.
+ */
+struct zbus_proxy_agent {
+	/** @cond INTERNAL_HIDDEN */
+	const struct device *ipc_instance;
+	const struct zbus_channel *const *channels;
+	size_t num_channels;
+
+	/* Channels published locally and not forwarded yet */
+	atomic_t *pending;
+
+	struct ipc_ept ept;
+	struct ipc_ept_cfg ept_cfg;
+	struct k_work_delayable tx_work;
+	atomic_t bound;
+
+	/* Context and channel of the message received from the remote being published, which is
+	 * not forwarded back
+	 */
+	const void *rx_ctx;
+	const struct zbus_channel *rx_chan;
+
+	uint8_t tx_buf[CONFIG_ZBUS_PROXY_AGENT_TX_BUF_SIZE] __aligned(4);
+	/** @endcond */
+};
+
+/** @cond INTERNAL_HIDDEN */
+
+void zbus_proxy_agent_forward(struct zbus_proxy_agent *agent, const struct zbus_channel *chan);
+
+int zbus_proxy_agent_init(struct zbus_proxy_agent *agent, const char *ept_name);
+
+#define _ZBUS_PROXY_AGENT_ADD_OBS(_chan, _name)                                                   \
+	ZBUS_CHAN_ADD_OBS(_chan, _CONCAT(_name, _lis), CONFIG_ZBUS_PROXY_AGENT_OBS_PRIO)
+
+/** @endcond */
+
+/**
+ * @brief Define a proxy agent forwarding channels to another core.
+ *
+ * The proxy agent registers an endpoint named @p _ept_name on the IPC service instance
+ * @p _ipc_instance, and forwards the messages published to the channels to the proxy agent
+ * bound to it on the remote side, which publishes them to its own channels. The observers of the
+ * channels on both sides are thus notified as if the channels were shared.
+ *
+ * Both proxy agents must list the same number of channels, in the same order, and the channels at
+ * the same position must have the same message size. Publications are batched for
+ * @kconfig{CONFIG_ZBUS_PROXY_AGENT_BATCH_DELAY_MS} milliseconds, and only the last message of a
+ * channel published several times in that time is forwarded. Messages received from the remote
+ * are not forwarded back to it.
+ *
+ * @param _name Name of the proxy agent.
+ * @param _ipc_instance IPC service instance device.
+ * @param _ept_name Name of the IPC endpoint, identical on both sides.
+ * @param ... Channels forwarded.
+ */
+#define ZBUS_PROXY_AGENT_DEFINE(_name, _ipc_instance, _ept_name, ...)                              \
+	static const struct zbus_channel *const _CONCAT(_zbus_proxy_agent_chans_, _name)[] = {     \
+		FOR_EACH(ZBUS_REF, (,), __VA_ARGS__)};                                             \
+	static ATOMIC_DEFINE(_CONCAT(_zbus_proxy_agent_pending_, _name), NUM_VA_ARGS(__VA_ARGS__));\
+	struct zbus_proxy_agent _name = {                                                          \
+		.ipc_instance = (_ipc_instance),                                                   \
+		.channels = _CONCAT(_zbus_proxy_agent_chans_, _name),                              \
+		.num_channels = NUM_VA_ARGS(__VA_ARGS__),                                          \
+		.pending = _CONCAT(_zbus_proxy_agent_pending_, _name),                             \
+	};                                                                                         \
+	static void _CONCAT(_zbus_proxy_agent_cb_, _name)(const struct zbus_channel *chan)         \
+	{                                                                                          \
+		zbus_proxy_agent_forward(&_name, chan);                                            \
+	}                                                                                          \
+	ZBUS_LISTENER_DEFINE(_CONCAT(_name, _lis), _CONCAT(_zbus_proxy_agent_cb_, _name));         \
+	FOR_EACH_FIXED_ARG(_ZBUS_PROXY_AGENT_ADD_OBS, (;), _name, __VA_ARGS__);                    \
+	static int _CONCAT(_zbus_proxy_agent_init_, _name)(void)                                   \
+	{                                                                                          \
+		return zbus_proxy_agent_init(&_name, (_ept_name));                                 \
+	}                                                                                          \
+	SYS_INIT_NAMED(_name, _CONCAT(_zbus_proxy_agent_init_, _name), APPLICATION,                \
+		       CONFIG_ZBUS_PROXY_AGENT_INIT_PRIORITY)
+
+/**
+ * @brief Check whether a proxy agent is bound to the remote one.
+ *
+ * @param agent Proxy agent defined with ZBUS_PROXY_AGENT_DEFINE().
+ *
+ * @return true when messages are forwarded to the remote, false otherwise.
+ */
+static inline bool zbus_proxy_agent_is_bound(const struct zbus_proxy_agent *agent)
+{
+	return atomic_get(&agent->bound) != 0;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZBUS_PROXY_AGENT_H_ */
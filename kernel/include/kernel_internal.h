@@ -172,6 +172,16 @@ void z_thread_mark_switched_out(void);
 
 #endif /* CONFIG_INSTRUMENT_THREAD_SWITCHING */
 
+/* Get the lock protecting the state of a work item, shared with the users
+ * of work items outside of the kernel work queues.
+ */
+struct k_spinlock *z_work_lock_get(const struct k_work *work);
+
+#ifdef CONFIG_SYS_HEAP_PROFILE_SITES
+/* Release the heap allocation site of an exiting thread */
+void z_heap_profile_thread_exit(struct k_thread *thread);
+#endif /* CONFIG_SYS_HEAP_PROFILE_SITES */
+
 /* Init hook for page frame management, invoked immediately upon entry of
  * main thread, before POST_KERNEL tasks
  */
@@ -326,6 +326,23 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY_STATS
+/**
+ * @brief Record the time a thread is made ready
+ *
+ * Called with the scheduler lock held.
+ */
+void z_sched_latency_ready(struct k_thread *thread);
+
+/**
+ * @brief Record the wakeup latency of a thread being switched in
+ *
+ * Called on context switch, with the scheduler lock held on SMP and
+ * local interrupts masked.
+ */
+void z_sched_latency_switched_in(struct k_thread *thread);
+#endif /* CONFIG_SCHED_WAKEUP_LATENCY_STATS */
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
@@ -333,6 +350,9 @@ static inline void z_sched_usage_switch(struct k_thread *thread)
 	z_sched_usage_stop();
 	z_sched_usage_start(thread);
 #endif /* CONFIG_SCHED_THREAD_USAGE */
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY_STATS
+	z_sched_latency_switched_in(thread);
+#endif /* CONFIG_SCHED_WAKEUP_LATENCY_STATS */
 }
 
 #endif /* ZEPHYR_KERNEL_INCLUDE_KSCHED_H_ */
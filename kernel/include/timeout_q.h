@@ -28,6 +28,9 @@ extern "C" {
 static inline void z_init_timeout(struct _timeout *to)
 {
 	sys_dnode_init(&to->node);
+#ifdef CONFIG_TIMEOUT_PER_CPU_QUEUES
+	to->cpu = 0;
+#endif /* CONFIG_TIMEOUT_PER_CPU_QUEUES */
 }
 
 /* Adds the timeout to the queue.
@@ -0,0 +1,32 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/stats.h>
+#include <zephyr/sys/util.h>
+
+void z_lock_stats_wait(struct k_lock_stats *stats, uint32_t cycles,
+		       struct k_thread *holder)
+{
+	stats->contended++;
+	stats->wait_total += cycles;
+	z_cycle_hist_record(stats->wait_bins, CONFIG_LOCK_CONTENTION_STATS_BINS, cycles);
+
+	if (cycles >= stats->wait_max) {
+		stats->wait_max = cycles;
+		stats->max_holder = (uintptr_t)holder;
+#ifdef CONFIG_THREAD_NAME
+		if (holder != NULL) {
+			strncpy(stats->max_holder_name, holder->name,
+				sizeof(stats->max_holder_name) - 1);
+			stats->max_holder_name[sizeof(stats->max_holder_name) - 1] = '\0';
+		} else {
+			stats->max_holder_name[0] = '\0';
+		}
+#endif
+	}
+}
@@ -11,6 +11,11 @@
 
 typedef void * (sys_heap_allocator_t)(struct sys_heap *heap, size_t align, size_t bytes);
 
+#if defined(CONFIG_HEAP_MEM_POOL_SLAB) && (K_HEAP_MEM_POOL_SIZE > 0)
+#define HEAP_SLAB 1
+static bool slab_free(void *mem);
+#endif
+
 static void *z_alloc_helper(struct k_heap *heap, size_t align, size_t size,
 			    sys_heap_allocator_t sys_heap_allocator)
 {
@@ -64,6 +69,12 @@ void k_free(void *ptr)
 		--heap_ref;
 		ptr = heap_ref;
 
+#ifdef HEAP_SLAB
+		if (slab_free(ptr)) {
+			return;
+		}
+#endif
+
 		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_free, *heap_ref, heap_ref);
 
 		k_heap_free(*heap_ref, ptr);
@@ -77,11 +88,215 @@ void k_free(void *ptr)
 K_HEAP_DEFINE(_system_heap, K_HEAP_MEM_POOL_SIZE);
 #define _SYSTEM_HEAP (&_system_heap)
 
+#ifdef HEAP_SLAB
+
+/*
+ * Small k_malloc() requests are rounded up to a power of two size class
+ * and served from per-CPU caches of free blocks of that class, so that
+ * most of them don't need to go through the heap and its lock. The
+ * caches are refilled from, and flushed to, the heap half a cache at a
+ * time.
+ *
+ * Cached blocks are regular heap allocations. In place of the heap
+ * reference, blocks handed out from a cache are tagged with the address
+ * of an entry of slab_tags[], which identifies their size class.
+ */
+#define SLAB_MIN_SHIFT   4
+#define SLAB_NUM_CLASSES (LOG2CEIL(CONFIG_HEAP_MEM_POOL_SLAB_MAX_SIZE) - SLAB_MIN_SHIFT + 1)
+#define SLAB_BATCH       MAX(CONFIG_HEAP_MEM_POOL_SLAB_CACHE_SIZE / 2, 1)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_HEAP_MEM_POOL_SLAB_MAX_SIZE),
+	     "slab maximum size must be a power of two");
+
+struct slab_magazine {
+	uint32_t count;
+	void *blocks[CONFIG_HEAP_MEM_POOL_SLAB_CACHE_SIZE];
+};
+
+struct slab_cache {
+	struct k_spinlock lock;
+	struct slab_magazine mags[SLAB_NUM_CLASSES];
+};
+
+static uint8_t slab_tags[SLAB_NUM_CLASSES];
+static struct slab_cache slab_caches[CONFIG_MP_MAX_NUM_CPUS];
+
+static inline size_t slab_class_size(unsigned int cls)
+{
+	return (size_t)1 << (cls + SLAB_MIN_SHIFT);
+}
+
+/* Returns the size class of a block, or -1 if it's not a slab block */
+static inline int slab_class_get(void *mem)
+{
+	uintptr_t tag = (uintptr_t)*(void **)mem;
+
+	if ((tag - (uintptr_t)slab_tags) < SLAB_NUM_CLASSES) {
+		return (int)(tag - (uintptr_t)slab_tags);
+	}
+
+	return -1;
+}
+
+static inline struct slab_cache *slab_cache_get(void)
+{
+	/* The thread may migrate right after this, the cache is locked
+	 * anyway.
+	 */
+	return &slab_caches[arch_curr_cpu()->id];
+}
+
+/* Invoked with the cache lock held */
+static void slab_refill_locked(struct slab_magazine *mag, unsigned int cls)
+{
+	size_t bytes = slab_class_size(cls) + sizeof(void *);
+	k_spinlock_key_t key = k_spin_lock(&_system_heap.lock);
+
+	while (mag->count < SLAB_BATCH) {
+		void *mem = sys_heap_alloc(&_system_heap.heap, bytes);
+
+		if (mem == NULL) {
+			break;
+		}
+		mag->blocks[mag->count++] = mem;
+	}
+
+	k_spin_unlock(&_system_heap.lock, key);
+}
+
+/* Invoked with the cache lock held */
+static void slab_flush_locked(struct slab_magazine *mag, uint32_t keep)
+{
+	k_spinlock_key_t key = k_spin_lock(&_system_heap.lock);
+
+	while (mag->count > keep) {
+		sys_heap_free(&_system_heap.heap, mag->blocks[--mag->count]);
+	}
+
+	k_spin_unlock(&_system_heap.lock, key);
+}
+
+static void *slab_alloc(size_t size)
+{
+	size_t bytes = MAX(size, slab_class_size(0));
+	unsigned int cls = LOG2CEIL(bytes) - SLAB_MIN_SHIFT;
+	struct slab_cache *cache = slab_cache_get();
+	struct slab_magazine *mag = &cache->mags[cls];
+	void **mem = NULL;
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	if (mag->count == 0U) {
+		slab_refill_locked(mag, cls);
+	}
+	if (mag->count > 0U) {
+		mem = mag->blocks[--mag->count];
+	}
+
+	k_spin_unlock(&cache->lock, key);
+
+	if (mem == NULL) {
+		return NULL;
+	}
+
+	*mem = (void *)&slab_tags[cls];
+
+	return ++mem;
+}
+
+static bool slab_free(void *mem)
+{
+	int cls = slab_class_get(mem);
+
+	if (cls < 0) {
+		return false;
+	}
+
+	struct slab_cache *cache = slab_cache_get();
+	struct slab_magazine *mag = &cache->mags[cls];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+	if (mag->count == CONFIG_HEAP_MEM_POOL_SLAB_CACHE_SIZE) {
+		slab_flush_locked(mag, CONFIG_HEAP_MEM_POOL_SLAB_CACHE_SIZE - SLAB_BATCH);
+	}
+	mag->blocks[mag->count++] = mem;
+
+	k_spin_unlock(&cache->lock, key);
+
+	return true;
+}
+
+/* Returns the blocks cached by all the CPUs to the heap, so that the
+ * memory can be used for other sizes.
+ *
+ * @return true if any block was returned
+ */
+static bool slab_drain(void)
+{
+	bool ret = false;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct slab_cache *cache = &slab_caches[i];
+
+		K_SPINLOCK(&cache->lock) {
+			for (unsigned int cls = 0; cls < SLAB_NUM_CLASSES; cls++) {
+				if (cache->mags[cls].count > 0U) {
+					slab_flush_locked(&cache->mags[cls], 0);
+					ret = true;
+				}
+			}
+		}
+	}
+
+	return ret;
+}
+
+static void *slab_realloc(void *ptr, int cls, size_t size)
+{
+	void *ret;
+
+	if (size <= slab_class_size(cls)) {
+		return ptr;
+	}
+
+	ret = k_malloc(size);
+	if (ret != NULL) {
+		(void)memcpy(ret, ptr, slab_class_size(cls));
+		k_free(ptr);
+	}
+
+	return ret;
+}
+
+#endif /* HEAP_SLAB */
+
+static void *system_heap_alloc(size_t align, size_t size,
+			       sys_heap_allocator_t sys_heap_allocator)
+{
+#ifdef HEAP_SLAB
+	void *mem;
+
+	if ((align == 0U) && (size <= CONFIG_HEAP_MEM_POOL_SLAB_MAX_SIZE)) {
+		mem = slab_alloc(size);
+	} else {
+		mem = z_alloc_helper(_SYSTEM_HEAP, align, size, sys_heap_allocator);
+	}
+
+	/* The memory missing may be sitting in the caches */
+	if ((mem == NULL) && slab_drain()) {
+		mem = z_alloc_helper(_SYSTEM_HEAP, align, size, sys_heap_allocator);
+	}
+
+	return mem;
+#else
+	return z_alloc_helper(_SYSTEM_HEAP, align, size, sys_heap_allocator);
+#endif /* HEAP_SLAB */
+}
+
 void *k_aligned_alloc(size_t align, size_t size)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP);
 
-	void *ret = z_alloc_helper(_SYSTEM_HEAP, align, size, sys_heap_aligned_alloc);
+	void *ret = system_heap_alloc(align, size, sys_heap_aligned_alloc);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP, ret);
 
@@ -92,7 +307,7 @@ void *k_malloc(size_t size)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_malloc, _SYSTEM_HEAP);
 
-	void *ret = z_alloc_helper(_SYSTEM_HEAP, 0, size, sys_heap_noalign_alloc);
+	void *ret = system_heap_alloc(0, size, sys_heap_noalign_alloc);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_malloc, _SYSTEM_HEAP, ret);
 
@@ -136,6 +351,15 @@ void *k_realloc(void *ptr, size_t size)
 		return k_malloc(size);
 	}
 	heap_ref = ptr;
+
+#ifdef HEAP_SLAB
+	int cls = slab_class_get(heap_ref - 1);
+
+	if (cls >= 0) {
+		return slab_realloc(ptr, cls, size);
+	}
+#endif
+
 	ptr = --heap_ref;
 	heap = *heap_ref;
 
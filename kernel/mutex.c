@@ -39,6 +39,7 @@
 #include <zephyr/sys/check.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/llext/symbol.h>
+#include <string.h>
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 
 /* We use a global spinlock here because some of the synchronization
@@ -50,6 +51,62 @@ static struct k_spinlock lock;
 
 #ifdef CONFIG_OBJ_CORE_MUTEX
 static struct k_obj_type obj_type_mutex;
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+static int k_mutex_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_mutex *mutex;
+	k_spinlock_key_t key;
+
+	mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+	key = k_spin_lock(&lock);
+	memcpy(stats, &mutex->lock_stats, sizeof(mutex->lock_stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static int k_mutex_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_mutex *mutex;
+	k_spinlock_key_t key;
+
+	mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+	key = k_spin_lock(&lock);
+	memset(&mutex->lock_stats, 0, sizeof(mutex->lock_stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc mutex_stats_desc = {
+	.raw_size = sizeof(struct k_lock_stats),
+	.query_size = sizeof(struct k_lock_stats),
+	.raw   = k_mutex_stats_raw,
+	.query = k_mutex_stats_raw,
+	.reset = k_mutex_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+
+static void mutex_stats_wait(struct k_mutex *mutex, int got_mutex,
+			     struct k_thread *holder, uint32_t wait_start)
+{
+	uint32_t cycles = k_cycle_get_32() - wait_start;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (got_mutex == 0) {
+		mutex->lock_stats.acquired++;
+	}
+	z_lock_stats_wait(&mutex->lock_stats, cycles, holder);
+
+	k_spin_unlock(&lock, key);
+}
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 #endif /* CONFIG_OBJ_CORE_MUTEX */
 
 int z_impl_k_mutex_init(struct k_mutex *mutex)
@@ -64,6 +121,11 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
 #endif /* CONFIG_OBJ_CORE_MUTEX */
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	memset(&mutex->lock_stats, 0, sizeof(mutex->lock_stats));
+	k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->lock_stats,
+				  sizeof(struct k_lock_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 
 	SYS_PORT_TRACING_OBJ_INIT(k_mutex, mutex, 0);
 
@@ -122,6 +184,9 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 		mutex->lock_count++;
 		mutex->owner = _current;
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+		mutex->lock_stats.acquired++;
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 
 		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
 			_current, mutex, mutex->lock_count,
@@ -153,8 +218,17 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	struct k_thread *holder = mutex->owner;
+	uint32_t wait_start = k_cycle_get_32();
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	mutex_stats_wait(mutex, got_mutex, holder, wait_start);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
 
 	LOG_DBG("%p got mutex %p (y/n): %c", _current, mutex,
@@ -299,11 +373,18 @@ static int init_mutex_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_mutex, K_OBJ_TYPE_MUTEX_ID,
 			offsetof(struct k_mutex, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_obj_type_stats_init(&obj_type_mutex, &mutex_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 
 	/* Initialize and link statically defined mutexes */
 
 	STRUCT_SECTION_FOREACH(k_mutex, mutex) {
 		k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+		k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->lock_stats,
+					  sizeof(struct k_lock_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 	}
 
 	return 0;
@@ -347,6 +347,9 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY_STATS
+		z_sched_latency_ready(thread);
+#endif /* CONFIG_SCHED_WAKEUP_LATENCY_STATS */
 		queue_thread(thread);
 		update_cache(0);
 
@@ -1290,6 +1293,10 @@ static ALWAYS_INLINE void halt_thread(struct k_thread *thread, uint8_t new_state
 		thread_abort_hook(thread);
 #endif /* CONFIG_THREAD_ABORT_HOOK */
 
+#ifdef CONFIG_SYS_HEAP_PROFILE_SITES
+		z_heap_profile_thread_exit(thread);
+#endif /* CONFIG_SYS_HEAP_PROFILE_SITES */
+
 #ifdef CONFIG_OBJ_CORE_THREAD
 #ifdef CONFIG_OBJ_CORE_STATS_THREAD
 		k_obj_core_stats_deregister(K_OBJ_CORE(thread));
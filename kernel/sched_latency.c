@@ -0,0 +1,107 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/stats.h>
+#include <zephyr/sys/util.h>
+#include <ksched.h>
+
+#define NUM_PRIOS (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO + 1)
+
+/* Wakeup latency of each priority level, protected by _sched_spinlock */
+static struct k_sched_latency_stats prio_stats[NUM_PRIOS];
+
+static void latency_record(struct k_sched_latency_stats *stats, uint32_t cycles)
+{
+	if ((stats->count == 0U) || (cycles < stats->min)) {
+		stats->min = cycles;
+	}
+
+	stats->max = MAX(stats->max, cycles);
+	stats->count++;
+	stats->total += cycles;
+	z_cycle_hist_record(stats->bins, CONFIG_SCHED_WAKEUP_LATENCY_STATS_BINS, cycles);
+}
+
+void z_sched_latency_ready(struct k_thread *thread)
+{
+	thread->base.ready_stamp = k_cycle_get_32();
+	thread->base.ready_pending = true;
+}
+
+void z_sched_latency_switched_in(struct k_thread *thread)
+{
+	uint32_t cycles;
+	int prio;
+
+	if (!thread->base.ready_pending) {
+		return;
+	}
+
+	cycles = k_cycle_get_32() - thread->base.ready_stamp;
+	thread->base.ready_pending = false;
+
+	/* The priority the thread runs at, which may differ from the one it was made ready at */
+	prio = CLAMP(thread->base.prio, K_HIGHEST_THREAD_PRIO, K_LOWEST_THREAD_PRIO);
+
+	latency_record(&thread->base.wakeup_latency, cycles);
+	latency_record(&prio_stats[prio - K_HIGHEST_THREAD_PRIO], cycles);
+}
+
+int k_thread_wakeup_latency_get(k_tid_t thread, struct k_sched_latency_stats *stats)
+{
+	if ((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		*stats = thread->base.wakeup_latency;
+	}
+
+	return 0;
+}
+
+int k_thread_wakeup_latency_reset(k_tid_t thread)
+{
+	if (thread == NULL) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		memset(&thread->base.wakeup_latency, 0, sizeof(thread->base.wakeup_latency));
+	}
+
+	return 0;
+}
+
+int k_sched_wakeup_latency_get(int prio, struct k_sched_latency_stats *stats)
+{
+	if ((prio < K_HIGHEST_THREAD_PRIO) || (prio > K_LOWEST_THREAD_PRIO) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		*stats = prio_stats[prio - K_HIGHEST_THREAD_PRIO];
+	}
+
+	return 0;
+}
+
+void k_sched_wakeup_latency_reset(void)
+{
+	K_SPINLOCK(&_sched_spinlock) {
+		memset(prio_stats, 0, sizeof(prio_stats));
+	}
+}
+
+uint32_t k_sched_latency_percentile(const struct k_sched_latency_stats *stats,
+				    unsigned int percent)
+{
+	return z_cycle_hist_percentile(stats->bins, CONFIG_SCHED_WAKEUP_LATENCY_STATS_BINS,
+				       percent, stats->min, stats->max);
+}
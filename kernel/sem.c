@@ -28,6 +28,7 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/sys/check.h>
+#include <string.h>
 
 /* We use a system-wide lock to synchronize semaphores, which has
  * unfortunate performance impact vs. using a per-object lock
@@ -40,6 +41,62 @@ static struct k_spinlock lock;
 
 #ifdef CONFIG_OBJ_CORE_SEM
 static struct k_obj_type obj_type_sem;
+
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+static int k_sem_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_sem *sem;
+	k_spinlock_key_t key;
+
+	sem = CONTAINER_OF(obj_core, struct k_sem, obj_core);
+	key = k_spin_lock(&lock);
+	memcpy(stats, &sem->lock_stats, sizeof(sem->lock_stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static int k_sem_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_sem *sem;
+	k_spinlock_key_t key;
+
+	sem = CONTAINER_OF(obj_core, struct k_sem, obj_core);
+	key = k_spin_lock(&lock);
+	memset(&sem->lock_stats, 0, sizeof(sem->lock_stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc sem_stats_desc = {
+	.raw_size = sizeof(struct k_lock_stats),
+	.query_size = sizeof(struct k_lock_stats),
+	.raw   = k_sem_stats_raw,
+	.query = k_sem_stats_raw,
+	.reset = k_sem_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+
+static void sem_stats_wait(struct k_sem *sem, int ret, uint32_t wait_start)
+{
+	uint32_t cycles = k_cycle_get_32() - wait_start;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (ret == 0) {
+		sem->lock_stats.acquired++;
+	}
+	/* Semaphores have no owner, the thread holding it is unknown */
+	z_lock_stats_wait(&sem->lock_stats, cycles, NULL);
+
+	k_spin_unlock(&lock, key);
+}
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 #endif /* CONFIG_OBJ_CORE_SEM */
 
 int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
@@ -68,6 +125,11 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 #ifdef CONFIG_OBJ_CORE_SEM
 	k_obj_core_init_and_link(K_OBJ_CORE(sem), &obj_type_sem);
 #endif /* CONFIG_OBJ_CORE_SEM */
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	memset(&sem->lock_stats, 0, sizeof(sem->lock_stats));
+	k_obj_core_stats_register(K_OBJ_CORE(sem), &sem->lock_stats,
+				  sizeof(struct k_lock_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 
 	return 0;
 }
@@ -142,6 +204,9 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	if (likely(sem->count > 0U)) {
 		sem->count--;
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+		sem->lock_stats.acquired++;
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 		k_spin_unlock(&lock, key);
 		ret = 0;
 		goto out;
@@ -155,8 +220,16 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	uint32_t wait_start = k_cycle_get_32();
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
+
 	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
 
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	sem_stats_wait(sem, ret, wait_start);
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
+
 out:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, take, sem, timeout, ret);
 
@@ -222,11 +295,18 @@ static int init_sem_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_sem, K_OBJ_TYPE_SEM_ID,
 			offsetof(struct k_sem, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	k_obj_type_stats_init(&obj_type_sem, &sem_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 
 	/* Initialize and link statically defined semaphores */
 
 	STRUCT_SECTION_FOREACH(k_sem, sem) {
 		k_obj_core_init_and_link(K_OBJ_CORE(sem), &obj_type_sem);
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+		k_obj_core_stats_register(K_OBJ_CORE(sem), &sem->lock_stats,
+					  sizeof(struct k_lock_stats));
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 	}
 
 	return 0;
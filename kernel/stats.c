@@ -0,0 +1,38 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/stats.h>
+#include <zephyr/sys/util.h>
+
+uint32_t z_cycle_hist_percentile(const uint32_t *bins, unsigned int num_bins,
+				 unsigned int percent, uint32_t min, uint32_t max)
+{
+	uint64_t count = 0;
+	uint64_t target;
+	uint64_t sum = 0;
+
+	for (unsigned int i = 0; i < num_bins; i++) {
+		count += bins[i];
+	}
+
+	if (count == 0U) {
+		return 0;
+	}
+
+	/* Rank of the percentile, rounded up so 100 gives the longest duration */
+	target = DIV_ROUND_UP(count * MIN(percent, 100U), 100U);
+
+	for (unsigned int i = 0; i < num_bins - 1U; i++) {
+		sum += bins[i];
+		if (sum >= MAX(target, 1U)) {
+			/* Upper bound of the bin */
+			return CLAMP((uint32_t)BIT64_MASK(i + 1), min, max);
+		}
+	}
+
+	return max;
+}
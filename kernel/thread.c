@@ -711,6 +711,11 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 		CONFIG_SCHED_THREAD_USAGE_AUTO_ENABLE;
 #endif /* CONFIG_SCHED_THREAD_USAGE */
 
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY_STATS
+	new_thread->base.ready_pending = false;
+	new_thread->base.wakeup_latency = (struct k_sched_latency_stats) {};
+#endif /* CONFIG_SCHED_WAKEUP_LATENCY_STATS */
+
 	SYS_PORT_TRACING_OBJ_FUNC(k_thread, create, new_thread);
 
 	return stack_ptr;
@@ -988,6 +993,10 @@ void z_thread_mark_switched_in(void)
 	z_sched_usage_start(_current);
 #endif /* CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
 
+#if defined(CONFIG_SCHED_WAKEUP_LATENCY_STATS) && !defined(CONFIG_USE_SWITCH)
+	z_sched_latency_switched_in(_current);
+#endif /* CONFIG_SCHED_WAKEUP_LATENCY_STATS && !CONFIG_USE_SWITCH */
+
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
 #endif /* CONFIG_TRACING */
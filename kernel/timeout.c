@@ -11,11 +11,11 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/barrier.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 /*
  * The timeout code shall take no locks other than its own (timeout_lock), nor
  * shall it call any other subsystem while holding this lock.
@@ -37,29 +37,508 @@ static inline unsigned int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
-static struct _timeout *first(void)
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/*
+ * Hierarchical timing wheel.  Each level holds BIT(WHEEL_SLOT_BITS) slots,
+ * level N slots being BIT(N * WHEEL_SLOT_BITS) ticks wide.  A timeout lives
+ * at the lowest level on which its absolute expiry (kept in dticks) shares
+ * all the more significant digits with curr_tick, so level 0 slots only
+ * ever contain timeouts expiring on that exact tick.  Whenever curr_tick
+ * moves into a new slot of a higher level, the timeouts of that slot are
+ * cascaded down.  Timeouts further away than the wheel can represent are
+ * parked on an unsorted overflow list.
+ *
+ * Insertion and removal are O(1).  The next expiry is derived from the
+ * per-level occupancy bitmaps; for the higher levels it is the start of the
+ * earliest occupied slot, i.e. a lower bound, which costs at most one
+ * additional (cascading) timer interrupt per level.
+ */
+#define WHEEL_SLOT_BITS 6
+#define WHEEL_SLOTS     BIT(WHEEL_SLOT_BITS)
+#define WHEEL_LEVELS    CONFIG_TIMEOUT_WHEEL_LEVELS
+
+struct timeout_queue {
+#ifdef CONFIG_TIMEOUT_PER_CPU_QUEUES
+	struct k_spinlock lock;
+	/* Absolute tick of the next expiry, UINT64_MAX when empty */
+	uint64_t next_tick;
+#endif /* CONFIG_TIMEOUT_PER_CPU_QUEUES */
+	/* Occupancy bitmap per level, a slot list is only valid if its bit is set */
+	uint64_t pending[WHEEL_LEVELS];
+	sys_dlist_t slots[WHEEL_LEVELS][WHEEL_SLOTS];
+	sys_dlist_t overflow;
+};
+
+#define TIMEOUT_QUEUE_INITIALIZER(q)						\
+	{									\
+		IF_ENABLED(CONFIG_TIMEOUT_PER_CPU_QUEUES, (.next_tick = UINT64_MAX,))	\
+		.overflow = SYS_DLIST_STATIC_INIT(&(q).overflow),		\
+	}
+
+static void wheel_place(struct timeout_queue *q, struct _timeout *t, bool head)
+{
+	uint64_t diff = (uint64_t)t->dticks ^ curr_tick;
+	int level = (diff == 0U) ? 0 : (63 - u64_count_leading_zeros(diff)) / WHEEL_SLOT_BITS;
+	sys_dlist_t *list = &q->overflow;
+
+	if (level < WHEEL_LEVELS) {
+		unsigned int slot = (t->dticks >> (level * WHEEL_SLOT_BITS)) & (WHEEL_SLOTS - 1);
+
+		list = &q->slots[level][slot];
+		if ((q->pending[level] & BIT64(slot)) == 0U) {
+			sys_dlist_init(list);
+			q->pending[level] |= BIT64(slot);
+		}
+	}
+
+	if (head) {
+		sys_dlist_prepend(list, &t->node);
+	} else {
+		sys_dlist_append(list, &t->node);
+	}
+}
+
+/* Re-insert every timeout of @list relative to the current tick. Timeouts
+ * are prepended in reverse order: they were all added before anything that
+ * is already queued in their new slot, and that FIFO order must be kept for
+ * timeouts sharing the same expiry.
+ */
+static void wheel_cascade(struct timeout_queue *q, sys_dlist_t *list)
+{
+	sys_dlist_t tmp;
+	sys_dnode_t *n;
+
+	sys_dlist_init(&tmp);
+	while ((n = sys_dlist_get(list)) != NULL) {
+		sys_dlist_append(&tmp, n);
+	}
+
+	while ((n = sys_dlist_peek_tail(&tmp)) != NULL) {
+		sys_dlist_remove(n);
+		wheel_place(q, CONTAINER_OF(n, struct _timeout, node), true);
+	}
+}
+
+static void timeout_queue_insert(struct timeout_queue *q, struct _timeout *to)
+{
+	to->dticks += curr_tick;
+	wheel_place(q, to, false);
+}
+
+static void remove_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	sys_dnode_t *n = &t->node;
+
+	/* Last entry of a slot: both neighbours are the slot list head */
+	if ((n->next == n->prev) && (n->next != &q->overflow)) {
+		size_t idx = n->next - &q->slots[0][0];
+
+		q->pending[idx / WHEEL_SLOTS] &= ~BIT64(idx % WHEEL_SLOTS);
+	}
+
+	sys_dlist_remove(n);
+}
+
+/* Ticks from curr_tick until the wheel needs servicing, -1 when empty */
+static int64_t timeout_queue_next(struct timeout_queue *q)
+{
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		if (q->pending[level] != 0U) {
+			unsigned int shift = level * WHEEL_SLOT_BITS;
+			uint64_t slot = u64_count_trailing_zeros(q->pending[level]);
+			uint64_t base = (curr_tick >> (shift + WHEEL_SLOT_BITS))
+					<< (shift + WHEEL_SLOT_BITS);
+
+			return (int64_t)((base | (slot << shift)) - curr_tick);
+		}
+	}
+
+	if (!sys_dlist_is_empty(&q->overflow)) {
+		unsigned int shift = WHEEL_LEVELS * WHEEL_SLOT_BITS;
+
+		return (int64_t)((((curr_tick >> shift) + 1U) << shift) - curr_tick);
+	}
+
+	return -1;
+}
+
+/* Called once curr_tick moved forward by @ticks. Caller guarantees no
+ * timeout expired before the new curr_tick.
+ */
+static void timeout_queue_advance(struct timeout_queue *q, int64_t ticks)
+{
+	uint64_t prev = curr_tick - ticks;
+
+	if (((prev ^ curr_tick) >> (WHEEL_LEVELS * WHEEL_SLOT_BITS)) != 0U) {
+		wheel_cascade(q, &q->overflow);
+	}
+
+	for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+		unsigned int slot = (curr_tick >> (level * WHEEL_SLOT_BITS)) & (WHEEL_SLOTS - 1);
+
+		if ((q->pending[level] & BIT64(slot)) != 0U) {
+			q->pending[level] &= ~BIT64(slot);
+			wheel_cascade(q, &q->slots[level][slot]);
+		}
+	}
+}
+
+/* Next timeout expiring on curr_tick, if any */
+static struct _timeout *timeout_queue_expired(struct timeout_queue *q)
 {
-	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
+	unsigned int slot = curr_tick & (WHEEL_SLOTS - 1);
+
+	if ((q->pending[0] & BIT64(slot)) == 0U) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(sys_dlist_peek_head(&q->slots[0][slot]), struct _timeout, node);
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_queue *q, const struct _timeout *timeout)
+{
+	ARG_UNUSED(q);
+
+	return timeout->dticks - curr_tick;
+}
+
+#else
+
+struct timeout_queue {
+#ifdef CONFIG_TIMEOUT_PER_CPU_QUEUES
+	struct k_spinlock lock;
+	/* Absolute tick of the next expiry, UINT64_MAX when empty */
+	uint64_t next_tick;
+#endif /* CONFIG_TIMEOUT_PER_CPU_QUEUES */
+	sys_dlist_t list;
+};
+
+#define TIMEOUT_QUEUE_INITIALIZER(q)						\
+	{									\
+		IF_ENABLED(CONFIG_TIMEOUT_PER_CPU_QUEUES, (.next_tick = UINT64_MAX,))	\
+		.list = SYS_DLIST_STATIC_INIT(&(q).list),			\
+	}
+
+static struct _timeout *first(struct timeout_queue *q)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&q->list);
 
 	return (t == NULL) ? NULL : CONTAINER_OF(t, struct _timeout, node);
 }
 
-static struct _timeout *next(struct _timeout *t)
+static struct _timeout *next(struct timeout_queue *q, struct _timeout *t)
 {
-	sys_dnode_t *n = sys_dlist_peek_next(&timeout_list, &t->node);
+	sys_dnode_t *n = sys_dlist_peek_next(&q->list, &t->node);
 
 	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
-static void remove_timeout(struct _timeout *t)
+static void timeout_queue_insert(struct timeout_queue *q, struct _timeout *to)
 {
-	if (next(t) != NULL) {
-		next(t)->dticks += t->dticks;
+	struct _timeout *t;
+
+	for (t = first(q); t != NULL; t = next(q, t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&q->list, &to->node);
+	}
+}
+
+static void remove_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	if (next(q, t) != NULL) {
+		next(q, t)->dticks += t->dticks;
 	}
 
 	sys_dlist_remove(&t->node);
 }
 
+/* Ticks from curr_tick until the first timeout expires, -1 when empty */
+static int64_t timeout_queue_next(struct timeout_queue *q)
+{
+	struct _timeout *to = first(q);
+
+	return (to == NULL) ? -1 : to->dticks;
+}
+
+/* Called once curr_tick moved forward by @ticks. Caller guarantees no
+ * timeout expired before the new curr_tick.
+ */
+static void timeout_queue_advance(struct timeout_queue *q, int64_t ticks)
+{
+	struct _timeout *to = first(q);
+
+	if (to != NULL) {
+		to->dticks -= ticks;
+	}
+}
+
+/* Next timeout expiring on curr_tick, if any */
+static struct _timeout *timeout_queue_expired(struct timeout_queue *q)
+{
+	struct _timeout *to = first(q);
+
+	return ((to == NULL) || (to->dticks != 0)) ? NULL : to;
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(struct timeout_queue *q, const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(q); t != NULL; t = next(q, t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+#ifdef CONFIG_TIMEOUT_PER_CPU_QUEUES
+#define NUM_TIMEOUT_QUEUES CONFIG_MP_MAX_NUM_CPUS
+#else
+#define NUM_TIMEOUT_QUEUES 1
+#endif /* CONFIG_TIMEOUT_PER_CPU_QUEUES */
+
+#define TIMEOUT_QUEUE_INIT(i, _) TIMEOUT_QUEUE_INITIALIZER(timeout_queues[i])
+
+static struct timeout_queue timeout_queues[NUM_TIMEOUT_QUEUES] = {
+	LISTIFY(NUM_TIMEOUT_QUEUES, TIMEOUT_QUEUE_INIT, (,))
+};
+
+static int32_t next_timeout(int32_t ticks_elapsed);
+static int32_t elapsed(void);
+
+#ifdef CONFIG_TIMEOUT_PER_CPU_QUEUES
+
+/*
+ * Each CPU adds timeouts to its own queue, under that queue's lock, so
+ * that CPUs arming and cancelling timeouts don't contend with each other.
+ * All queues are kept relative to the global curr_tick, which only moves
+ * while sys_clock_announce() holds timeout_lock and every queue lock
+ * (taken in CPU order).  Expiry merges the queues, so timeouts still fire
+ * one at a time and in global expiry order, as the system timer driver
+ * contract requires.
+ *
+ * Each queue publishes the absolute tick of its next expiry in next_tick,
+ * which is read without the queue lock (hence the 64-bit requirement) to
+ * compute the global timer deadline under timeout_lock.
+ */
+static void timeout_queue_publish(struct timeout_queue *q)
+{
+	int64_t dticks = timeout_queue_next(q);
+
+	q->next_tick = (dticks < 0) ? UINT64_MAX : (curr_tick + dticks);
+}
+
+static struct timeout_queue *timeout_queue_lock_local(k_spinlock_key_t *key)
+{
+	/* Any queue would do, so a stale CPU id after a migration is harmless */
+	struct timeout_queue *q = &timeout_queues[arch_curr_cpu()->id];
+
+	*key = k_spin_lock(&q->lock);
+
+	return q;
+}
+
+static struct timeout_queue *timeout_queue_lock_owner(const struct _timeout *to,
+						       k_spinlock_key_t *key)
+{
+	for (;;) {
+		struct timeout_queue *q = &timeout_queues[to->cpu];
+
+		*key = k_spin_lock(&q->lock);
+
+		/* Pairs with the barrier in z_add_timeout(): a timeout found
+		 * linked is on this queue unless its owner changed meanwhile.
+		 */
+		if (!sys_dnode_is_linked(&to->node)) {
+			return q;
+		}
+		barrier_dmem_fence_full();
+		if (q == &timeout_queues[to->cpu]) {
+			return q;
+		}
+
+		k_spin_unlock(&q->lock, *key);
+	}
+}
+
+static void timeout_queue_unlock(struct timeout_queue *q, k_spinlock_key_t key, bool reprogram)
+{
+	timeout_queue_publish(q);
+	k_spin_unlock(&q->lock, key);
+
+	if (reprogram) {
+		K_SPINLOCK(&timeout_lock) {
+			if (announce_remaining == 0) {
+				sys_clock_set_timeout(next_timeout(elapsed()), false);
+			}
+		}
+	}
+}
+
+/* Ticks from curr_tick until the earliest expiry over all queues, -1 when empty */
+static int64_t next_expiry(void)
+{
+	uint64_t next_tick = UINT64_MAX;
+
+	for (unsigned int i = 0; i < NUM_TIMEOUT_QUEUES; i++) {
+		next_tick = MIN(next_tick, *(volatile uint64_t *)&timeout_queues[i].next_tick);
+	}
+
+	return (next_tick == UINT64_MAX) ? -1 : (int64_t)(MAX(next_tick, curr_tick) - curr_tick);
+}
+
+/* sys_clock_announce() helpers, called with timeout_lock held */
+static void timeout_queues_lock_all(k_spinlock_key_t *keys)
+{
+	for (unsigned int i = 0; i < NUM_TIMEOUT_QUEUES; i++) {
+		keys[i] = k_spin_lock(&timeout_queues[i].lock);
+	}
+}
+
+static void timeout_queues_unlock_all(k_spinlock_key_t *keys)
+{
+	for (unsigned int i = NUM_TIMEOUT_QUEUES; i > 0; i--) {
+		timeout_queue_publish(&timeout_queues[i - 1]);
+		k_spin_unlock(&timeout_queues[i - 1].lock, keys[i - 1]);
+	}
+}
+
+static struct timeout_queue *timeout_queues_first(int64_t *dticks)
+{
+	struct timeout_queue *first_q = NULL;
+
+	*dticks = -1;
+	for (unsigned int i = 0; i < NUM_TIMEOUT_QUEUES; i++) {
+		int64_t dt = timeout_queue_next(&timeout_queues[i]);
+
+		if ((dt >= 0) && ((first_q == NULL) || (dt < *dticks))) {
+			first_q = &timeout_queues[i];
+			*dticks = dt;
+		}
+	}
+
+	return first_q;
+}
+
+static void timeout_queues_advance(int64_t ticks)
+{
+	curr_tick += ticks;
+	for (unsigned int i = 0; i < NUM_TIMEOUT_QUEUES; i++) {
+		timeout_queue_advance(&timeout_queues[i], ticks);
+	}
+}
+
+/* Remove the next timeout expiring on curr_tick, locking only the queue
+ * holding it.  Nothing can be added on curr_tick while announcing, so the
+ * queues whose next_tick is another tick can be skipped without their lock.
+ */
+static struct _timeout *timeout_queues_pop_expired(void)
+{
+	for (unsigned int i = 0; i < NUM_TIMEOUT_QUEUES; i++) {
+		struct timeout_queue *q = &timeout_queues[i];
+		struct _timeout *t;
+		k_spinlock_key_t key;
+
+		if (*(volatile uint64_t *)&q->next_tick != curr_tick) {
+			continue;
+		}
+
+		key = k_spin_lock(&q->lock);
+		t = timeout_queue_expired(q);
+		if (t != NULL) {
+			t->dticks = 0;
+			remove_timeout(q, t);
+		}
+		timeout_queue_publish(q);
+		k_spin_unlock(&q->lock, key);
+
+		if (t != NULL) {
+			return t;
+		}
+	}
+
+	return NULL;
+}
+
+#else
+
+static struct timeout_queue *timeout_queue_lock_local(k_spinlock_key_t *key)
+{
+	*key = k_spin_lock(&timeout_lock);
+
+	return &timeout_queues[0];
+}
+
+static struct timeout_queue *timeout_queue_lock_owner(const struct _timeout *to,
+						       k_spinlock_key_t *key)
+{
+	ARG_UNUSED(to);
+
+	return timeout_queue_lock_local(key);
+}
+
+static void timeout_queue_unlock(struct timeout_queue *q, k_spinlock_key_t key, bool reprogram)
+{
+	ARG_UNUSED(q);
+
+	if (reprogram && (announce_remaining == 0)) {
+		sys_clock_set_timeout(next_timeout(elapsed()), false);
+	}
+
+	k_spin_unlock(&timeout_lock, key);
+}
+
+static int64_t next_expiry(void)
+{
+	return timeout_queue_next(&timeout_queues[0]);
+}
+
+#define timeout_queues_lock_all(keys) ARG_UNUSED(keys)
+#define timeout_queues_unlock_all(keys) ARG_UNUSED(keys)
+
+static struct timeout_queue *timeout_queues_first(int64_t *dticks)
+{
+	*dticks = timeout_queue_next(&timeout_queues[0]);
+
+	return (*dticks < 0) ? NULL : &timeout_queues[0];
+}
+
+static void timeout_queues_advance(int64_t ticks)
+{
+	curr_tick += ticks;
+	timeout_queue_advance(&timeout_queues[0], ticks);
+}
+
+static struct _timeout *timeout_queues_pop_expired(void)
+{
+	struct _timeout *t = timeout_queue_expired(&timeout_queues[0]);
+
+	if (t != NULL) {
+		t->dticks = 0;
+		remove_timeout(&timeout_queues[0], t);
+	}
+
+	return t;
+}
+
+#endif /* CONFIG_TIMEOUT_PER_CPU_QUEUES */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -83,14 +562,14 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(int32_t ticks_elapsed)
 {
-	struct _timeout *to = first();
+	int64_t dticks = next_expiry();
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if ((dticks < 0) ||
+	    ((int64_t)(dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = SYS_CLOCK_MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, dticks - ticks_elapsed);
 	}
 
 	return ret;
@@ -98,7 +577,10 @@ static int32_t next_timeout(int32_t ticks_elapsed)
 
 k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
 {
+	struct timeout_queue *q;
+	k_spinlock_key_t key;
 	k_ticks_t ticks = 0;
+	int64_t prev_next;
 
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		return 0;
@@ -111,109 +593,87 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 	__ASSERT(!sys_dnode_is_linked(&to->node), "");
 	to->fn = fn;
 
-	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
-		int32_t ticks_elapsed;
-		bool has_elapsed = false;
+	q = timeout_queue_lock_local(&key);
+	prev_next = timeout_queue_next(q);
 
-		if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
-			ticks_elapsed = elapsed();
-			has_elapsed = true;
-			to->dticks = timeout.ticks + 1 + ticks_elapsed;
-			ticks = curr_tick + to->dticks;
-		} else {
-			k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+	if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
+		to->dticks = timeout.ticks + 1 + elapsed();
+		ticks = curr_tick + to->dticks;
+	} else {
+		k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
 
-			to->dticks = MAX(1, dticks);
-			ticks = timeout.ticks;
-		}
+		to->dticks = MAX(1, dticks);
+		ticks = timeout.ticks;
+	}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
+#ifdef CONFIG_TIMEOUT_PER_CPU_QUEUES
+	/* Owner must be visible before the timeout shows up as linked */
+	to->cpu = q - timeout_queues;
+	barrier_dmem_fence_full();
+#endif /* CONFIG_TIMEOUT_PER_CPU_QUEUES */
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+	timeout_queue_insert(q, to);
 
-		if (to == first() && announce_remaining == 0) {
-			if (!has_elapsed) {
-				/* In case of absolute timeout that is first to expire
-				 * elapsed need to be read from the system clock.
-				 */
-				ticks_elapsed = elapsed();
-			}
-			sys_clock_set_timeout(next_timeout(ticks_elapsed), false);
-		}
-	}
+	timeout_queue_unlock(q, key, timeout_queue_next(q) != prev_next);
 
 	return ticks;
 }
 
 int z_abort_timeout(struct _timeout *to)
 {
+	struct timeout_queue *q;
+	k_spinlock_key_t key;
+	bool reprogram = false;
 	int ret = -EINVAL;
 
-	K_SPINLOCK(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
-			bool is_first = (to == first());
-
-			remove_timeout(to);
-			to->dticks = TIMEOUT_DTICKS_ABORTED;
-			ret = 0;
-			if (is_first) {
-				sys_clock_set_timeout(next_timeout(elapsed()), false);
-			}
-		}
-	}
-
-	return ret;
-}
+	q = timeout_queue_lock_owner(to, &key);
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
-{
-	k_ticks_t ticks = 0;
+	if (sys_dnode_is_linked(&to->node)) {
+		int64_t prev_next = timeout_queue_next(q);
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
+		remove_timeout(q, to);
+		to->dticks = TIMEOUT_DTICKS_ABORTED;
+		ret = 0;
+		reprogram = (timeout_queue_next(q) != prev_next);
 	}
 
-	return ticks;
+	timeout_queue_unlock(q, key, reprogram);
+
+	return ret;
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
+	struct timeout_queue *q;
+	k_spinlock_key_t key;
 	k_ticks_t ticks = 0;
 
-	K_SPINLOCK(&timeout_lock) {
-		if (!z_is_inactive_timeout(timeout)) {
-			ticks = timeout_rem(timeout) - elapsed();
-		}
+	q = timeout_queue_lock_owner(timeout, &key);
+
+	if (!z_is_inactive_timeout(timeout)) {
+		ticks = timeout_rem(q, timeout) - elapsed();
 	}
 
+	timeout_queue_unlock(q, key, false);
+
 	return ticks;
 }
 
 k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 {
+	struct timeout_queue *q;
+	k_spinlock_key_t key;
 	k_ticks_t ticks = 0;
 
-	K_SPINLOCK(&timeout_lock) {
-		ticks = curr_tick;
-		if (!z_is_inactive_timeout(timeout)) {
-			ticks += timeout_rem(timeout);
-		}
+	q = timeout_queue_lock_owner(timeout, &key);
+
+	ticks = curr_tick;
+	if (!z_is_inactive_timeout(timeout)) {
+		ticks += timeout_rem(q, timeout);
 	}
 
+	timeout_queue_unlock(q, key, false);
+
 	return ticks;
 }
 
@@ -229,6 +689,7 @@ int32_t z_get_next_timeout_expiry(void)
 
 void sys_clock_announce(int32_t ticks)
 {
+	k_spinlock_key_t keys[NUM_TIMEOUT_QUEUES];
 	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
 
 	/* We release the lock around the callbacks below, so on SMP
@@ -245,28 +706,33 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
-	struct _timeout *t;
+	for (;;) {
+		struct _timeout *t;
+		int64_t dt;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
+		/* All the queue locks are only needed to move curr_tick, which
+		 * is done once per expiry tick rather than once per timeout.
+		 */
+		timeout_queues_lock_all(keys);
 
-		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
+		if ((timeout_queues_first(&dt) == NULL) || (dt > announce_remaining)) {
+			break;
+		}
 
-		k_spin_unlock(&timeout_lock, key);
-		t->fn(t);
-		key = k_spin_lock(&timeout_lock);
-		announce_remaining -= dt;
-	}
+		timeout_queues_advance(dt);
+		timeout_queues_unlock_all(keys);
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
+		/* The timing wheel may only need to cascade at this tick */
+		while ((t = timeout_queues_pop_expired()) != NULL) {
+			k_spin_unlock(&timeout_lock, key);
+			t->fn(t);
+			key = k_spin_lock(&timeout_lock);
+		}
+		announce_remaining -= dt;
 	}
 
-	curr_tick += announce_remaining;
+	timeout_queues_advance(announce_remaining);
+	timeout_queues_unlock_all(keys);
 	announce_remaining = 0;
 
 	sys_clock_set_timeout(next_timeout(0), false);
@@ -350,7 +816,50 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	k_spinlock_key_t keys[NUM_TIMEOUT_QUEUES];
+	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	uint64_t delta = tick - curr_tick;
+
+	timeout_queues_lock_all(keys);
+
+	/* Expiries are absolute, shift them along to keep the remaining
+	 * time of every pending timeout unchanged.
+	 */
+	curr_tick = tick;
+	for (unsigned int i = 0; i < NUM_TIMEOUT_QUEUES; i++) {
+		struct timeout_queue *q = &timeout_queues[i];
+		sys_dlist_t pending;
+		sys_dnode_t *n;
+
+		sys_dlist_init(&pending);
+		for (int level = 0; level < WHEEL_LEVELS; level++) {
+			while (q->pending[level] != 0U) {
+				unsigned int slot = u64_count_trailing_zeros(q->pending[level]);
+
+				q->pending[level] &= ~BIT64(slot);
+				while ((n = sys_dlist_get(&q->slots[level][slot])) != NULL) {
+					sys_dlist_append(&pending, n);
+				}
+			}
+		}
+		while ((n = sys_dlist_get(&q->overflow)) != NULL) {
+			sys_dlist_append(&pending, n);
+		}
+
+		while ((n = sys_dlist_get(&pending)) != NULL) {
+			struct _timeout *t = CONTAINER_OF(n, struct _timeout, node);
+
+			t->dticks += delta;
+			wheel_place(q, t, false);
+		}
+	}
+
+	timeout_queues_unlock_all(keys);
+	k_spin_unlock(&timeout_lock, key);
+#else
 	curr_tick = tick;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
@@ -60,10 +60,42 @@ static inline uint32_t flags_get(const uint32_t *flagp)
 	return *flagp;
 }
 
-/* Lock to protect the internal state of all work items, work queues,
- * and pending_cancels.
+/* Locks protecting the internal state of work items.
+ *
+ * A work item is protected by the lock selected by hashing its address,
+ * along with the list of cancellations pending on the work items using
+ * that lock.  The state of a work queue is protected by the queue's own
+ * lock.  When both are needed the work lock is taken first.
  */
-static struct k_spinlock lock;
+struct work_lock {
+	struct k_spinlock lock;
+
+	/* List of pending cancellations. */
+	sys_slist_t pending_cancels;
+};
+
+static struct work_lock work_locks[CONFIG_WORKQUEUE_LOCK_STRIPES];
+
+static inline struct work_lock *work_lock_get(const struct k_work *work)
+{
+	return &work_locks[((uintptr_t)work / sizeof(struct k_work)) %
+			   CONFIG_WORKQUEUE_LOCK_STRIPES];
+}
+
+struct k_spinlock *z_work_lock_get(const struct k_work *work)
+{
+	return &work_lock_get(work)->lock;
+}
+
+static inline k_spinlock_key_t work_lock(const struct k_work *work)
+{
+	return k_spin_lock(&work_lock_get(work)->lock);
+}
+
+static inline void work_unlock(const struct k_work *work, k_spinlock_key_t key)
+{
+	k_spin_unlock(&work_lock_get(work)->lock, key);
+}
 
 /* Invoked by work thread */
 static void handle_flush(struct k_work *work) { }
@@ -76,9 +108,6 @@ static inline void init_flusher(struct z_work_flusher *flusher)
 	flag_set(&work->flags, K_WORK_FLUSHING_BIT);
 }
 
-/* List of pending cancellations. */
-static sys_slist_t pending_cancels;
-
 /* Initialize a canceler record and add it to the list of pending
  * cancels.
  *
@@ -92,7 +121,7 @@ static inline void init_work_cancel(struct z_work_canceller *canceler,
 {
 	k_sem_init(&canceler->sem, 0, 1);
 	canceler->work = work;
-	sys_slist_append(&pending_cancels, &canceler->node);
+	sys_slist_append(&work_lock_get(work)->pending_cancels, &canceler->node);
 }
 
 /* Complete flushing of a work item.
@@ -127,6 +156,7 @@ static void finalize_flush_locked(struct k_work *work)
  */
 static void finalize_cancel_locked(struct k_work *work)
 {
+	sys_slist_t *pending_cancels = &work_lock_get(work)->pending_cancels;
 	struct z_work_canceller *wc, *tmp;
 	sys_snode_t *prev = NULL;
 
@@ -140,9 +170,9 @@ static void finalize_cancel_locked(struct k_work *work)
 	 * appear multiple times in the list if multiple threads
 	 * attempt to cancel it.
 	 */
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&pending_cancels, wc, tmp, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(pending_cancels, wc, tmp, node) {
 		if (wc->work == work) {
-			sys_slist_remove(&pending_cancels, prev, &wc->node);
+			sys_slist_remove(pending_cancels, prev, &wc->node);
 			k_sem_give(&wc->sem);
 			break;
 		}
@@ -168,17 +198,17 @@ static inline int work_busy_get_locked(const struct k_work *work)
 
 int k_work_busy_get(const struct k_work *work)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(work);
 	int ret = work_busy_get_locked(work);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(work, key);
 
 	return ret;
 }
 
 /* Add a flusher work item to the queue.
  *
- * Invoked with work lock held.
+ * Invoked with work lock and queue lock held.
  *
  * Caller must notify queue of pending work.
  *
@@ -204,6 +234,7 @@ static void queue_flusher_locked(struct k_work_q *queue,
 /* Try to remove a work item from the given queue.
  *
  * Invoked with work lock held.
+ * Takes and releases queue lock.
  *
  * @param queue the queue from which the work should be removed
  * @param work work that may be on the queue
@@ -211,12 +242,17 @@ static void queue_flusher_locked(struct k_work_q *queue,
 static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
-	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
-		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
+	if (flag_test(&work->flags, K_WORK_QUEUED_BIT)) {
+		K_SPINLOCK(&queue->lock) {
+			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
+			(void)sys_slist_find_and_remove(&queue->pending, &work->node);
+		}
 	}
 }
 
 /* Potentially notify a queue that it needs to look for pending work.
+ *
+ * Invoked with queue lock held.
  *
  * This may make the work queue thread ready, but as the lock is held it
  * will not be a reschedule point.  Callers should yield after the lock is
@@ -245,8 +281,12 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
  * thread (chained submission).
  *
  * Invoked with work lock held.
+ * Takes and releases queue lock.
  * Conditionally notifies queue.
  *
+ * The work is marked queued while the queue lock is held, so the work
+ * queue thread never sees an item on its pending list without it.
+ *
  * @param queue the queue to which work should be submitted.  This may
  * be null, in which case the submission will fail.
  *
@@ -265,6 +305,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret;
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	bool chained = (_current == queue->thread_id) && !k_is_in_isr();
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
@@ -284,10 +325,14 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 		ret = -EBUSY;
 	} else {
 		sys_slist_append(&queue->pending, &work->node);
+		flag_set(&work->flags, K_WORK_QUEUED_BIT);
+		work->queue = queue;
 		ret = 1;
 		(void)notify_queue_locked(queue);
 	}
 
+	k_spin_unlock(&queue->lock, key);
+
 	return ret;
 }
 
@@ -349,9 +394,6 @@ static int submit_to_queue_locked(struct k_work *work,
 
 		if (rc < 0) {
 			ret = rc;
-		} else {
-			flag_set(&work->flags, K_WORK_QUEUED_BIT);
-			work->queue = *queuep;
 		}
 	} else {
 		/* Already queued, do nothing. */
@@ -381,11 +423,11 @@ int z_work_submit_to_queue(struct k_work_q *queue,
 	__ASSERT_NO_MSG(work != NULL);
 	__ASSERT_NO_MSG(work->handler != NULL);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(work);
 
 	int ret = submit_to_queue_locked(work, &queue);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(work, key);
 
 	return ret;
 }
@@ -448,8 +490,10 @@ static bool work_flush_locked(struct k_work *work,
 
 		__ASSERT_NO_MSG(queue != NULL);
 
-		queue_flusher_locked(queue, work, flusher);
-		notify_queue_locked(queue);
+		K_SPINLOCK(&queue->lock) {
+			queue_flusher_locked(queue, work, flusher);
+			notify_queue_locked(queue);
+		}
 	}
 
 	return need_flush;
@@ -469,11 +513,11 @@ bool k_work_flush(struct k_work *work,
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, flush, work);
 
 	struct z_work_flusher *flusher = &sync->flusher;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(work);
 
 	bool need_flush = work_flush_locked(work, flusher);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(work, key);
 
 	/* If necessary wait until the flusher item completes */
 	if (need_flush) {
@@ -557,10 +601,10 @@ int k_work_cancel(struct k_work *work)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, cancel, work);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(work);
 	int ret = cancel_async_locked(work);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(work, key);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, cancel, work, ret);
 
@@ -581,7 +625,7 @@ bool k_work_cancel_sync(struct k_work *work,
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, cancel_sync, work, sync);
 
 	struct z_work_canceller *canceller = &sync->canceller;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(work);
 	bool pending = (work_busy_get_locked(work) != 0U);
 	bool need_wait = false;
 
@@ -590,7 +634,7 @@ bool k_work_cancel_sync(struct k_work *work,
 		need_wait = cancel_sync_locked(work, canceller);
 	}
 
-	k_spin_unlock(&lock, key);
+	work_unlock(work, key);
 
 	if (need_wait) {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_work, cancel_sync, work, sync);
@@ -611,7 +655,7 @@ static void work_timeout_handler(struct _timeout *record)
 	const char *name;
 	const char *space = " ";
 
-	K_SPINLOCK(&lock) {
+	K_SPINLOCK(&queue->lock) {
 		work = queue->work;
 		handler = work->handler;
 	}
@@ -663,17 +707,37 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		sys_snode_t *node;
 		struct k_work *work = NULL;
 		k_work_handler_t handler = NULL;
-		k_spinlock_key_t key = k_spin_lock(&lock);
+		k_spinlock_key_t key = k_spin_lock(&queue->lock);
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
+		node = sys_slist_peek_head(&queue->pending);
 		if (node != NULL) {
+			work = CONTAINER_OF(node, struct k_work, node);
+
+			/* The work lock has to be taken before the queue
+			 * lock.  Only the address of the work is used until
+			 * it is confirmed to still be at the head of the
+			 * pending list, as it may have been cancelled (or a
+			 * flusher prepended) while no lock was held.
+			 */
+			k_spin_unlock(&queue->lock, key);
+
+			k_spinlock_key_t wkey = work_lock(work);
+
+			key = k_spin_lock(&queue->lock);
+			if (sys_slist_peek_head(&queue->pending) != node) {
+				k_spin_unlock(&queue->lock, key);
+				work_unlock(work, wkey);
+				continue;
+			}
+
+			(void)sys_slist_get(&queue->pending);
+
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
 			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
-			work = CONTAINER_OF(node, struct k_work, node);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
 
@@ -690,6 +754,13 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
+
+#if defined(CONFIG_WORKQUEUE_WORK_TIMEOUT)
+			work_timeout_start_locked(queue, work);
+#endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
+
+			k_spin_unlock(&queue->lock, key);
+			work_unlock(work, wkey);
 		} else if (flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
@@ -706,7 +777,7 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			/* User has requested that the queue stop. Clear the status flags and exit.
 			 */
 			flags_set(&queue->flags, 0);
-			k_spin_unlock(&lock, key);
+			k_spin_unlock(&queue->lock, key);
 			return;
 		} else {
 			/* No work is available and no queue state requires
@@ -722,17 +793,11 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * work thread will be woken and we can check again.
 			 */
 
-			(void)z_sched_wait(&lock, key, &queue->notifyq,
+			(void)z_sched_wait(&queue->lock, key, &queue->notifyq,
 					   K_FOREVER, NULL);
 			continue;
 		}
 
-#if defined(CONFIG_WORKQUEUE_WORK_TIMEOUT)
-		work_timeout_start_locked(queue, work);
-#endif /* defined(CONFIG_WORKQUEUE_WORK_TIMEOUT) */
-
-		k_spin_unlock(&lock, key);
-
 		__ASSERT_NO_MSG(handler != NULL);
 		handler(work);
 
@@ -741,7 +806,9 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		 * was running.  Clear the BUSY flag and optionally
 		 * yield to prevent starving other threads.
 		 */
-		key = k_spin_lock(&lock);
+		k_spinlock_key_t wkey = work_lock(work);
+
+		key = k_spin_lock(&queue->lock);
 
 #if defined(CONFIG_WORKQUEUE_WORK_TIMEOUT)
 		work_timeout_stop_locked(queue);
@@ -757,7 +824,8 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&queue->lock, key);
+		work_unlock(work, wkey);
 
 		/* Optionally yield to prevent the work queue from
 		 * starving other threads.
@@ -872,7 +940,7 @@ int k_work_queue_drain(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, drain, queue);
 
 	int ret = 0;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 
 	if (((flags_get(&queue->flags)
 	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
@@ -884,10 +952,10 @@ int k_work_queue_drain(struct k_work_q *queue,
 		}
 
 		notify_queue_locked(queue);
-		ret = z_sched_wait(&lock, key, &queue->drainq,
+		ret = z_sched_wait(&queue->lock, key, &queue->drainq,
 				   K_FOREVER, NULL);
 	} else {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&queue->lock, key);
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, drain, queue, ret);
@@ -902,13 +970,13 @@ int k_work_queue_unplug(struct k_work_q *queue)
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, unplug, queue);
 
 	int ret = -EALREADY;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 
 	if (flag_test_and_clear(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT)) {
 		ret = 0;
 	}
 
-	k_spin_unlock(&lock, key);
+	k_spin_unlock(&queue->lock, key);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, unplug, queue, ret);
 
@@ -920,28 +988,28 @@ int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout)
 	__ASSERT_NO_MSG(queue);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, stop, queue, timeout);
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 
 	if (!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT)) {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&queue->lock, key);
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, stop, queue, timeout, -EALREADY);
 		return -EALREADY;
 	}
 
 	if (!flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT)) {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&queue->lock, key);
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, stop, queue, timeout, -EBUSY);
 		return -EBUSY;
 	}
 
 	flag_set(&queue->flags, K_WORK_QUEUE_STOP_BIT);
 	notify_queue_locked(queue);
-	k_spin_unlock(&lock, key);
+	k_spin_unlock(&queue->lock, key);
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_work_queue, stop, queue, timeout);
 	if (k_thread_join(queue->thread_id, timeout)) {
-		key = k_spin_lock(&lock);
+		key = k_spin_lock(&queue->lock);
 		flag_clear(&queue->flags, K_WORK_QUEUE_STOP_BIT);
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&queue->lock, key);
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, stop, queue, timeout, -ETIMEDOUT);
 		return -ETIMEDOUT;
 	}
@@ -963,7 +1031,7 @@ static void work_timeout(struct _timeout *to)
 	struct k_work_delayable *dw
 		= CONTAINER_OF(to, struct k_work_delayable, timeout);
 	struct k_work *wp = &dw->work;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(wp);
 	struct k_work_q *queue = NULL;
 
 	/* If the work is still marked delayed (should be) then clear that
@@ -978,7 +1046,7 @@ static void work_timeout(struct _timeout *to)
 		(void)submit_to_queue_locked(wp, &queue);
 	}
 
-	k_spin_unlock(&lock, key);
+	work_unlock(wp, key);
 }
 
 void k_work_init_delayable(struct k_work_delayable *dwork,
@@ -1007,10 +1075,10 @@ int k_work_delayable_busy_get(const struct k_work_delayable *dwork)
 {
 	__ASSERT_NO_MSG(dwork != NULL);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(&dwork->work);
 	int ret = work_delayable_busy_get_locked(dwork);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&dwork->work, key);
 	return ret;
 }
 
@@ -1114,14 +1182,14 @@ int k_work_schedule_for_queue(struct k_work_q *queue, struct k_work_delayable *d
 
 	struct k_work *work = &dwork->work;
 	int ret = 0;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(&dwork->work);
 
 	/* Schedule the work item if it's idle or running. */
 	if ((work_busy_get_locked(work) & ~K_WORK_RUNNING) == 0U) {
 		ret = schedule_for_queue_locked(&queue, dwork, delay);
 	}
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&dwork->work, key);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, schedule_for_queue, queue, dwork, delay, ret);
 
@@ -1148,7 +1216,7 @@ int k_work_reschedule_for_queue(struct k_work_q *queue, struct k_work_delayable
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, reschedule_for_queue, queue, dwork, delay);
 
 	int ret;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(&dwork->work);
 
 	/* Remove any active scheduling. */
 	(void)unschedule_locked(dwork);
@@ -1156,7 +1224,7 @@ int k_work_reschedule_for_queue(struct k_work_q *queue, struct k_work_delayable
 	/* Schedule the work item with the new parameters. */
 	ret = schedule_for_queue_locked(&queue, dwork, delay);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&dwork->work, key);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, reschedule_for_queue, queue, dwork, delay, ret);
 
@@ -1180,10 +1248,10 @@ int k_work_cancel_delayable(struct k_work_delayable *dwork)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, cancel_delayable, dwork);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(&dwork->work);
 	int ret = cancel_delayable_async_locked(dwork);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&dwork->work, key);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, cancel_delayable, dwork, ret);
 
@@ -1203,7 +1271,7 @@ bool k_work_cancel_delayable_sync(struct k_work_delayable *dwork,
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, cancel_delayable_sync, dwork, sync);
 
 	struct z_work_canceller *canceller = &sync->canceller;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(&dwork->work);
 	bool pending = (work_delayable_busy_get_locked(dwork) != 0U);
 	bool need_wait = false;
 
@@ -1212,7 +1280,7 @@ bool k_work_cancel_delayable_sync(struct k_work_delayable *dwork,
 		need_wait = cancel_sync_locked(&dwork->work, canceller);
 	}
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&dwork->work, key);
 
 	if (need_wait) {
 		k_sem_take(&canceller->sem, K_FOREVER);
@@ -1236,11 +1304,11 @@ bool k_work_flush_delayable(struct k_work_delayable *dwork,
 
 	struct k_work *work = &dwork->work;
 	struct z_work_flusher *flusher = &sync->flusher;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = work_lock(&dwork->work);
 
 	/* If it's idle release the lock and return immediately. */
 	if (work_busy_get_locked(work) == 0U) {
-		k_spin_unlock(&lock, key);
+		work_unlock(&dwork->work, key);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, flush_delayable, dwork, sync, false);
 
@@ -1259,7 +1327,7 @@ bool k_work_flush_delayable(struct k_work_delayable *dwork,
 	/* Wait for it to finish */
 	bool need_flush = work_flush_locked(work, flusher);
 
-	k_spin_unlock(&lock, key);
+	work_unlock(&dwork->work, key);
 
 	/* If necessary wait until the flusher item completes */
 	if (need_flush) {
@@ -0,0 +1,72 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_CRC_CRC32_PRIV_H_
+#define ZEPHYR_LIB_CRC_CRC32_PRIV_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/byteorder.h>
+
+/* Number of 256-entry tables used by the reflected CRC-32 implementations,
+ * 0 when the 16-entry table is used.
+ */
+#if defined(CONFIG_CRC32_SLICE_BY_8)
+#define CRC32_SLICES 8
+#elif defined(CONFIG_CRC32_SLICE_BY_4)
+#define CRC32_SLICES 4
+#elif defined(CONFIG_CRC32_TABLE_256)
+#define CRC32_SLICES 1
+#else
+#define CRC32_SLICES 0
+#endif
+
+/* CRC-32 instructions available for the target CPU */
+#if defined(CONFIG_CRC32_HW) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CRC32_HW_IEEE 1
+#define CRC32_HW_C 1
+#elif defined(CONFIG_CRC32_HW) && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define CRC32_HW_C 1
+#endif
+
+#if CRC32_SLICES > 0
+/*
+ * Update a reflected CRC-32 using 256-entry tables, table[k] giving the CRC of
+ * a byte followed by k zero bytes. Slicing processes 4 or 8 bytes per
+ * iteration. crc is neither inverted on input nor on output.
+ */
+static inline uint32_t crc32_table_update(const uint32_t (*table)[256], uint32_t crc,
+					  const uint8_t *data, size_t len)
+{
+#if CRC32_SLICES == 8
+	for (; len >= 8; data += 8, len -= 8) {
+		uint32_t high = sys_get_le32(data + 4);
+
+		crc ^= sys_get_le32(data);
+		crc = table[7][crc & 0xff] ^ table[6][(crc >> 8) & 0xff] ^
+		      table[5][(crc >> 16) & 0xff] ^ table[4][crc >> 24] ^
+		      table[3][high & 0xff] ^ table[2][(high >> 8) & 0xff] ^
+		      table[1][(high >> 16) & 0xff] ^ table[0][high >> 24];
+	}
+#elif CRC32_SLICES == 4
+	for (; len >= 4; data += 4, len -= 4) {
+		crc ^= sys_get_le32(data);
+		crc = table[3][crc & 0xff] ^ table[2][(crc >> 8) & 0xff] ^
+		      table[1][(crc >> 16) & 0xff] ^ table[0][crc >> 24];
+	}
+#endif
+
+	for (size_t i = 0; i < len; i++) {
+		crc = (crc >> 8) ^ table[0][(crc ^ data[i]) & 0xff];
+	}
+
+	return crc;
+}
+#endif /* CRC32_SLICES > 0 */
+
+#endif /* ZEPHYR_LIB_CRC_CRC32_PRIV_H_ */
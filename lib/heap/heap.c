@@ -165,6 +165,7 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 	if (mem == NULL) {
 		return; /* ISO C free() semantics */
 	}
+	uint32_t start = heap_profile_start();
 	struct z_heap *h = heap->heap;
 	chunkid_t c = mem_to_chunkid(h, mem);
 
@@ -195,6 +196,8 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 #endif
 
 	free_chunk(h, c);
+
+	heap_profile_free(h, start);
 }
 
 size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
@@ -269,10 +272,12 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 		return NULL;
 	}
 
+	uint32_t start = heap_profile_start();
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes, 0);
 	chunkid_t c = alloc_chunk(h, chunk_sz);
 
 	if (c == 0U) {
+		heap_profile_alloc(h, start, NULL);
 		return NULL;
 	}
 
@@ -295,6 +300,8 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 				   chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+	heap_profile_alloc(h, start, mem);
+
 	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
 	return mem;
 }
@@ -335,6 +342,8 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 		return NULL;
 	}
 
+	uint32_t start = heap_profile_start();
+
 	/*
 	 * Find a free block that is guaranteed to fit.
 	 * We over-allocate to account for alignment and then free
@@ -344,6 +353,7 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	chunkid_t c0 = alloc_chunk(h, padded_sz);
 
 	if (c0 == 0) {
+		heap_profile_alloc(h, start, NULL);
 		return NULL;
 	}
 	uint8_t *mem = chunk_mem(h, c0);
@@ -380,6 +390,8 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 				   chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+	heap_profile_alloc(h, start, mem);
+
 	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
 	return mem;
 }
@@ -586,4 +598,6 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	set_chunk_used(h, heap_sz, true);
 
 	free_list_add(h, chunk0_size);
+
+	heap_profile_init(h);
 }
@@ -65,6 +65,19 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+#ifdef CONFIG_SYS_HEAP_PROFILE_STATS
+#include <zephyr/stats/stats.h>
+
+STATS_SECT_START(sys_heap_profile)
+STATS_SECT_ENTRY32(allocs)
+STATS_SECT_ENTRY32(frees)
+STATS_SECT_ENTRY32(alloc_failures)
+STATS_SECT_ENTRY32(alloc_cycles_max)
+STATS_SECT_ENTRY32(free_cycles_max)
+STATS_SECT_ENTRY32(min_largest_free_bytes)
+STATS_SECT_END;
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -73,6 +86,15 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	uint32_t alloc_cycles[CONFIG_SYS_HEAP_PROFILE_BINS];
+	uint32_t free_cycles[CONFIG_SYS_HEAP_PROFILE_BINS];
+	uint32_t alloc_failures;
+	chunksz_t min_largest_free;
+#endif
+#ifdef CONFIG_SYS_HEAP_PROFILE_STATS
+	STATS_SECT_DECL(sys_heap_profile) stats;
 #endif
 	struct z_heap_bucket buckets[];
 };
@@ -281,4 +303,38 @@ static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 	}
 }
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+static inline uint32_t heap_profile_start(void)
+{
+	return k_cycle_get_32();
+}
+
+void heap_profile_init(struct z_heap *h);
+void heap_profile_alloc(struct z_heap *h, uint32_t start, void *mem);
+void heap_profile_free(struct z_heap *h, uint32_t start);
+#else
+static inline uint32_t heap_profile_start(void)
+{
+	return 0;
+}
+
+static inline void heap_profile_init(struct z_heap *h)
+{
+	ARG_UNUSED(h);
+}
+
+static inline void heap_profile_alloc(struct z_heap *h, uint32_t start, void *mem)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(start);
+	ARG_UNUSED(mem);
+}
+
+static inline void heap_profile_free(struct z_heap *h, uint32_t start)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(start);
+}
+#endif /* CONFIG_SYS_HEAP_PROFILE */
+
 #endif /* ZEPHYR_INCLUDE_LIB_OS_HEAP_H_ */
@@ -0,0 +1,340 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/heap_listener.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/stats.h>
+#include <string.h>
+#include "heap.h"
+/* private kernel APIs */
+#include <kernel_internal.h>
+
+/* The largest free chunks are in the highest non-empty bucket, the
+ * size of which is a lower bound of their size.
+ */
+static chunksz_t largest_free_floor(struct z_heap *h)
+{
+	if (h->avail_buckets == 0U) {
+		return 0;
+	}
+
+	int bi = 31 - __builtin_clz(h->avail_buckets);
+
+	return BIT(bi) + min_chunk_size(h) - 1;
+}
+
+static chunksz_t largest_free(struct z_heap *h)
+{
+	chunksz_t largest = 0;
+
+	if (h->avail_buckets == 0U) {
+		return 0;
+	}
+
+	int bi = 31 - __builtin_clz(h->avail_buckets);
+	chunkid_t first = h->buckets[bi].next;
+	chunkid_t c = first;
+
+	do {
+		largest = MAX(largest, chunk_size(h, c));
+		c = next_free_chunk(h, c);
+	} while (c != first);
+
+	return largest;
+}
+
+static size_t usable_bytes(struct z_heap *h, chunksz_t sz)
+{
+	return (sz == 0U) ? 0 : chunksz_to_bytes(h, sz) - chunk_header_bytes(h);
+}
+
+#ifdef CONFIG_SYS_HEAP_PROFILE_STATS
+STATS_NAME_START(sys_heap_profile)
+STATS_NAME(sys_heap_profile, allocs)
+STATS_NAME(sys_heap_profile, frees)
+STATS_NAME(sys_heap_profile, alloc_failures)
+STATS_NAME(sys_heap_profile, alloc_cycles_max)
+STATS_NAME(sys_heap_profile, free_cycles_max)
+STATS_NAME(sys_heap_profile, min_largest_free_bytes)
+STATS_NAME_END(sys_heap_profile);
+
+static void stats_init_entries(struct z_heap *h)
+{
+	/* The header is left alone, it is linked once the group is registered */
+	(void)memset((uint8_t *)&h->stats + sizeof(struct stats_hdr), 0,
+		     sizeof(h->stats) - sizeof(struct stats_hdr));
+	STATS_SET(h->stats, min_largest_free_bytes, (uint32_t)usable_bytes(h, h->min_largest_free));
+}
+
+static void stats_alloc(struct z_heap *h, uint32_t cycles, void *mem)
+{
+	STATS_SET(h->stats, alloc_cycles_max, MAX(h->stats.alloc_cycles_max, cycles));
+
+	if (mem == NULL) {
+		STATS_INC(h->stats, alloc_failures);
+		return;
+	}
+
+	STATS_INC(h->stats, allocs);
+	STATS_SET(h->stats, min_largest_free_bytes, (uint32_t)usable_bytes(h, h->min_largest_free));
+}
+
+static void stats_free(struct z_heap *h, uint32_t cycles)
+{
+	STATS_INC(h->stats, frees);
+	STATS_SET(h->stats, free_cycles_max, MAX(h->stats.free_cycles_max, cycles));
+}
+
+int sys_heap_profile_stats_register(struct sys_heap *heap, const char *name)
+{
+	if ((heap == NULL) || (name == NULL)) {
+		return -EINVAL;
+	}
+
+	struct z_heap *h = heap->heap;
+	int ret;
+
+	if (stats_group_find(name) != NULL) {
+		return -EALREADY;
+	}
+
+	/* The header is in the heap memory, it is not initialized by sys_heap_init() */
+	(void)memset(&h->stats.s_hdr, 0, sizeof(h->stats.s_hdr));
+	ret = stats_init_and_reg(&h->stats.s_hdr, STATS_SIZE_INIT_PARMS(h->stats, STATS_SIZE_32),
+				 STATS_NAME_INIT_PARMS(sys_heap_profile), name);
+
+	/* Registering clears the entries, restore the lowest largest free block */
+	stats_init_entries(h);
+
+	return ret;
+}
+#else
+static inline void stats_init_entries(struct z_heap *h)
+{
+	ARG_UNUSED(h);
+}
+
+static inline void stats_alloc(struct z_heap *h, uint32_t cycles, void *mem)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(cycles);
+	ARG_UNUSED(mem);
+}
+
+static inline void stats_free(struct z_heap *h, uint32_t cycles)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(cycles);
+}
+#endif /* CONFIG_SYS_HEAP_PROFILE_STATS */
+
+void heap_profile_init(struct z_heap *h)
+{
+	(void)memset(h->alloc_cycles, 0, sizeof(h->alloc_cycles));
+	(void)memset(h->free_cycles, 0, sizeof(h->free_cycles));
+	h->alloc_failures = 0;
+	h->min_largest_free = largest_free_floor(h);
+	stats_init_entries(h);
+}
+
+void heap_profile_alloc(struct z_heap *h, uint32_t start, void *mem)
+{
+	uint32_t cycles = k_cycle_get_32() - start;
+
+	z_cycle_hist_record(h->alloc_cycles, CONFIG_SYS_HEAP_PROFILE_BINS, cycles);
+
+	if (mem == NULL) {
+		h->alloc_failures++;
+	} else {
+		h->min_largest_free = MIN(h->min_largest_free, largest_free_floor(h));
+	}
+
+	stats_alloc(h, cycles, mem);
+}
+
+void heap_profile_free(struct z_heap *h, uint32_t start)
+{
+	uint32_t cycles = k_cycle_get_32() - start;
+
+	z_cycle_hist_record(h->free_cycles, CONFIG_SYS_HEAP_PROFILE_BINS, cycles);
+	stats_free(h, cycles);
+}
+
+int sys_heap_profile_get(struct sys_heap *heap, struct sys_heap_profile *profile)
+{
+	if ((heap == NULL) || (profile == NULL)) {
+		return -EINVAL;
+	}
+
+	struct z_heap *h = heap->heap;
+
+	(void)memcpy(profile->alloc_cycles, h->alloc_cycles, sizeof(profile->alloc_cycles));
+	(void)memcpy(profile->free_cycles, h->free_cycles, sizeof(profile->free_cycles));
+	profile->alloc_failures = h->alloc_failures;
+	profile->largest_free_bytes = usable_bytes(h, largest_free(h));
+	profile->min_largest_free_bytes = usable_bytes(h, h->min_largest_free);
+
+	return 0;
+}
+
+int sys_heap_profile_reset(struct sys_heap *heap)
+{
+	if (heap == NULL) {
+		return -EINVAL;
+	}
+
+	heap_profile_init(heap->heap);
+
+	return 0;
+}
+
+#ifdef CONFIG_SYS_HEAP_PROFILE_SITES
+
+/* The last entry accounts for interrupts and the threads not tracked */
+#define NUM_SITES (CONFIG_SYS_HEAP_PROFILE_SITES_NUM + 1)
+
+static struct k_spinlock sites_lock;
+static struct sys_heap_profile_site sites[NUM_SITES];
+static bool sites_started;
+
+static struct sys_heap_profile_site *site_get(void)
+{
+	const struct k_thread *thread = k_is_in_isr() ? NULL : k_current_get();
+	struct sys_heap_profile_site *free_site = NULL;
+
+	if (thread == NULL) {
+		return &sites[NUM_SITES - 1];
+	}
+
+	/* Slots are released by exiting threads, so free ones may precede the one in use */
+	for (int i = 0; i < NUM_SITES - 1; i++) {
+		if (sites[i].thread == thread) {
+			return &sites[i];
+		}
+		if ((sites[i].thread == NULL) && (free_site == NULL)) {
+			free_site = &sites[i];
+		}
+	}
+
+	if (free_site == NULL) {
+		return &sites[NUM_SITES - 1];
+	}
+
+	free_site->thread = thread;
+
+	return free_site;
+}
+
+void z_heap_profile_thread_exit(struct k_thread *thread)
+{
+	struct sys_heap_profile_site *other = &sites[NUM_SITES - 1];
+
+	K_SPINLOCK(&sites_lock) {
+		for (int i = 0; i < NUM_SITES - 1; i++) {
+			if (sites[i].thread != thread) {
+				continue;
+			}
+
+			/* Keep the usage of the thread in the totals */
+			other->alloc_count += sites[i].alloc_count;
+			other->free_count += sites[i].free_count;
+			other->alloc_bytes += sites[i].alloc_bytes;
+			other->free_bytes += sites[i].free_bytes;
+			(void)memset(&sites[i], 0, sizeof(sites[i]));
+			break;
+		}
+	}
+}
+
+static void site_alloc_cb(uintptr_t heap_id, void *mem, size_t bytes)
+{
+	ARG_UNUSED(heap_id);
+	ARG_UNUSED(mem);
+
+	K_SPINLOCK(&sites_lock) {
+		struct sys_heap_profile_site *site = site_get();
+
+		site->alloc_count++;
+		site->alloc_bytes += bytes;
+	}
+}
+
+static void site_free_cb(uintptr_t heap_id, void *mem, size_t bytes)
+{
+	ARG_UNUSED(heap_id);
+	ARG_UNUSED(mem);
+
+	K_SPINLOCK(&sites_lock) {
+		struct sys_heap_profile_site *site = site_get();
+
+		site->free_count++;
+		site->free_bytes += bytes;
+	}
+}
+
+static HEAP_LISTENER_ALLOC_DEFINE(sites_alloc_listener, 0, site_alloc_cb);
+static HEAP_LISTENER_FREE_DEFINE(sites_free_listener, 0, site_free_cb);
+
+int sys_heap_profile_sites_start(struct sys_heap *heap)
+{
+	int ret = 0;
+
+	if (heap == NULL) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&sites_lock) {
+		if (sites_started) {
+			ret = -EBUSY;
+			K_SPINLOCK_BREAK;
+		}
+
+		(void)memset(sites, 0, sizeof(sites));
+		sites_alloc_listener.heap_id = HEAP_ID_FROM_POINTER(heap);
+		sites_free_listener.heap_id = HEAP_ID_FROM_POINTER(heap);
+		sites_started = true;
+	}
+
+	if (ret == 0) {
+		heap_listener_register(&sites_alloc_listener);
+		heap_listener_register(&sites_free_listener);
+	}
+
+	return ret;
+}
+
+void sys_heap_profile_sites_stop(void)
+{
+	bool started;
+
+	K_SPINLOCK(&sites_lock) {
+		started = sites_started;
+		sites_started = false;
+	}
+
+	if (started) {
+		heap_listener_unregister(&sites_alloc_listener);
+		heap_listener_unregister(&sites_free_listener);
+	}
+}
+
+size_t sys_heap_profile_sites_get(struct sys_heap_profile_site *out, size_t max)
+{
+	size_t n = 0;
+
+	K_SPINLOCK(&sites_lock) {
+		for (int i = 0; (i < NUM_SITES) && (n < max); i++) {
+			if ((sites[i].alloc_count != 0U) || (sites[i].free_count != 0U)) {
+				out[n++] = sites[i];
+			}
+		}
+	}
+
+	return n;
+}
+
+#endif /* CONFIG_SYS_HEAP_PROFILE_SITES */
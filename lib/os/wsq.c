@@ -0,0 +1,407 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/wsq.h>
+#include <zephyr/kernel.h>
+/* private kernel APIs */
+#include <kernel_internal.h>
+#include <ksched.h>
+#include <wait_q.h>
+
+/* Number of ranges per worker a parallel-for loop is split into when
+ * the caller doesn't select the grain, so that workers finishing early
+ * can take over ranges from the others.
+ */
+#define FOR_RANGES_PER_WORKER 4
+
+struct wsq_for_job {
+	k_wsq_for_fn_t fn;
+	void *user_data;
+	size_t count;
+	size_t grain;
+
+	/* Start of the next range to process */
+	atomic_t next;
+
+	/* Given by workers when a helper item completes */
+	struct k_sem done;
+};
+
+struct wsq_for_helper {
+	struct k_work work;
+	struct wsq_for_job *job;
+};
+
+/* The state of a work item is protected by the kernel work lock of the
+ * item, so flag updates are serialized with k_work_busy_get() and the
+ * other kernel work APIs.  It is taken before the lock of a worker.
+ */
+static inline struct k_spinlock *item_lock(const struct k_work *work)
+{
+	return z_work_lock_get(work);
+}
+
+static inline bool item_test(const struct k_work *work, uint32_t bit)
+{
+	return (work->flags & BIT(bit)) != 0U;
+}
+
+static struct k_wsq_worker *current_worker(struct k_wsq *wsq)
+{
+	if (k_is_in_isr()) {
+		return NULL;
+	}
+
+	for (uint32_t i = 0; i < wsq->num_workers; i++) {
+		if (&wsq->workers[i].thread == _current) {
+			return &wsq->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Add a work item to the local queue of a worker.
+ *
+ * Invoked with the lock of the work item held.
+ */
+static void push_locked(struct k_wsq_worker *worker, struct k_work *work)
+{
+	K_SPINLOCK(&worker->lock) {
+		sys_slist_append(&worker->pending, &work->node);
+	}
+
+	work->flags |= BIT(K_WORK_QUEUED_BIT);
+	(void)atomic_inc(&worker->wsq->pending);
+}
+
+/* Wake an idle worker, if any, after new work was queued.
+ *
+ * A worker going idle increments the idle count before checking for
+ * pending work, while submitters increment the pending count before
+ * checking for idle workers, so one of them always sees the other.
+ *
+ * @return true if a worker was woken
+ */
+static bool notify(struct k_wsq *wsq)
+{
+	bool woken = false;
+
+	if (atomic_get(&wsq->idle) > 0) {
+		K_SPINLOCK(&wsq->lock) {
+			woken = z_sched_wake(&wsq->idleq, 0, NULL);
+			if (woken) {
+				(void)atomic_dec(&wsq->idle);
+			}
+		}
+	}
+
+	return woken;
+}
+
+/* Take the first work item from the local queue of a worker and mark
+ * it running.
+ *
+ * The lock of the item must be taken before the lock of the worker, so
+ * the head of the queue is peeked at first and only taken if it's still
+ * there once both locks are held.  Until then only the address of the
+ * item is used.
+ */
+static struct k_work *take(struct k_wsq_worker *from)
+{
+	struct k_spinlock *wlock;
+	struct k_work *work;
+	sys_snode_t *node;
+	k_spinlock_key_t wkey;
+	k_spinlock_key_t key;
+
+	while (true) {
+		key = k_spin_lock(&from->lock);
+		node = sys_slist_peek_head(&from->pending);
+		k_spin_unlock(&from->lock, key);
+
+		if (node == NULL) {
+			return NULL;
+		}
+
+		work = CONTAINER_OF(node, struct k_work, node);
+		wlock = item_lock(work);
+		wkey = k_spin_lock(wlock);
+
+		key = k_spin_lock(&from->lock);
+		if (sys_slist_peek_head(&from->pending) == node) {
+			(void)sys_slist_get(&from->pending);
+			k_spin_unlock(&from->lock, key);
+			break;
+		}
+
+		k_spin_unlock(&from->lock, key);
+		k_spin_unlock(wlock, wkey);
+	}
+
+	work->flags &= ~BIT(K_WORK_QUEUED_BIT);
+	work->flags |= BIT(K_WORK_RUNNING_BIT);
+	k_spin_unlock(wlock, wkey);
+
+	(void)atomic_dec(&from->wsq->pending);
+
+	return work;
+}
+
+/* Take a work item from the local queue of another worker, visiting
+ * them in turn starting with the next one.
+ */
+static struct k_work *steal(struct k_wsq *wsq, struct k_wsq_worker *self)
+{
+	uint32_t n = wsq->num_workers;
+	uint32_t idx = (uint32_t)(self - wsq->workers);
+	struct k_work *work = NULL;
+
+	for (uint32_t i = 1; (i < n) && (work == NULL); i++) {
+		if (atomic_get(&wsq->pending) == 0) {
+			break;
+		}
+
+		work = take(&wsq->workers[(idx + i) % n]);
+	}
+
+	return work;
+}
+
+/* Remove a work item from whichever local queue holds it.
+ *
+ * @return true if the item was queued and has been removed
+ */
+static bool dequeue(struct k_wsq *wsq, struct k_work *work)
+{
+	k_spinlock_key_t wkey = k_spin_lock(item_lock(work));
+	bool ret = false;
+
+	if (item_test(work, K_WORK_QUEUED_BIT) &&
+	    !item_test(work, K_WORK_RUNNING_BIT)) {
+		for (uint32_t i = 0; (i < wsq->num_workers) && !ret; i++) {
+			K_SPINLOCK(&wsq->workers[i].lock) {
+				ret = sys_slist_find_and_remove(&wsq->workers[i].pending,
+								&work->node);
+			}
+		}
+
+		__ASSERT_NO_MSG(ret);
+
+		work->flags &= ~BIT(K_WORK_QUEUED_BIT);
+		(void)atomic_dec(&wsq->pending);
+	}
+
+	k_spin_unlock(item_lock(work), wkey);
+
+	return ret;
+}
+
+static void for_run(struct wsq_for_job *job)
+{
+	while (true) {
+		size_t start = (size_t)atomic_add(&job->next, (atomic_val_t)job->grain);
+
+		if (start >= job->count) {
+			break;
+		}
+
+		job->fn(start, MIN(start + job->grain, job->count), job->user_data);
+	}
+}
+
+static void for_handler(struct k_work *work)
+{
+	struct wsq_for_helper *helper = CONTAINER_OF(work, struct wsq_for_helper, work);
+
+	for_run(helper->job);
+}
+
+static void run(struct k_wsq_worker *self, struct k_work *work)
+{
+	k_work_handler_t handler = work->handler;
+	k_spinlock_key_t wkey;
+	bool requeued;
+
+	handler(work);
+
+	/* An item submitted while running is queued locally now, the
+	 * handler must not run on two CPUs at the same time.
+	 */
+	wkey = k_spin_lock(item_lock(work));
+	work->flags &= ~BIT(K_WORK_RUNNING_BIT);
+	requeued = item_test(work, K_WORK_QUEUED_BIT);
+	if (requeued) {
+		work->flags &= ~BIT(K_WORK_QUEUED_BIT);
+		push_locked(self, work);
+	}
+	k_spin_unlock(item_lock(work), wkey);
+
+	/* Parallel-for helpers live on the stack of the caller, which may
+	 * return as soon as this is given: don't touch the item afterwards.
+	 */
+	if (!requeued && (handler == for_handler)) {
+		struct wsq_for_helper *helper = CONTAINER_OF(work, struct wsq_for_helper, work);
+
+		k_sem_give(&helper->job->done);
+	}
+}
+
+static FUNC_NORETURN void wsq_loop(void *p0, void *p1, void *p2)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	struct k_wsq_worker *self = p0;
+	struct k_wsq *wsq = self->wsq;
+
+	while (true) {
+		struct k_work *work = take(self);
+
+		if (work == NULL) {
+			work = steal(wsq, self);
+		}
+
+		if (work != NULL) {
+			run(self, work);
+			continue;
+		}
+
+		k_spinlock_key_t key = k_spin_lock(&wsq->lock);
+
+		(void)atomic_inc(&wsq->idle);
+		if (atomic_get(&wsq->pending) != 0) {
+			(void)atomic_dec(&wsq->idle);
+			k_spin_unlock(&wsq->lock, key);
+			continue;
+		}
+
+		/* The idle count is decremented by the waker */
+		(void)z_sched_wait(&wsq->lock, key, &wsq->idleq, K_FOREVER, NULL);
+	}
+}
+
+void k_wsq_start(struct k_wsq *wsq, int prio)
+{
+	uintptr_t ssz = K_THREAD_STACK_LEN(wsq->stack_size);
+
+	__ASSERT_NO_MSG(wsq->num_workers == 0U);
+
+	z_waitq_init(&wsq->idleq);
+	atomic_set(&wsq->pending, 0);
+	atomic_set(&wsq->idle, 0);
+	atomic_set(&wsq->next, 0);
+
+	for (uint32_t i = 0; i < arch_num_cpus(); i++) {
+		struct k_wsq_worker *worker = &wsq->workers[i];
+
+		sys_slist_init(&worker->pending);
+		worker->wsq = wsq;
+
+		k_thread_create(&worker->thread, &wsq->stacks[ssz * i],
+				wsq->stack_size, wsq_loop, worker, NULL, NULL,
+				prio, 0, K_FOREVER);
+	}
+
+	wsq->num_workers = arch_num_cpus();
+
+	for (uint32_t i = 0; i < wsq->num_workers; i++) {
+#ifdef CONFIG_SCHED_CPU_MASK
+		(void)k_thread_cpu_pin(&wsq->workers[i].thread, i);
+#endif
+		k_thread_start(&wsq->workers[i].thread);
+	}
+}
+
+int k_wsq_submit(struct k_wsq *wsq, struct k_work *work)
+{
+	__ASSERT_NO_MSG(work != NULL);
+	__ASSERT_NO_MSG(work->handler != NULL);
+
+	if (wsq->num_workers == 0U) {
+		return -ENODEV;
+	}
+
+	struct k_wsq_worker *worker = current_worker(wsq);
+	k_spinlock_key_t wkey = k_spin_lock(item_lock(work));
+	int ret;
+
+	if (item_test(work, K_WORK_QUEUED_BIT)) {
+		ret = 0;
+	} else if (item_test(work, K_WORK_RUNNING_BIT)) {
+		/* Queued by the worker running it once it completes */
+		work->flags |= BIT(K_WORK_QUEUED_BIT);
+		ret = 2;
+	} else {
+		if (worker == NULL) {
+			uint32_t idx = (uint32_t)atomic_inc(&wsq->next);
+
+			worker = &wsq->workers[idx % wsq->num_workers];
+		}
+
+		push_locked(worker, work);
+		ret = 1;
+	}
+
+	k_spin_unlock(item_lock(work), wkey);
+
+	if ((ret == 1) && notify(wsq)) {
+		z_reschedule_unlocked();
+	}
+
+	return ret;
+}
+
+void k_wsq_parallel_for(struct k_wsq *wsq, size_t count, size_t grain,
+			k_wsq_for_fn_t fn, void *user_data)
+{
+	struct wsq_for_helper helpers[CONFIG_MP_MAX_NUM_CPUS];
+	struct wsq_for_job job;
+	uint32_t num_helpers;
+	uint32_t waits = 0U;
+
+	__ASSERT_NO_MSG(fn != NULL);
+	__ASSERT_NO_MSG(!k_is_in_isr());
+
+	if (count == 0U) {
+		return;
+	}
+
+	if (grain == 0U) {
+		grain = MAX(count / (MAX(wsq->num_workers, 1U) * FOR_RANGES_PER_WORKER), 1U);
+	}
+
+	job.fn = fn;
+	job.user_data = user_data;
+	job.count = count;
+	job.grain = grain;
+	atomic_set(&job.next, 0);
+	k_sem_init(&job.done, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+	/* The calling thread processes ranges too, helpers are needed for
+	 * the other ones only.
+	 */
+	num_helpers = (uint32_t)MIN((size_t)wsq->num_workers, DIV_ROUND_UP(count, grain) - 1U);
+
+	for (uint32_t i = 0; i < num_helpers; i++) {
+		k_work_init(&helpers[i].work, for_handler);
+		helpers[i].job = &job;
+		(void)k_wsq_submit(wsq, &helpers[i].work);
+	}
+
+	for_run(&job);
+
+	/* All the ranges have been taken: helpers that didn't start have
+	 * nothing left to do, the others have to complete their range.
+	 */
+	for (uint32_t i = 0; i < num_helpers; i++) {
+		if (!dequeue(wsq, &helpers[i].work)) {
+			waits++;
+		}
+	}
+
+	while (waits-- > 0U) {
+		(void)k_sem_take(&job.done, K_FOREVER);
+	}
+}
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Log Parser for Dictionary-based Logging stored in flash
+
+This extracts the log data stored by the flash logging backend from
+a dump of its partition, and uses the JSON database file to decode it
+and print the log messages, from the oldest to the newest.
+"""
+
+import argparse
+import logging
+import struct
+import sys
+
+import parserlib
+
+LOGGER_FORMAT = "%(message)s"
+logger = logging.getLogger("parser")
+
+SECTOR_MAGIC = 0x474F4C5A
+SECTOR_VERSION = 1
+
+# magic, version, reserved, align, seq, erase_count
+SECTOR_HDR = struct.Struct("<IBBHII")
+# len, len_inv
+RECORD_HDR = struct.Struct("<HH")
+
+
+def parse_args():
+    """Parse command line arguments"""
+    argparser = argparse.ArgumentParser(allow_abbrev=False)
+
+    argparser.add_argument("dbfile", help="Dictionary Logging Database file")
+    argparser.add_argument("partfile", help="Binary dump of the log partition")
+    argparser.add_argument("--sector-size", type=lambda x: int(x, 0), default=4096,
+                           help="Flash erase sector size of the partition (default: 4096)")
+    argparser.add_argument("--debug", action="store_true",
+                           help="Print extra debugging information")
+
+    return argparser.parse_args()
+
+
+def round_up(value, align):
+    """Round value up to a multiple of align"""
+    return (value + align - 1) // align * align
+
+
+def read_sector(sector, idx):
+    """
+    Return the sequence number and the log data of a sector,
+    or None if the sector was not started
+    """
+    magic, version, _, align, seq, erase_count = SECTOR_HDR.unpack_from(sector)
+    if magic != SECTOR_MAGIC or version != SECTOR_VERSION or align == 0:
+        return None
+
+    logger.debug("# Sector %d: sequence %d, erased %d times", idx, seq, erase_count)
+
+    data = b''
+    off = round_up(SECTOR_HDR.size, align)
+
+    while off + RECORD_HDR.size <= len(sector):
+        length, length_inv = RECORD_HDR.unpack_from(sector, off)
+        size = round_up(RECORD_HDR.size + length, align)
+
+        # End of the sector, or record partially written
+        if length != (~length_inv & 0xFFFF) or off + size > len(sector):
+            break
+
+        data += sector[off + RECORD_HDR.size:off + RECORD_HDR.size + length]
+        off += size
+
+    return (seq, data)
+
+
+def read_partition(args):
+    """
+    Read the log data of the partition, from the oldest to the newest
+    """
+    with open(args.partfile, "rb") as partfile:
+        partdata = partfile.read()
+
+    if len(partdata) % args.sector_size != 0:
+        logger.error("ERROR: Partition size is not a multiple of the sector size, exiting...")
+        sys.exit(1)
+
+    sectors = []
+    for idx in range(len(partdata) // args.sector_size):
+        start = idx * args.sector_size
+        sector = read_sector(partdata[start:start + args.sector_size], idx)
+        if sector is not None:
+            sectors.append(sector)
+
+    return b''.join(data for _, data in sorted(sectors, key=lambda s: s[0]))
+
+
+def main():
+    """Main function of log parser"""
+    args = parse_args()
+
+    # Setup logging for parser
+    logging.basicConfig(format=LOGGER_FORMAT)
+    if args.debug:
+        logger.setLevel(logging.DEBUG)
+    else:
+        logger.setLevel(logging.INFO)
+
+    log_parser = parserlib.get_log_parser(args.dbfile, logger)
+
+    logdata = read_partition(args)
+
+    parsed_data_offset = parserlib.parser(logdata, log_parser, logger)
+    if parsed_data_offset != len(logdata):
+        logger.error(
+            'ERROR: Not all data was parsed, %d bytes left unparsed',
+            len(logdata) - parsed_data_offset,
+        )
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -12,8 +12,11 @@ This translate stack samples captured by perf subsystem into format
 used by flamegraph.pl. Translation uses .elf file to get function names
 from addresses
 
+The input is either the output of "perf printbuf" or of "perf printfolded",
+in which case the addresses of the folded stacks are translated.
+
 Usage:
-    ./script/perf/stackcollapse.py <file with perf printbuf output> <ELF file>
+    ./script/perf/stackcollapse.py <file with perf printbuf or printfolded output> <ELF file>
 """
 
 import re
@@ -35,6 +38,27 @@ def addr_to_sym(addr, elf):
     return "[unknown]"
 
 
+def merge(funcs):
+    """Join root first function names, merging dublicate functions"""
+    prev_func = next(funcs)
+    line = prev_func
+    for func in funcs:
+        if prev_func != func:
+            prev_func = func
+            line += ";" + func
+    return line
+
+
+def collapse_folded(lines, elf):
+    for line in lines:
+        if not line.strip():
+            continue
+        stack, count = line.rsplit(" ", 1)
+        funcs = (addr_to_sym(int(f, 16), elf) if f.startswith("0x") else f
+                 for f in stack.split(";"))
+        print(merge(funcs), count)
+
+
 def collapse(buf, elf):
     while buf:
         count, = struct.unpack_from(">Q", buf)
@@ -42,15 +66,8 @@ def collapse(buf, elf):
         addrs = struct.unpack_from(f">{count}Q", buf, 8)
 
         func_trace = reversed(list(map(lambda a: addr_to_sym(a, elf), addrs)))
-        prev_func = next(func_trace)
-        line = prev_func
-        # merge dublicate functions
-        for func in func_trace:
-            if prev_func != func:
-                prev_func = func
-                line += ";" + func
-
-        print(line, 1)
+
+        print(merge(func_trace), 1)
         buf = buf[8 + 8 * count:]
 
 
@@ -60,6 +77,10 @@ if __name__ == "__main__":
         inp = f.read()
 
     lines = inp.splitlines()
+    if not re.match(r"Perf buf length", lines[0]):
+        collapse_folded(lines, elf)
+        sys.exit(0)
+
     assert int(re.match(r"Perf buf length (\d+)", lines[0]).group(1)) == len(lines) - 1
     buf = binascii.unhexlify("".join(lines[1:]))
     collapse(buf, elf)
@@ -0,0 +1,98 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_rtio.h>
+#include <zephyr/rtio/work.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(fs, CONFIG_FS_LOG_LEVEL);
+
+static int fs_rtio_rx(struct fs_rtio *data, struct rtio_iodev_sqe *iodev_sqe)
+{
+	uint8_t *buf;
+	uint32_t buf_len;
+	int rc;
+
+	rc = rtio_sqe_rx_buf(iodev_sqe, 1, CONFIG_FILE_SYSTEM_RTIO_POOL_RX_SIZE, &buf, &buf_len);
+	if (rc < 0) {
+		return rc;
+	}
+
+	return (int)fs_read(data->file, buf, buf_len);
+}
+
+static int fs_rtio_tx(struct fs_rtio *data, const struct rtio_sqe *sqe)
+{
+	if (sqe->op == RTIO_OP_TINY_TX) {
+		return (int)fs_write(data->file, sqe->tiny_tx.buf, sqe->tiny_tx.buf_len);
+	}
+
+	return (int)fs_write(data->file, sqe->tx.buf, sqe->tx.buf_len);
+}
+
+static void fs_rtio_work(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	struct fs_rtio *data = sqe->iodev->data;
+	int rc;
+
+	if ((sqe->flags & RTIO_SQE_CANCELED) != 0U) {
+		rtio_iodev_sqe_err(iodev_sqe, -ECANCELED);
+		return;
+	}
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+
+	if (sqe->op == RTIO_OP_RX) {
+		rc = fs_rtio_rx(data, iodev_sqe);
+	} else {
+		rc = fs_rtio_tx(data, sqe);
+	}
+
+	k_mutex_unlock(&data->lock);
+
+	if (rc < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, rc);
+	} else if ((rc == 0) && ((sqe->flags & RTIO_SQE_MULTISHOT) != 0U)) {
+		/* A multishot read would read the end of the file forever:
+		 * end it as an error does.
+		 */
+		rtio_iodev_sqe_err(iodev_sqe, 0);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, rc);
+	}
+}
+
+static void fs_rtio_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_work_req *req;
+
+	switch (iodev_sqe->sqe.op) {
+	case RTIO_OP_RX:
+	case RTIO_OP_TX:
+	case RTIO_OP_TINY_TX:
+		break;
+	default:
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+		return;
+	}
+
+	req = rtio_work_req_alloc();
+	if (req == NULL) {
+		LOG_ERR("RTIO work item allocation failed. Consider to increase "
+			"CONFIG_RTIO_WORKQ_POOL_ITEMS.");
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, fs_rtio_work);
+}
+
+const struct rtio_iodev_api fs_rtio_api = {
+	.submit = fs_rtio_submit,
+};
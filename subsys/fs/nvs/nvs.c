@@ -95,6 +95,12 @@ static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
 	}
 	return (len + (write_block_size - 1U)) & ~(write_block_size - 1U);
 }
+
+/* nvs_sector_count returns the number of sectors used to store data */
+static inline uint16_t nvs_sector_count(struct nvs_fs *fs)
+{
+	return fs->sector_count - NVS_INDEX_SECTORS;
+}
 /* end basic routines */
 
 /* flash routines */
@@ -534,7 +540,7 @@ static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate)
 
 	/* last ate in sector, do jump to previous sector */
 	if (((*addr) >> ADDR_SECT_SHIFT) == 0U) {
-		*addr += ((fs->sector_count - 1) << ADDR_SECT_SHIFT);
+		*addr += ((nvs_sector_count(fs) - 1) << ADDR_SECT_SHIFT);
 	} else {
 		*addr -= (1 << ADDR_SECT_SHIFT);
 	}
@@ -572,8 +578,8 @@ static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate)
 static void nvs_sector_advance(struct nvs_fs *fs, uint32_t *addr)
 {
 	*addr += (1 << ADDR_SECT_SHIFT);
-	if ((*addr >> ADDR_SECT_SHIFT) == fs->sector_count) {
-		*addr -= (fs->sector_count << ADDR_SECT_SHIFT);
+	if ((*addr >> ADDR_SECT_SHIFT) == nvs_sector_count(fs)) {
+		*addr -= (nvs_sector_count(fs) << ADDR_SECT_SHIFT);
 	}
 }
 
@@ -745,6 +751,216 @@ gc_done:
 	return rc;
 }
 
+#ifdef CONFIG_NVS_INDEX
+/* index routines */
+/* the index sector holds checkpoints of the lookup cache. Checkpoints are
+ * appended to the sector, the sector is erased when it is full.
+ */
+static inline size_t nvs_index_rec_size(struct nvs_fs *fs)
+{
+	return sizeof(struct nvs_index_hdr) + nvs_al_size(fs, sizeof(fs->lookup_cache));
+}
+
+static inline uint16_t nvs_index_slots(struct nvs_fs *fs)
+{
+	return fs->sector_size / nvs_index_rec_size(fs);
+}
+
+/* the index is only used when the sector holds enough checkpoints, so that
+ * it is not erased at almost every gc.
+ */
+static inline bool nvs_index_usable(struct nvs_fs *fs)
+{
+	return nvs_index_slots(fs) >= CONFIG_NVS_INDEX_CHECKPOINTS_MIN;
+}
+
+static inline uint32_t nvs_index_addr(struct nvs_fs *fs, uint16_t slot)
+{
+	return ((uint32_t)nvs_sector_count(fs) << ADDR_SECT_SHIFT) +
+	       slot * nvs_index_rec_size(fs);
+}
+
+static uint32_t nvs_index_crc32(const struct nvs_index_hdr *hdr, const uint32_t *cache)
+{
+	uint32_t crc;
+
+	crc = crc32_ieee((const uint8_t *)hdr, offsetof(struct nvs_index_hdr, crc32));
+
+	return crc32_ieee_update(crc, (const uint8_t *)cache,
+				 CONFIG_NVS_LOOKUP_CACHE_SIZE * sizeof(uint32_t));
+}
+
+/* write a checkpoint of the lookup cache. Called when gc has finished, the
+ * index only speeds up mount so a failure is not reported to the caller.
+ */
+static int nvs_index_write(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_index_hdr hdr;
+	uint32_t addr;
+	size_t ate_size;
+
+	if (!nvs_index_usable(fs)) {
+		return 0;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	if (fs->index_slot >= nvs_index_slots(fs)) {
+		rc = nvs_flash_erase_sector(fs, nvs_index_addr(fs, 0));
+		if (rc) {
+			goto end;
+		}
+		fs->index_slot = 0U;
+	}
+
+	(void)memset(&hdr, 0, sizeof(hdr));
+	hdr.magic = NVS_INDEX_MAGIC;
+	hdr.ate_wra = fs->ate_wra;
+	hdr.data_wra = fs->data_wra;
+	hdr.cache_size = CONFIG_NVS_LOOKUP_CACHE_SIZE;
+
+	rc = nvs_flash_ate_rd(fs, fs->ate_wra + ate_size, &hdr.last_ate);
+	if (rc) {
+		goto end;
+	}
+
+	hdr.crc32 = nvs_index_crc32(&hdr, fs->lookup_cache);
+
+	/* the slot is used as soon as a write to it is attempted */
+	addr = nvs_index_addr(fs, fs->index_slot);
+	fs->index_slot++;
+
+	rc = nvs_flash_al_wrt(fs, addr, &hdr, sizeof(hdr));
+	if (rc) {
+		goto end;
+	}
+
+	rc = nvs_flash_al_wrt(fs, addr + sizeof(hdr), fs->lookup_cache,
+			      sizeof(fs->lookup_cache));
+
+end:
+	if (rc) {
+		LOG_WRN("Index checkpoint failed: %d", rc);
+	}
+
+	return rc;
+}
+
+/* restore the lookup cache from the latest checkpoint. Called at the end of
+ * startup, when ate_wra and data_wra are known. Returns 0 when the lookup cache
+ * is restored, otherwise the lookup cache content is undefined.
+ */
+static int nvs_index_load(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_index_hdr hdr;
+	struct nvs_ate ate;
+	uint32_t addr;
+	uint16_t slots, used;
+	size_t ate_size;
+	uint8_t erase_value = fs->flash_parameters->erase_value;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	slots = nvs_index_slots(fs);
+
+	/* the slots in use come first */
+	for (used = 0U; used < slots; used++) {
+		rc = nvs_flash_cmp_const(fs, nvs_index_addr(fs, used), erase_value,
+					 sizeof(hdr));
+		if (rc < 0) {
+			return rc;
+		}
+		if (!rc) {
+			break;
+		}
+	}
+
+	fs->index_slot = used;
+
+	/* checkpoints can only be appended to an erased area, otherwise erase
+	 * the index sector before the next checkpoint.
+	 */
+	if (used < slots) {
+		addr = nvs_index_addr(fs, used);
+		rc = nvs_flash_cmp_const(fs, addr, erase_value,
+					 fs->sector_size - (addr & ADDR_OFFS_MASK));
+		if (rc < 0) {
+			return rc;
+		}
+		if (rc) {
+			fs->index_slot = slots;
+		}
+	}
+
+	if (!used) {
+		return -ENOENT;
+	}
+
+	/* only the latest checkpoint can match, the previous ones were
+	 * written before a gc.
+	 */
+	addr = nvs_index_addr(fs, used - 1U);
+	rc = nvs_flash_rd(fs, addr, &hdr, sizeof(hdr));
+	if (rc) {
+		return rc;
+	}
+
+	if ((hdr.magic != NVS_INDEX_MAGIC) ||
+	    (hdr.cache_size != CONFIG_NVS_LOOKUP_CACHE_SIZE)) {
+		return -ENOENT;
+	}
+
+	rc = nvs_flash_rd(fs, addr + sizeof(hdr), fs->lookup_cache,
+			  sizeof(fs->lookup_cache));
+	if (rc) {
+		return rc;
+	}
+
+	if (nvs_index_crc32(&hdr, fs->lookup_cache) != hdr.crc32) {
+		LOG_WRN("Invalid index checkpoint crc");
+		return -ENOENT;
+	}
+
+	/* the checkpoint matches if no sector was closed since it was written:
+	 * ate_wra is still in the same sector and the ate preceding the
+	 * checkpoint ate_wra is unchanged.
+	 */
+	if (((hdr.ate_wra & ADDR_SECT_MASK) != (fs->ate_wra & ADDR_SECT_MASK)) ||
+	    (hdr.ate_wra < fs->ate_wra) || (hdr.data_wra > fs->data_wra)) {
+		return -ENOENT;
+	}
+
+	rc = nvs_flash_ate_rd(fs, hdr.ate_wra + ate_size, &ate);
+	if (rc) {
+		return rc;
+	}
+
+	if (memcmp(&ate, &hdr.last_ate, sizeof(ate))) {
+		return -ENOENT;
+	}
+
+	/* update the lookup cache with the ate's written after the checkpoint,
+	 * oldest first.
+	 */
+	for (addr = hdr.ate_wra; addr > fs->ate_wra; addr -= ate_size) {
+		rc = nvs_flash_ate_rd(fs, addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		if ((ate.id != 0xFFFF) && nvs_ate_valid(fs, &ate)) {
+			fs->lookup_cache[nvs_lookup_cache_pos(ate.id)] = addr;
+		}
+	}
+
+	LOG_DBG("Lookup cache restored from index slot %u", used - 1U);
+
+	return 0;
+}
+/* end index routines */
+#endif /* CONFIG_NVS_INDEX */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -764,7 +980,7 @@ static int nvs_startup(struct nvs_fs *fs)
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can write.
 	 */
-	for (i = 0; i < fs->sector_count; i++) {
+	for (i = 0; i < nvs_sector_count(fs); i++) {
 		addr = (i << ADDR_SECT_SHIFT) +
 		       (uint16_t)(fs->sector_size - ate_size);
 		rc = nvs_flash_cmp_const(fs, addr, erase_value,
@@ -782,17 +998,18 @@ static int nvs_startup(struct nvs_fs *fs)
 		}
 	}
 	/* all sectors are closed, this is not a nvs fs or irreparably corrupted */
-	if (closed_sectors == fs->sector_count) {
+	if (closed_sectors == nvs_sector_count(fs)) {
 #ifdef CONFIG_NVS_INIT_BAD_MEMORY_REGION
 		LOG_WRN("All sectors closed, erasing all sectors...");
+		/* the index sector is erased too, it does not match anymore */
 		rc = flash_flatten(fs->flash_device, fs->offset,
 				   fs->sector_size * fs->sector_count);
 		if (rc) {
 			goto end;
 		}
 
-		i = fs->sector_count;
-		addr = ((fs->sector_count - 1) << ADDR_SECT_SHIFT) +
+		i = nvs_sector_count(fs);
+		addr = ((nvs_sector_count(fs) - 1) << ADDR_SECT_SHIFT) +
 		       (uint16_t)(fs->sector_size - ate_size);
 #else
 		rc = -EDEADLK;
@@ -800,7 +1017,7 @@ static int nvs_startup(struct nvs_fs *fs)
 #endif
 	}
 
-	if (i == fs->sector_count) {
+	if (i == nvs_sector_count(fs)) {
 		/* none of the sectors where closed, in most cases we can set
 		 * the address to the first sector, except when there are only
 		 * two sectors. Then we can only set it to the first sector if
@@ -962,7 +1179,20 @@ static int nvs_startup(struct nvs_fs *fs)
 
 end:
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#ifdef CONFIG_NVS_INDEX
+	if (!rc && !nvs_index_usable(fs)) {
+		rc = nvs_lookup_cache_rebuild(fs);
+	} else if (!rc) {
+		rc = nvs_index_load(fs);
+		if (rc) {
+			LOG_INF("No valid index, rebuilding lookup cache");
+			rc = nvs_lookup_cache_rebuild(fs);
+			if (!rc) {
+				(void)nvs_index_write(fs);
+			}
+		}
+	}
+#elif defined(CONFIG_NVS_LOOKUP_CACHE)
 	if (!rc) {
 		rc = nvs_lookup_cache_rebuild(fs);
 	}
@@ -1043,12 +1273,20 @@ int nvs_mount(struct nvs_fs *fs)
 		return -EINVAL;
 	}
 
-	/* check the number of sectors, it should be at least 2 */
-	if (fs->sector_count < 2) {
+	/* check the number of sectors, it should be at least 2 plus the index */
+	if (fs->sector_count < 2 + NVS_INDEX_SECTORS) {
 		LOG_ERR("Configuration error - sector count");
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_NVS_INDEX
+	/* the lookup cache is rebuilt at each mount without the index */
+	if (!nvs_index_usable(fs)) {
+		LOG_WRN("Index sector holds %u checkpoints, index not used",
+			nvs_index_slots(fs));
+	}
+#endif
+
 	rc = nvs_startup(fs);
 	if (rc) {
 		return rc;
@@ -1168,7 +1406,7 @@ no_cached_entry:
 
 	gc_count = 0;
 	while (1) {
-		if (gc_count == fs->sector_count) {
+		if (gc_count == nvs_sector_count(fs)) {
 			/* gc'ed all sectors, no extra space will be created
 			 * by extra gc.
 			 */
@@ -1195,6 +1433,9 @@ no_cached_entry:
 		if (rc) {
 			goto end;
 		}
+#ifdef CONFIG_NVS_INDEX
+		(void)nvs_index_write(fs);
+#endif
 		gc_count++;
 	}
 	rc = len;
@@ -1331,7 +1572,7 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	 * Take into account one less sector because it is reserved for the
 	 * garbage collection.
 	 */
-	free_space = (fs->sector_count - 1) * (fs->sector_size - (2 * ate_size));
+	free_space = (nvs_sector_count(fs) - 1) * (fs->sector_size - (2 * ate_size));
 
 	step_addr = fs->ate_wra;
 
@@ -1405,6 +1646,11 @@ int nvs_sector_use_next(struct nvs_fs *fs)
 	}
 
 	ret = nvs_gc(fs);
+#ifdef CONFIG_NVS_INDEX
+	if (ret == 0) {
+		(void)nvs_index_write(fs);
+	}
+#endif
 
 end:
 	k_mutex_unlock(&fs->nvs_lock);
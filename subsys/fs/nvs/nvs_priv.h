@@ -32,6 +32,17 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+/*
+ * The last sector of the file system is reserved for the index when it is enabled
+ */
+#ifdef CONFIG_NVS_INDEX
+#define NVS_INDEX_SECTORS 1
+#else
+#define NVS_INDEX_SECTORS 0
+#endif
+
+#define NVS_INDEX_MAGIC 0x5844494e /* "NIDX" */
+
 /*
  * Allow to use the NVS_DATA_CRC_SIZE macro in computations whether data CRC is enabled or not
  */
@@ -54,6 +65,23 @@ BUILD_ASSERT(offsetof(struct nvs_ate, crc8) ==
 		 sizeof(struct nvs_ate) - sizeof(uint8_t),
 		 "crc8 must be the last member");
 
+/* Index checkpoint header, followed by a copy of the lookup cache */
+struct nvs_index_hdr {
+	uint32_t magic;		/* NVS_INDEX_MAGIC */
+	uint32_t ate_wra;	/* ate write address when the checkpoint was written */
+	uint32_t data_wra;	/* data write address when the checkpoint was written */
+	struct nvs_ate last_ate; /* copy of the ate preceding ate_wra */
+	uint16_t cache_size;	/* number of lookup cache entries */
+	uint8_t reserved[6];
+	uint32_t crc32;		/* crc32 of the header and the lookup cache */
+} __packed;
+
+BUILD_ASSERT(sizeof(struct nvs_index_hdr) == NVS_BLOCK_SIZE,
+		 "index header must be a multiple of any write block size");
+BUILD_ASSERT(offsetof(struct nvs_index_hdr, crc32) ==
+		 sizeof(struct nvs_index_hdr) - sizeof(uint32_t),
+		 "crc32 must be the last member");
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,537 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Backend storing dictionary based log messages in a flash partition used as
+ * a circular log.
+ *
+ * Each sector of the partition starts with a header holding the sequence
+ * number of the sector, increased each time a sector is started, and the
+ * number of times it was erased. The sector is followed by records, each one
+ * holding one log message as formatted by the dictionary based logging, and
+ * padded to the flash write block size. When a record does not fit in the
+ * current sector, the next one is erased and started, so sectors are erased
+ * in turn and wear evenly. All fields are little endian.
+ *
+ * The header is written right after the sector is erased, carrying the erase
+ * count over. The count of a sector whose header was lost, e.g. on a power
+ * loss between the erase and the header write, is estimated from the highest
+ * count, since sectors are erased in turn.
+ */
+
+#include <string.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_backend_flash.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+
+#define FLASH_PARTITION		log_partition
+#define FLASH_PARTITION_ID	FIXED_PARTITION_ID(FLASH_PARTITION)
+
+#if !FIXED_PARTITION_EXISTS(FLASH_PARTITION)
+#error "Need a fixed partition named 'log-partition'!"
+#endif
+
+BUILD_ASSERT(!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
+	     "Immediate logging is not supported by LOG flash backend.");
+
+#define SECTOR_MAGIC	0x474f4c5aU /* "ZLOG" */
+#define SECTOR_VERSION	1
+
+/* Largest flash write block size supported */
+#define MAX_WRITE_ALIGN	32
+
+struct sector_hdr {
+	uint32_t magic;
+	uint8_t version;
+	uint8_t reserved;
+	/* Write block size the records are padded to */
+	uint16_t align;
+	uint32_t seq;
+	uint32_t erase_count;
+} __packed;
+
+struct record_hdr {
+	uint16_t len;
+	/* Complement of len, detecting records partially written */
+	uint16_t len_inv;
+} __packed;
+
+#define RECORD_BUF_SIZE                                                                            \
+	ROUND_UP(sizeof(struct record_hdr) + CONFIG_LOG_BACKEND_FLASH_RECORD_SIZE, MAX_WRITE_ALIGN)
+
+enum backend_flash_state {
+	BACKEND_FLASH_NOT_INITIALIZED = 0,
+	BACKEND_FLASH_UNUSABLE,
+	BACKEND_FLASH_OK
+};
+
+static K_MUTEX_DEFINE(lock);
+static enum backend_flash_state backend_state = BACKEND_FLASH_NOT_INITIALIZED;
+
+static const struct flash_area *fa;
+static uint32_t sector_size;
+static uint32_t num_sectors;
+static uint32_t write_align;
+static uint32_t hdr_len;
+static uint16_t erased16;
+
+static uint32_t cur_sector;
+static uint32_t cur_seq;
+static uint32_t write_off;
+static uint32_t max_erase_count;
+
+/* Messages not stored, reported in a dropped message record */
+static uint32_t lost;
+
+/* Record being written, or read */
+static uint8_t __aligned(4) record_buf[RECORD_BUF_SIZE];
+static size_t record_len;
+static bool record_overflow;
+
+static inline off_t sector_off(uint32_t sector)
+{
+	return (off_t)sector * sector_size;
+}
+
+static inline uint32_t record_size(size_t len)
+{
+	return ROUND_UP(sizeof(struct record_hdr) + len, write_align);
+}
+
+static bool sector_hdr_read(uint32_t sector, struct sector_hdr *hdr)
+{
+	if (flash_area_read(fa, sector_off(sector), hdr, sizeof(*hdr)) != 0) {
+		return false;
+	}
+
+	hdr->seq = sys_le32_to_cpu(hdr->seq);
+	hdr->erase_count = sys_le32_to_cpu(hdr->erase_count);
+
+	return (sys_le32_to_cpu(hdr->magic) == SECTOR_MAGIC) &&
+	       (hdr->version == SECTOR_VERSION) && (sys_le16_to_cpu(hdr->align) == write_align);
+}
+
+/* Get the offset following the last record of a sector. Sectors with a
+ * record partially written are considered full.
+ */
+static uint32_t sector_end(uint32_t sector)
+{
+	struct record_hdr rec;
+	uint32_t off = hdr_len;
+
+	while ((off + sizeof(rec)) <= sector_size) {
+		if (flash_area_read(fa, sector_off(sector) + off, &rec, sizeof(rec)) != 0) {
+			return sector_size;
+		}
+
+		if ((rec.len == erased16) && (rec.len_inv == erased16)) {
+			return off;
+		}
+
+		rec.len = sys_le16_to_cpu(rec.len);
+		rec.len_inv = sys_le16_to_cpu(rec.len_inv);
+
+		if ((rec.len != (uint16_t)~rec.len_inv) ||
+		    ((off + record_size(rec.len)) > sector_size)) {
+			return sector_size;
+		}
+
+		off += record_size(rec.len);
+	}
+
+	return sector_size;
+}
+
+static int sector_start(uint32_t sector, uint32_t seq)
+{
+	uint8_t buf[ROUND_UP(sizeof(struct sector_hdr), MAX_WRITE_ALIGN)];
+	struct sector_hdr hdr;
+	uint32_t erase_count = (max_erase_count > 0U) ? (max_erase_count - 1U) : 0U;
+	int rc;
+
+	if (sector_hdr_read(sector, &hdr)) {
+		erase_count = hdr.erase_count;
+	}
+
+	erase_count++;
+	max_erase_count = MAX(max_erase_count, erase_count);
+
+	rc = flash_area_flatten(fa, sector_off(sector), sector_size);
+	if (rc != 0) {
+		return rc;
+	}
+
+	hdr.magic = sys_cpu_to_le32(SECTOR_MAGIC);
+	hdr.version = SECTOR_VERSION;
+	hdr.reserved = 0;
+	hdr.align = sys_cpu_to_le16(write_align);
+	hdr.seq = sys_cpu_to_le32(seq);
+	hdr.erase_count = sys_cpu_to_le32(erase_count);
+
+	memset(buf, flash_area_erased_val(fa), hdr_len);
+	memcpy(buf, &hdr, sizeof(hdr));
+
+	rc = flash_area_write(fa, sector_off(sector), buf, hdr_len);
+	if (rc != 0) {
+		return rc;
+	}
+
+	cur_sector = sector;
+	cur_seq = seq;
+	write_off = hdr_len;
+
+	return 0;
+}
+
+/* Start the sector following the current one, skipping the failing ones */
+static int sector_rotate(void)
+{
+	uint32_t sector = cur_sector;
+
+	for (uint32_t i = 0; i < num_sectors; i++) {
+		sector = (sector + 1) % num_sectors;
+
+		if (sector_start(sector, cur_seq + 1) == 0) {
+			return 0;
+		}
+	}
+
+	return -EIO;
+}
+
+static int partition_mount(void)
+{
+	struct flash_pages_info info;
+	struct sector_hdr hdr;
+	bool found = false;
+	int rc;
+
+	rc = flash_area_open(FLASH_PARTITION_ID, &fa);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if (!flash_area_device_is_ready(fa)) {
+		return -EBUSY;
+	}
+
+	rc = flash_get_page_info_by_offs(flash_area_get_device(fa), fa->fa_off, &info);
+	if (rc != 0) {
+		return rc;
+	}
+
+	sector_size = info.size;
+	num_sectors = fa->fa_size / sector_size;
+	write_align = MAX(flash_area_align(fa), sizeof(uint32_t));
+	hdr_len = ROUND_UP(sizeof(struct sector_hdr), write_align);
+	erased16 = flash_area_erased_val(fa) * 0x0101U;
+
+	if ((num_sectors < 2) || (write_align > MAX_WRITE_ALIGN) ||
+	    ((hdr_len + RECORD_BUF_SIZE) > sector_size)) {
+		return -EINVAL;
+	}
+
+	/* The newest sector is the one with the highest sequence number */
+	for (uint32_t i = 0; i < num_sectors; i++) {
+		if (!sector_hdr_read(i, &hdr)) {
+			continue;
+		}
+
+		max_erase_count = MAX(max_erase_count, hdr.erase_count);
+
+		if (!found || (hdr.seq > cur_seq)) {
+			found = true;
+			cur_sector = i;
+			cur_seq = hdr.seq;
+		}
+	}
+
+	if (!found) {
+		return sector_start(0, 0);
+	}
+
+	write_off = sector_end(cur_sector);
+
+	return 0;
+}
+
+static int backend_mount(void)
+{
+	int rc;
+
+	switch (backend_state) {
+	case BACKEND_FLASH_OK:
+		return 0;
+	case BACKEND_FLASH_UNUSABLE:
+		return -ENODEV;
+	default:
+		break;
+	}
+
+	rc = partition_mount();
+	if (rc == -EBUSY) {
+		return rc;
+	}
+
+	backend_state = (rc == 0) ? BACKEND_FLASH_OK : BACKEND_FLASH_UNUSABLE;
+
+	return (rc == 0) ? 0 : -ENODEV;
+}
+
+static int record_write(void)
+{
+	struct record_hdr rec = {
+		.len = sys_cpu_to_le16(record_len),
+		.len_inv = sys_cpu_to_le16((uint16_t)~record_len),
+	};
+	uint32_t size = record_size(record_len);
+	int rc;
+
+	if ((write_off + size) > sector_size) {
+		rc = sector_rotate();
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	memcpy(record_buf, &rec, sizeof(rec));
+	memset(&record_buf[sizeof(rec) + record_len], flash_area_erased_val(fa),
+	       size - sizeof(rec) - record_len);
+
+	rc = flash_area_write(fa, sector_off(cur_sector) + write_off, record_buf, size);
+	if (rc != 0) {
+		/* The record may be partially written, start another sector */
+		write_off = sector_size;
+		return rc;
+	}
+
+	write_off += size;
+
+	return 0;
+}
+
+static int record_append(uint8_t *data, size_t length, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	if ((record_len + length) > CONFIG_LOG_BACKEND_FLASH_RECORD_SIZE) {
+		record_overflow = true;
+	} else {
+		memcpy(&record_buf[sizeof(struct record_hdr) + record_len], data, length);
+		record_len += length;
+	}
+
+	return length;
+}
+
+static uint8_t __aligned(4) output_buf[sizeof(uint32_t)];
+LOG_OUTPUT_DEFINE(log_output, record_append, output_buf, sizeof(output_buf));
+
+static void record_start(void)
+{
+	record_len = 0;
+	record_overflow = false;
+}
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (backend_mount() != 0) {
+		lost++;
+		goto out;
+	}
+
+	if (lost != 0U) {
+		record_start();
+		log_dict_output_dropped_process(&log_output, lost);
+
+		if (record_write() == 0) {
+			lost = 0;
+		}
+	}
+
+	record_start();
+	log_dict_output_msg_process(&log_output, &msg->log, 0);
+
+	if (record_overflow || (record_write() != 0)) {
+		lost++;
+	}
+
+out:
+	k_mutex_unlock(&lock);
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	lost += cnt;
+	k_mutex_unlock(&lock);
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	/* In case of panic deinitialize backend. It is better to keep
+	 * current data rather than log new and risk of failure.
+	 */
+	log_backend_deactivate(backend);
+}
+
+static int is_ready(const struct log_backend *const backend)
+{
+	int rc;
+
+	ARG_UNUSED(backend);
+
+	k_mutex_lock(&lock, K_FOREVER);
+	rc = backend_mount();
+	k_mutex_unlock(&lock);
+
+	/* An unusable partition only drops the messages */
+	return (rc == -EBUSY) ? -EBUSY : 0;
+}
+
+static int format_set(const struct log_backend *const backend, uint32_t log_type)
+{
+	ARG_UNUSED(backend);
+
+	return (log_type == LOG_OUTPUT_DICT) ? 0 : -ENOTSUP;
+}
+
+static const struct log_backend_api log_backend_flash_api = {
+	.process = process,
+	.dropped = dropped,
+	.panic = panic,
+	.is_ready = is_ready,
+	.format_set = format_set,
+};
+
+LOG_BACKEND_DEFINE(log_backend_flash, log_backend_flash_api,
+		   IS_ENABLED(CONFIG_LOG_BACKEND_FLASH_AUTOSTART));
+
+static int sector_read(uint32_t sector, uint32_t end, log_backend_flash_read_cb_t cb,
+		       void *user_data)
+{
+	struct record_hdr rec;
+	uint32_t off = hdr_len;
+	int rc;
+
+	while ((off + sizeof(rec)) <= end) {
+		rc = flash_area_read(fa, sector_off(sector) + off, &rec, sizeof(rec));
+		if (rc != 0) {
+			return -EIO;
+		}
+
+		rec.len = sys_le16_to_cpu(rec.len);
+		rec.len_inv = sys_le16_to_cpu(rec.len_inv);
+
+		if ((rec.len != (uint16_t)~rec.len_inv) ||
+		    (rec.len > CONFIG_LOG_BACKEND_FLASH_RECORD_SIZE) ||
+		    ((off + record_size(rec.len)) > end)) {
+			/* End of the sector, or record partially written */
+			return 0;
+		}
+
+		rc = flash_area_read(fa, sector_off(sector) + off + sizeof(rec), record_buf,
+				     rec.len);
+		if (rc != 0) {
+			return -EIO;
+		}
+
+		rc = cb(record_buf, rec.len, user_data);
+		if (rc != 0) {
+			return rc;
+		}
+
+		off += record_size(rec.len);
+	}
+
+	return 0;
+}
+
+int log_backend_flash_read(log_backend_flash_read_cb_t cb, void *user_data)
+{
+	struct sector_hdr hdr;
+	uint32_t sector;
+	uint32_t last_seq = 0;
+	bool first = true;
+	int rc;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	rc = backend_mount();
+	if (rc != 0) {
+		rc = -ENODEV;
+		goto out;
+	}
+
+	/* The oldest sector follows the current one */
+	for (uint32_t i = 1; i <= num_sectors; i++) {
+		sector = (cur_sector + i) % num_sectors;
+
+		/* Skip the sectors not started, and the ones left over when a
+		 * sector could not be started
+		 */
+		if (!sector_hdr_read(sector, &hdr) || (hdr.seq > cur_seq) ||
+		    (!first && (hdr.seq <= last_seq))) {
+			continue;
+		}
+
+		first = false;
+		last_seq = hdr.seq;
+
+		rc = sector_read(sector, (sector == cur_sector) ? write_off : sector_size, cb,
+				 user_data);
+		if (rc != 0) {
+			break;
+		}
+	}
+
+out:
+	k_mutex_unlock(&lock);
+
+	return rc;
+}
+
+int log_backend_flash_clear(void)
+{
+	uint32_t first;
+	int rc;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	rc = backend_mount();
+	if (rc != 0) {
+		rc = -ENODEV;
+		goto out;
+	}
+
+	/* Start every sector in turn, so that each one gets its header, with
+	 * its erase count, back right after being erased. The last one
+	 * started is the current one.
+	 */
+	first = cur_sector;
+
+	for (uint32_t i = 1; i <= num_sectors; i++) {
+		if (sector_start((first + i) % num_sectors, cur_seq + 1) != 0) {
+			rc = -EIO;
+		}
+	}
+
+out:
+	k_mutex_unlock(&lock);
+
+	return rc;
+}
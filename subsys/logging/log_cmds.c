@@ -421,14 +421,117 @@ static int cmd_log_mem(const struct shell *sh, size_t argc, char **argv)
 	err = log_mem_get_max_usage(&max);
 	if (err < 0) {
 		shell_print(sh, "Enable CONFIG_LOG_MEM_UTILIZATION to get maximum usage");
-		return 0;
+	} else {
+		shell_print(sh, "\tMaximum usage: %u bytes", max);
+	}
+
+	if (IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) {
+		struct log_cpu_stats stats;
+
+		for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+			if (log_cpu_stats_get(cpu, &stats) < 0) {
+				break;
+			}
+
+			shell_print(sh, "\tCPU %u: %u/%u bytes (max %u), dropped %u, overwritten %u",
+				    cpu, stats.usage, stats.buf_size, stats.max_usage,
+				    stats.dropped, stats.overwritten);
+		}
+	}
+
+	return 0;
+}
+
+static void throttle_print(const struct shell *sh, const struct log_throttle_config *config)
+{
+	if (config->burst > 0) {
+		shell_print(sh, "Rate limit: %u messages per call site every %u ms",
+			    config->burst, config->interval_ms);
+	} else {
+		shell_print(sh, "Rate limit: off");
 	}
 
-	shell_print(sh, "\tMaximum usage: %u bytes", max);
+	shell_print(sh, "Collapse repeated messages: %s", config->collapse ? "on" : "off");
+}
+
+static int cmd_log_throttle_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct log_throttle_config config;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (log_throttle_config_get(&config) < 0) {
+		shell_error(sh, "Throttling not supported");
+		return -ENOEXEC;
+	}
+
+	throttle_print(sh, &config);
 
 	return 0;
 }
 
+static int cmd_log_throttle_rate(const struct shell *sh, size_t argc, char **argv)
+{
+	struct log_throttle_config config;
+	int err = 0;
+
+	if (log_throttle_config_get(&config) < 0) {
+		shell_error(sh, "Throttling not supported");
+		return -ENOEXEC;
+	}
+
+	config.burst = shell_strtoul(argv[1], 0, &err);
+	if (argc > 2) {
+		config.interval_ms = shell_strtoul(argv[2], 0, &err);
+	}
+
+	if ((err != 0) || (log_throttle_config_set(&config) < 0)) {
+		shell_error(sh, "Invalid rate");
+		return -EINVAL;
+	}
+
+	throttle_print(sh, &config);
+
+	return 0;
+}
+
+static int cmd_log_throttle_collapse(const struct shell *sh, size_t argc, char **argv)
+{
+	struct log_throttle_config config;
+	int err = 0;
+
+	ARG_UNUSED(argc);
+
+	if (log_throttle_config_get(&config) < 0) {
+		shell_error(sh, "Throttling not supported");
+		return -ENOEXEC;
+	}
+
+	config.collapse = shell_strtobool(argv[1], 0, &err);
+	if (err != 0) {
+		shell_error(sh, "Invalid argument: %s", argv[1]);
+		return -EINVAL;
+	}
+
+	(void)log_throttle_config_set(&config);
+	throttle_print(sh, &config);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_throttle,
+	SHELL_CMD(show, NULL, "Show throttling settings.", cmd_log_throttle_show),
+	SHELL_CMD_ARG(rate, NULL,
+		  "'log throttle rate <burst> [<interval_ms>]' allows up to <burst> "
+		  "messages per call site in each interval (0 disables rate limiting).",
+		  cmd_log_throttle_rate, 2, 1),
+	SHELL_CMD_ARG(collapse, NULL,
+		  "'log throttle collapse <on|off>' collapses repeated messages.",
+		  cmd_log_throttle_collapse, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_backend,
 	SHELL_CMD_ARG(disable, &dsub_module_name,
 		  "'log disable <module_0> .. <module_n>' disables logs in "
@@ -488,6 +591,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		       cmd_log_self_status),
 	SHELL_COND_CMD(CONFIG_LOG_MODE_DEFERRED, mem, NULL, "Logger memory usage",
 		       cmd_log_mem),
+	SHELL_COND_CMD(CONFIG_LOG_THROTTLE, throttle, &sub_log_throttle,
+		       "Message flood throttling", NULL),
 	SHELL_COND_CMD(CONFIG_LOG_FRONTEND, FRONTEND_NAME, &sub_log_backend,
 		"Frontend control", NULL),
 	SHELL_SUBCMD_SET_END);
@@ -123,6 +123,10 @@ static STRUCT_SECTION_ITERABLE(log_msg_ptr, log_msg_ptr);
 static STRUCT_SECTION_ITERABLE_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer);
 static struct mpsc_pbuf_buffer *curr_log_buffer;
 
+#ifdef CONFIG_LOG_THROTTLE
+static void throttle_flush(void);
+#endif
+
 #ifdef CONFIG_MPSC_PBUF
 static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
 	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
@@ -142,6 +146,27 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 };
 #endif
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* Size (in words) of the part of the buffer used by each CPU. */
+#define CPU_BUF_WLEN ROUND_DOWN(ARRAY_SIZE(buf32) / CONFIG_MP_MAX_NUM_CPUS, \
+				 Z_LOG_MSG_ALIGNMENT / sizeof(int))
+
+BUILD_ASSERT(CPU_BUF_WLEN > 1, "CONFIG_LOG_BUFFER_SIZE too small for the number of CPUs");
+
+static struct mpsc_pbuf_buffer cpu_buffer[CONFIG_MP_MAX_NUM_CPUS];
+/* Message claimed from each CPU buffer, waiting for older messages from other CPUs. */
+static union log_msg_generic *cpu_msg[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t cpu_dropped[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t cpu_overwritten[CONFIG_MP_MAX_NUM_CPUS];
+
+static void cpu_buffer_notify_drop(const struct mpsc_pbuf_buffer *buffer,
+				   const union mpsc_pbuf_generic *item)
+{
+	atomic_inc(&cpu_overwritten[buffer - cpu_buffer]);
+	z_log_notify_drop(buffer, item);
+}
+#endif
+
 /* Check that default tag can fit in tag buffer. */
 COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, (),
 	(BUILD_ASSERT(sizeof(CONFIG_LOG_TAG_DEFAULT) <= CONFIG_LOG_TAG_MAX_LEN + 1,
@@ -443,6 +468,10 @@ void z_impl_log_panic(void)
 	 */
 	(void)z_log_init(true, false);
 
+#ifdef CONFIG_LOG_THROTTLE
+	throttle_flush();
+#endif
+
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_panic();
 		if (IS_ENABLED(CONFIG_LOG_FRONTEND_ONLY)) {
@@ -626,6 +655,12 @@ uint32_t z_vrfy_log_buffered_cnt(void)
 void z_log_dropped(bool buffered)
 {
 	atomic_inc(&dropped_cnt);
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	/* Overwritten messages are counted per buffer by cpu_buffer_notify_drop(). */
+	if (!buffered) {
+		atomic_inc(&cpu_dropped[arch_curr_cpu()->id]);
+	}
+#endif
 	if (buffered) {
 		atomic_dec(&buffered_cnt);
 	}
@@ -648,12 +683,51 @@ bool z_log_dropped_pending(void)
 
 void z_log_msg_init(void)
 {
-#ifdef CONFIG_MPSC_PBUF
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+	config.size = CPU_BUF_WLEN;
+	config.notify_drop = cpu_buffer_notify_drop;
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		config.buf = &buf32[i * CPU_BUF_WLEN];
+		mpsc_pbuf_init(&cpu_buffer[i], &config);
+		cpu_msg[i] = NULL;
+	}
+
+	curr_log_buffer = &cpu_buffer[0];
+#elif defined(CONFIG_MPSC_PBUF)
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
 }
 
+/* Buffer used for messages created in the current context. */
+static struct mpsc_pbuf_buffer *local_buffer(void)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	return &cpu_buffer[arch_curr_cpu()->id];
+#else
+	return &log_buffer;
+#endif
+}
+
+/* Buffer holding a message allocated by z_log_msg_alloc(). Thread may have migrated
+ * to another CPU since the allocation so it is found from the message location.
+ */
+static struct mpsc_pbuf_buffer *msg_buffer(const struct log_msg *msg)
+{
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	size_t idx = ((uintptr_t)msg - (uintptr_t)buf32) / (CPU_BUF_WLEN * sizeof(int));
+
+	return &cpu_buffer[idx];
+#else
+	ARG_UNUSED(msg);
+
+	return &log_buffer;
+#endif
+}
+
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 {
 	if (!IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
@@ -669,7 +743,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(local_buffer(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -701,12 +775,49 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_buffer(msg), msg);
 }
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* Claim the oldest message (lowest timestamp) from the CPU buffers. */
+static union log_msg_generic *cpu_msg_claim_oldest(void)
+{
+	union log_msg_generic *msg = NULL;
+	log_timestamp_t t_min = 0;
+	unsigned int chosen = 0;
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		log_timestamp_t t;
+
+		if (cpu_msg[i] == NULL) {
+			cpu_msg[i] = (union log_msg_generic *)mpsc_pbuf_claim(&cpu_buffer[i]);
+			if (cpu_msg[i] == NULL) {
+				continue;
+			}
+		}
+
+		t = log_msg_get_timestamp(&cpu_msg[i]->log);
+		if ((msg == NULL) || (t < t_min)) {
+			t_min = t;
+			msg = cpu_msg[i];
+			chosen = i;
+		}
+	}
+
+	if (msg) {
+		cpu_msg[chosen] = NULL;
+		curr_log_buffer = &cpu_buffer[chosen];
+	}
+
+	return msg;
+}
+#endif
+
 union log_msg_generic *z_log_msg_local_claim(void)
 {
-#ifdef CONFIG_MPSC_PBUF
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	return cpu_msg_claim_oldest();
+#elif defined(CONFIG_MPSC_PBUF)
 	return (union log_msg_generic *)mpsc_pbuf_claim(&log_buffer);
 #else
 	return NULL;
@@ -824,7 +935,17 @@ bool z_log_msg_pending(void)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+		for (unsigned int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+			if ((cpu_msg[cpu] != NULL) || msg_pending(&cpu_buffer[cpu])) {
+				return true;
+			}
+		}
+
+		return false;
+#else
 		return msg_pending(&log_buffer);
+#endif
 	}
 
 	STRUCT_SECTION_FOREACH(log_msg_ptr, msg_ptr) {
@@ -850,7 +971,7 @@ void z_log_msg_enqueue(const struct log_link *link, const void *data, size_t len
 {
 	struct log_msg *log_msg = (struct log_msg *)data;
 	size_t wlen = DIV_ROUND_UP(ROUND_UP(len, Z_LOG_MSG_ALIGNMENT), sizeof(int));
-	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf : &log_buffer;
+	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf : local_buffer();
 	struct log_msg *local_msg = msg_alloc(mpsc_pbuffer, wlen);
 
 	if (!local_msg) {
@@ -865,6 +986,228 @@ void z_log_msg_enqueue(const struct log_link *link, const void *data, size_t len
 	msg_commit(mpsc_pbuffer, local_msg);
 }
 
+#ifdef CONFIG_LOG_THROTTLE
+static const char throttle_repeated_fmt[] = "Last message repeated %u times";
+static const char throttle_dropped_fmt[] = "%u messages dropped by rate limiting";
+
+struct throttle_callsite {
+	const void *source;
+	const char *fmt;
+	atomic_t window_start;
+	atomic_t cnt;
+	atomic_t dropped;
+	uint8_t level;
+};
+
+struct throttle_report {
+	const void *source;
+	const char *fmt;
+	uint32_t cnt;
+	uint8_t level;
+};
+
+/* Previous message logged on a CPU, to collapse repetitions. */
+struct throttle_last {
+	struct k_spinlock lock;
+	const void *source;
+	const char *fmt;
+	uint32_t hash;
+	uint32_t start;
+	uint32_t repeated;
+	uint8_t level;
+	bool valid;
+};
+
+static struct log_throttle_config throttle_config = {
+	.burst = CONFIG_LOG_THROTTLE_BURST,
+	.interval_ms = CONFIG_LOG_THROTTLE_INTERVAL_MS,
+	.collapse = IS_ENABLED(CONFIG_LOG_THROTTLE_COLLAPSE),
+};
+static struct throttle_callsite throttle_callsites[CONFIG_LOG_THROTTLE_CALLSITES];
+/* Taken to assign a call site slot or to start a new window, and to change the configuration. */
+static struct k_spinlock throttle_lock;
+static struct throttle_last throttle_last[CONFIG_MP_MAX_NUM_CPUS];
+
+static uint32_t throttle_hash(uint32_t hash, const void *buf, size_t len)
+{
+	const uint8_t *p = buf;
+
+	/* FNV-1a */
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ p[i]) * 16777619U;
+	}
+
+	return hash;
+}
+
+static void throttle_report(const struct throttle_report *report)
+{
+	if (report->cnt > 0) {
+		z_log_msg_runtime_create(Z_LOG_LOCAL_DOMAIN_ID, report->source, report->level,
+					 NULL, 0, 0, report->fmt, report->cnt);
+	}
+}
+
+static bool throttle_callsite_match(const struct throttle_callsite *cs, const void *source,
+				    const char *fmt, uint32_t now)
+{
+	/* Signed difference, a window may have been started by another CPU with a later time. */
+	int32_t elapsed = (int32_t)(now - (uint32_t)atomic_get(&cs->window_start));
+
+	return (cs->fmt == fmt) && (cs->source == source) &&
+	       (elapsed < (int32_t)throttle_config.interval_ms);
+}
+
+/* Messages are counted with atomics while the call site owns its slot and the window is
+ * open, so the lock is only taken when a window ends. Counts may be slightly off when a
+ * message is logged while another CPU ends the window.
+ */
+static bool throttle_rate_check(const void *source, uint8_t level, const char *fmt,
+				uint32_t now, struct throttle_report *report)
+{
+	uintptr_t key = (uintptr_t)fmt ^ (uintptr_t)source;
+	struct throttle_callsite *cs =
+		&throttle_callsites[(key >> 2) % CONFIG_LOG_THROTTLE_CALLSITES];
+
+	if (!throttle_callsite_match(cs, source, fmt, now)) {
+		K_SPINLOCK(&throttle_lock) {
+			if ((cs->fmt != fmt) || (cs->source != source)) {
+				/* Slot is taken over by another call site. */
+				*report = (struct throttle_report){
+					cs->source, throttle_dropped_fmt,
+					(uint32_t)atomic_clear(&cs->dropped), cs->level };
+				cs->source = source;
+				cs->fmt = fmt;
+				cs->level = level;
+			} else if (!throttle_callsite_match(cs, source, fmt, now)) {
+				*report = (struct throttle_report){
+					source, throttle_dropped_fmt,
+					(uint32_t)atomic_clear(&cs->dropped), level };
+			} else {
+				/* Window started by another CPU meanwhile. */
+				K_SPINLOCK_BREAK;
+			}
+
+			atomic_clear(&cs->cnt);
+			atomic_set(&cs->window_start, (atomic_val_t)now);
+		}
+	}
+
+	if ((uint32_t)atomic_inc(&cs->cnt) >= throttle_config.burst) {
+		atomic_inc(&cs->dropped);
+		return true;
+	}
+
+	return false;
+}
+
+bool z_log_msg_throttle(const void *source, uint8_t level, const char *fmt,
+			const void *content, size_t len, const void *data, size_t dlen)
+{
+	struct throttle_report reports[2] = {0};
+	/* A thread may migrate to another CPU meanwhile, the lock keeps the state consistent. */
+	struct throttle_last *last = &throttle_last[arch_curr_cpu()->id];
+	uint32_t now = k_uptime_get_32();
+	uint32_t hash;
+	bool drop = false;
+
+	/* Reports are never throttled. */
+	if ((fmt == throttle_repeated_fmt) || (fmt == throttle_dropped_fmt)) {
+		return false;
+	}
+
+	hash = throttle_hash(throttle_hash(2166136261U, content, len), data, dlen);
+
+	K_SPINLOCK(&last->lock) {
+		if (throttle_config.collapse && last->valid &&
+		    (last->source == source) && (last->fmt == fmt) &&
+		    (last->level == level) && (last->hash == hash) &&
+		    ((now - last->start) < throttle_config.interval_ms)) {
+			last->repeated++;
+			drop = true;
+			K_SPINLOCK_BREAK;
+		}
+
+		reports[0] = (struct throttle_report){ last->source, throttle_repeated_fmt,
+						       last->repeated, last->level };
+
+		if (throttle_config.burst > 0) {
+			drop = throttle_rate_check(source, level, fmt, now, &reports[1]);
+		}
+
+		/* A dropped message cannot be reported as repeated. */
+		last->source = source;
+		last->fmt = fmt;
+		last->hash = hash;
+		last->start = now;
+		last->repeated = 0;
+		last->level = level;
+		last->valid = throttle_config.collapse && !drop;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(reports); i++) {
+		throttle_report(&reports[i]);
+	}
+
+	return drop;
+}
+
+/* Report repetitions of the last messages, which would otherwise be lost. */
+static void throttle_flush(void)
+{
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct throttle_last *last = &throttle_last[i];
+		struct throttle_report report = {0};
+
+		K_SPINLOCK(&last->lock) {
+			report = (struct throttle_report){ last->source, throttle_repeated_fmt,
+							   last->repeated, last->level };
+			last->valid = false;
+			last->repeated = 0;
+		}
+
+		throttle_report(&report);
+	}
+}
+#endif /* CONFIG_LOG_THROTTLE */
+
+int log_throttle_config_set(const struct log_throttle_config *config)
+{
+	__ASSERT_NO_MSG(config != NULL);
+
+#ifdef CONFIG_LOG_THROTTLE
+	if (config->interval_ms == 0) {
+		return -EINVAL;
+	}
+
+	throttle_flush();
+
+	K_SPINLOCK(&throttle_lock) {
+		throttle_config = *config;
+		memset(throttle_callsites, 0, sizeof(throttle_callsites));
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+int log_throttle_config_get(struct log_throttle_config *config)
+{
+	__ASSERT_NO_MSG(config != NULL);
+
+#ifdef CONFIG_LOG_THROTTLE
+	K_SPINLOCK(&throttle_lock) {
+		*config = throttle_config;
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 const char *z_log_get_tag(void)
 {
 	return CONFIG_LOG_TAG_MAX_LEN > 0 ? tag : NULL;
@@ -903,7 +1246,21 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	*buf_size = 0;
+	*usage = 0;
+
+	for (unsigned int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		uint32_t cpu_size;
+		uint32_t cpu_usage;
+
+		mpsc_pbuf_get_utilization(&cpu_buffer[cpu], &cpu_size, &cpu_usage);
+		*buf_size += cpu_size;
+		*usage += cpu_usage;
+	}
+#else
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+#endif
 
 	return 0;
 }
@@ -916,7 +1273,48 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	*max = 0;
+
+	for (unsigned int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		uint32_t cpu_max;
+		int err = mpsc_pbuf_get_max_utilization(&cpu_buffer[cpu], &cpu_max);
+
+		if (err < 0) {
+			return err;
+		}
+
+		*max += cpu_max;
+	}
+
+	return 0;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
+}
+
+int log_cpu_stats_get(unsigned int cpu, struct log_cpu_stats *stats)
+{
+	__ASSERT_NO_MSG(stats != NULL);
+
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	if (cpu >= CONFIG_MP_MAX_NUM_CPUS) {
+		return -EINVAL;
+	}
+
+	stats->dropped = (uint32_t)atomic_get(&cpu_dropped[cpu]);
+	stats->overwritten = (uint32_t)atomic_get(&cpu_overwritten[cpu]);
+	mpsc_pbuf_get_utilization(&cpu_buffer[cpu], &stats->buf_size, &stats->usage);
+	if (mpsc_pbuf_get_max_utilization(&cpu_buffer[cpu], &stats->max_usage) < 0) {
+		stats->max_usage = 0;
+	}
+
+	return 0;
+#else
+	ARG_UNUSED(cpu);
+
+	return -ENOTSUP;
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
@@ -92,6 +92,12 @@ static bool frontend_runtime_filtering(const void *source, uint32_t level)
  */
 static void z_log_msg_simple_create(const void *source, uint32_t level, uint32_t *data, size_t len)
 {
+	if (IS_ENABLED(CONFIG_LOG_THROTTLE) &&
+	    z_log_msg_throttle(source, level, (const char *)(uintptr_t)data[0], data,
+			       len * sizeof(uint32_t), NULL, 0)) {
+		return;
+	}
+
 	/* Package length (in words) is increased by the header. */
 	size_t plen32 = len + CBPRINTF_DESC_SIZE32;
 	/* Package length in bytes. */
@@ -293,6 +299,13 @@ void z_impl_z_log_msg_static_create(const void *source,
 	int inlen = desc.package_len;
 	struct log_msg *msg;
 
+	if (IS_ENABLED(CONFIG_LOG_THROTTLE) &&
+	    z_log_msg_throttle(source, desc.level,
+			       (inlen > 0) ? ((struct cbprintf_package_hdr_ext *)package)->fmt : NULL,
+			       package, inlen, data, desc.data_len)) {
+		return;
+	}
+
 	if (inlen > 0) {
 		uint32_t flags = CBPRINTF_PACKAGE_CONVERT_RW_STR |
 				 (IS_ENABLED(CONFIG_LOG_MSG_APPEND_RO_STRING_LOC) ?
@@ -375,7 +388,8 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 	if (IS_ENABLED(CONFIG_USERSPACE) && k_is_user_context()) {
 		pkg = alloca(plen);
 		msg = NULL;
-	} else if (IS_ENABLED(CONFIG_LOG_MODE_DEFERRED) && BACKENDS_IN_USE()) {
+	} else if (IS_ENABLED(CONFIG_LOG_MODE_DEFERRED) && BACKENDS_IN_USE() &&
+		   !IS_ENABLED(CONFIG_LOG_THROTTLE)) {
 		msg = z_log_msg_alloc(msg_wlen);
 		if (IS_ENABLED(CONFIG_LOG_FRONTEND) && msg == NULL) {
 			pkg = alloca(plen);
@@ -401,6 +415,22 @@ void z_log_msg_runtime_vcreate(uint8_t domain_id, const void *source,
 		}
 
 		if (BACKENDS_IN_USE()) {
+			if (IS_ENABLED(CONFIG_LOG_THROTTLE)) {
+				/* Message is created on the stack to be checked before
+				 * it is allocated.
+				 */
+				if (z_log_msg_throttle(source, level, fmt, pkg, plen, data, dlen)) {
+					return;
+				}
+
+				if (IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
+					msg = z_log_msg_alloc(msg_wlen);
+					if (msg) {
+						memcpy(msg->data, pkg, plen);
+					}
+				}
+			}
+
 			z_log_msg_finalize(msg, source, desc, data);
 		}
 	}
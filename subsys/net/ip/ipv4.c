@@ -483,6 +483,11 @@ enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
 	}
 
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
+	/* GSO packets are split into segments by the network interface */
+	if (net_pkt_gso_size(pkt) > 0U) {
+		return NET_OK;
+	}
+
 	return net_ipv4_prepare_for_send_fragment(pkt);
 #else
 	return NET_OK;
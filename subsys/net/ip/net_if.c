@@ -213,6 +213,192 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* Do not block the TX path for long if the segments cannot be allocated */
+#define GSO_BUF_TIMEOUT K_MSEC(100)
+
+bool net_if_gso_supported(struct net_if *iface)
+{
+	return iface != NULL && net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET);
+}
+
+static bool net_if_tso_offloaded(struct net_if *iface)
+{
+	return !!(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO);
+}
+
+/* Length of the IP and TCP headers of a GSO packet */
+static int gso_hdr_len(struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (tcp_hdr == NULL) {
+		return -ENOBUFS;
+	}
+
+	return ip_len + (tcp_hdr->offset >> 4) * 4;
+}
+
+/* Build a TCP segment from the headers of a GSO packet and len bytes of its
+ * payload, starting at offset.
+ */
+static struct net_pkt *gso_segment(struct net_pkt *pkt, size_t hdr_len,
+				   size_t offset, size_t len)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *seg;
+	int ret = -EINVAL;
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					AF_UNSPEC, 0, GSO_BUF_TIMEOUT);
+	if (seg == NULL) {
+		return NULL;
+	}
+
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tci(seg, net_pkt_vlan_tci(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_ttl(seg, net_pkt_ipv4_ttl(pkt));
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_hop_limit(seg, net_pkt_ipv6_hop_limit(pkt));
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	/* Only the sequence number differs between the segments, the lengths
+	 * and the checksums are updated when finalizing the segment.
+	 */
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (net_pkt_skip(seg, ip_len)) {
+		goto fail;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (tcp_hdr == NULL) {
+		goto fail;
+	}
+
+	sys_put_be32(sys_get_be32(tcp_hdr->seq) + offset, tcp_hdr->seq);
+	net_pkt_set_data(seg, &tcp_access);
+
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		ret = net_ipv4_finalize(seg, IPPROTO_TCP);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(seg) == AF_INET6) {
+		ret = net_ipv6_finalize(seg, IPPROTO_TCP);
+	}
+
+	if (ret < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	return seg;
+
+fail:
+	net_pkt_unref(seg);
+
+	return NULL;
+}
+
+/* Split a GSO packet into TCP segments and hand them to L2 one by one. Like
+ * for the L2 send, the packet is consumed only if something was sent.
+ */
+static int net_if_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	size_t gso_size = net_pkt_gso_size(pkt);
+	size_t payload_len;
+	size_t offset = 0;
+	int status = 0;
+	int hdr_len;
+	int sent = 0;
+
+	hdr_len = gso_hdr_len(pkt);
+	if (hdr_len < 0) {
+		return hdr_len;
+	}
+
+	payload_len = net_pkt_get_len(pkt) - hdr_len;
+
+	while (offset < payload_len) {
+		size_t len = MIN(gso_size, payload_len - offset);
+		struct net_pkt *seg;
+
+		seg = gso_segment(pkt, hdr_len, offset, len);
+		if (seg == NULL) {
+			status = -ENOBUFS;
+			break;
+		}
+
+		status = net_if_l2(iface)->send(iface, seg);
+		if (status < 0) {
+			net_pkt_unref(seg);
+			break;
+		}
+
+		sent += status;
+		offset += len;
+	}
+
+	if (sent == 0 && status < 0) {
+		return status;
+	}
+
+	/* The missing segments, if any, are retransmitted by TCP */
+	net_pkt_unref(pkt);
+
+	return sent;
+}
+
+static int net_if_l2_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	if (net_pkt_gso_size(pkt) > 0 && !net_if_tso_offloaded(iface)) {
+		return net_if_gso_send(iface, pkt);
+	}
+
+	return net_if_l2(iface)->send(iface, pkt);
+}
+#else
+static inline int net_if_l2_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	return net_if_l2(iface)->send(iface, pkt);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = { 0 };
@@ -259,7 +445,7 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		}
 
 		net_if_tx_lock(iface);
-		status = net_if_l2(iface)->send(iface, pkt);
+		status = net_if_l2_send(iface, pkt);
 		net_if_tx_unlock(iface);
 		if (status < 0) {
 			NET_WARN_RATELIMIT("iface %d pkt %p send failure status %d",
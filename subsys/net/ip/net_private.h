@@ -83,6 +83,17 @@ static inline void net_stats_prometheus_init(struct net_if *iface)
 }
 #endif /* CONFIG_NET_STATISTICS_VIA_PROMETHEUS */
 
+#if defined(CONFIG_NET_TCP_GSO)
+extern bool net_if_gso_supported(struct net_if *iface);
+#else
+static inline bool net_if_gso_supported(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_SOCKETS_SERVICE)
 extern void socket_service_init(void);
 #else
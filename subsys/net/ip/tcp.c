@@ -59,12 +59,18 @@ static int tcp_tx_window =
 	CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 #define TCP_RTO_MS (conn->rto)
 #else
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
+/* Lower bound of the retransmission timeout derived from RTT measurements */
+#define TCP_RTO_MIN_MS 200U
+
+/* Max number of segments retransmitted from the SACK scoreboard per ACK */
+#define TCP_SACK_REXMIT_BURST 4
+
 /* Define the number of MSS sections the congestion window is initialized at */
 #define TCP_CONGESTION_INITIAL_WIN 1
 #define TCP_CONGESTION_INITIAL_SSTHRESH 3
@@ -419,13 +425,30 @@ out:
 	tcp_pkt_unref(pkt);
 }
 
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
+static uint32_t tcp_base_rto(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (conn->rtt_measured) {
+		uint32_t rto = conn->srtt + MAX(1U, 4U * conn->rttvar);
+
+		return CLAMP(rto, MIN(TCP_RTO_MIN_MS, (uint32_t)tcp_rto), UINT16_MAX);
+	}
+#else
+	ARG_UNUSED(conn);
+#endif
+	return (uint32_t)tcp_rto;
+}
+#endif
+
 static void tcp_derive_rto(struct tcp *conn)
 {
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t rto = tcp_base_rto(conn);
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
-	/* Compute a randomized rto 1 and 1.5 times tcp_rto */
+	/* Compute a randomized rto 1 and 1.5 times the base rto */
 	uint32_t gain;
 	uint8_t gain8;
-	uint32_t rto;
 
 	/* Getting random is computational expensive, so only use 8 bits */
 	sys_rand_get(&gain8, sizeof(uint8_t));
@@ -433,9 +456,75 @@ static void tcp_derive_rto(struct tcp *conn)
 	gain = (uint32_t)gain8;
 	gain += 1 << 9;
 
-	rto = (uint32_t)tcp_rto;
 	rto = (gain * rto) >> 9;
-	conn->rto = (uint16_t)rto;
+#endif
+	conn->rto = (uint16_t)MIN(rto, UINT16_MAX);
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+/* Round-trip time estimation according to RFC6298 */
+static void tcp_rtt_update(struct tcp *conn, uint32_t rtt)
+{
+	rtt = MIN(rtt, UINT16_MAX);
+
+	if (!conn->rtt_measured) {
+		conn->srtt = rtt;
+		conn->rttvar = rtt / 2;
+		conn->rtt_measured = true;
+	} else {
+		uint32_t delta = (conn->srtt > rtt) ? conn->srtt - rtt : rtt - conn->srtt;
+
+		conn->rttvar = (3U * conn->rttvar + delta) / 4U;
+		conn->srtt = (7U * conn->srtt + rtt) / 8U;
+	}
+
+	/* Randomization is only applied when retransmitting, see tcp_derive_rto() */
+	conn->rto = (uint16_t)tcp_base_rto(conn);
+
+	NET_DBG("conn: %p rtt=%u srtt=%hu rttvar=%hu rto=%hu", conn, rtt,
+		conn->srtt, conn->rttvar, conn->rto);
+}
+
+/* Remember the timestamp to echo back, RFC7323 ch 4.3 */
+static void tcp_ts_recent_update(struct tcp *conn, uint32_t seq)
+{
+	if (conn->ts_ok && conn->recv_options.ts_found &&
+	    net_tcp_seq_cmp(seq, conn->ack) <= 0 &&
+	    (int32_t)(conn->recv_options.tsval - conn->ts_recent) >= 0) {
+		conn->ts_recent = conn->recv_options.tsval;
+	}
+}
+
+/* Called for ACKs acknowledging new data, RFC7323 ch 4.1 */
+static void tcp_ts_rtt_sample(struct tcp *conn)
+{
+	if (conn->ts_ok && conn->recv_options.ts_found &&
+	    conn->recv_options.tsecr != 0U) {
+		tcp_rtt_update(conn, k_uptime_get_32() - conn->recv_options.tsecr);
+	}
+}
+#else
+
+static void tcp_ts_recent_update(struct tcp *conn, uint32_t seq) { }
+
+static void tcp_ts_rtt_sample(struct tcp *conn) { }
+
+#endif
+
+/* Enable the options both ends agreed on in the SYN and SYN-ACK */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_SACK
+	conn->sack_ok = conn->recv_options.sack_perm_found;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	conn->ts_ok = conn->recv_options.ts_found;
+	if (conn->ts_ok) {
+		conn->ts_recent = conn->recv_options.tsval;
+	}
 #else
 	ARG_UNUSED(conn);
 #endif
@@ -998,10 +1087,29 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
+/* MSS and window scale are only carried by SYN segments and stay valid for
+ * the whole connection, the other options describe the segment they came in.
+ */
+static void tcp_options_reset(struct tcp_options *recv_options, bool syn)
+{
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+	}
+
+#ifdef CONFIG_NET_TCP_SACK
+	recv_options->sack_perm_found = false;
+	recv_options->sack_count = 0;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	recv_options->ts_found = false;
+#endif
+}
+
 static bool tcp_options_check(struct tcp_options *recv_options,
 			      struct net_pkt *pkt, ssize_t len)
 {
-	uint8_t options_buf[40]; /* TCP header max options size is 40 */
+	uint8_t options_buf[NET_TCP_MAX_OPT_SIZE];
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
 					   sizeof(options_buf));
@@ -1009,9 +1117,6 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
-
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
 
@@ -1059,6 +1164,51 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+#ifdef CONFIG_NET_TCP_SACK
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if (((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			/* Blocks that do not fit are ignored, the peer
+			 * reports them again in the following ACKs.
+			 */
+			recv_options->sack_count = MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+						       NET_TCP_SACK_MAX_BLOCKS);
+
+			for (int i = 0; i < recv_options->sack_count; i++) {
+				uint8_t *block = options + 2 + i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].left =
+					ntohl(UNALIGNED_GET((uint32_t *)block));
+				recv_options->sack[i].right =
+					ntohl(UNALIGNED_GET((uint32_t *)(block + 4)));
+			}
+			break;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+			recv_options->ts_found = true;
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1250,7 +1400,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1264,11 +1414,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_sport));
 	UNALIGNED_PUT(conn->dst.sin.sin_port, UNALIGNED_MEMBER_ADDR(th, th_dport));
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + options_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), UNALIGNED_MEMBER_ADDR(th, th_win));
@@ -1348,6 +1494,131 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &mss_opt_access);
 }
 
+/* The SACK permitted and timestamps options are offered in a SYN and only
+ * confirmed in a SYN-ACK if the peer offered them.
+ */
+static bool tcp_sack_perm_needed(struct tcp *conn, uint8_t flags)
+{
+#ifdef CONFIG_NET_TCP_SACK
+	return (flags & SYN) && (!(flags & ACK) || conn->sack_ok);
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(flags);
+
+	return false;
+#endif
+}
+
+static bool tcp_ts_needed(struct tcp *conn, uint8_t flags)
+{
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	return (flags == SYN) || conn->ts_ok;
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(flags);
+
+	return false;
+#endif
+}
+
+/* Report the out-of-order data held in the receive queue. The queue only
+ * ever holds one contiguous range, so a single SACK block is enough.
+ */
+static bool tcp_sack_block_needed(struct tcp *conn, uint8_t flags,
+				  struct tcp_sack_block *block)
+{
+#ifdef CONFIG_NET_TCP_SACK
+	if (!conn->sack_ok || (flags & (SYN | ACK)) != ACK ||
+	    !CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return false;
+	}
+
+	block->left = tcp_get_seq(conn->queue_recv_data->buffer);
+	block->right = block->left + net_pkt_get_len(conn->queue_recv_data);
+
+	return true;
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(flags);
+	ARG_UNUSED(block);
+
+	return false;
+#endif
+}
+
+static size_t tcp_options_len(struct tcp *conn, uint8_t flags)
+{
+	struct tcp_sack_block block;
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		len += NET_TCP_MSS_SIZE;
+	}
+
+	/* Options are padded with NOPs to keep 32-bit alignment */
+	if (tcp_sack_perm_needed(conn, flags)) {
+		len += 2 * NET_TCP_NOP_SIZE + NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (tcp_ts_needed(conn, flags)) {
+		len += 2 * NET_TCP_NOP_SIZE + NET_TCP_TIMESTAMP_SIZE;
+	}
+
+	if (tcp_sack_block_needed(conn, flags, &block)) {
+		len += 2 * NET_TCP_NOP_SIZE + 2 + NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	return len;
+}
+
+/* Add the options following the MSS option, see tcp_options_len() */
+static int tcp_options_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags)
+{
+	uint8_t buf[NET_TCP_MAX_OPT_SIZE];
+	struct tcp_sack_block block;
+	size_t len = 0;
+
+	if (tcp_sack_perm_needed(conn, flags)) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	if (tcp_ts_needed(conn, flags)) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_SIZE;
+		UNALIGNED_PUT(htonl(k_uptime_get_32()), (uint32_t *)&buf[len]);
+		len += sizeof(uint32_t);
+		/* Nothing to echo in the initial SYN */
+		UNALIGNED_PUT(htonl(conn->ts_ok ? conn->ts_recent : 0U),
+			      (uint32_t *)&buf[len]);
+		len += sizeof(uint32_t);
+	}
+#endif
+
+	if (tcp_sack_block_needed(conn, flags, &block)) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_SACK_OPT;
+		buf[len++] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		UNALIGNED_PUT(htonl(block.left), (uint32_t *)&buf[len]);
+		len += sizeof(uint32_t);
+		UNALIGNED_PUT(htonl(block.right), (uint32_t *)&buf[len]);
+		len += sizeof(uint32_t);
+	}
+
+	if (len == 0) {
+		return 0;
+	}
+
+	return net_pkt_write(pkt, buf, len);
+}
+
 static bool is_destination_local(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -1460,14 +1731,11 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	size_t options_len = tcp_options_len(conn, flags);
+	size_t alloc_len = sizeof(struct tcphdr) + options_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1477,6 +1745,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	if (data) {
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 		data->buffer = NULL;
 	}
 
@@ -1486,7 +1755,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -1500,6 +1769,12 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	ret = tcp_options_add(conn, pkt, flags);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1717,47 +1992,99 @@ static void tcp_setup_retransmission(struct tcp *conn)
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer, K_MSEC(TCP_RTO_MS));
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Max payload of a data segment, leaving room for the TCP options */
+static int tcp_segment_len_max(struct tcp *conn)
 {
-	int ret = 0;
-	int len;
-	struct net_pkt *pkt;
+	return conn_mss(conn) - (int)tcp_options_len(conn, PSH | ACK);
+}
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
-	if (len < 0) {
-		ret = len;
-		goto out;
+#ifdef CONFIG_NET_TCP_GSO
+/* Max payload of a data packet. Bulk data is sent in GSO packets of several
+ * segments, unless the peer is reached through the loopback path, which
+ * would never split them. Retransmissions, timed out or fast, and the data
+ * sent again after a partial ACK are never aggregated.
+ */
+static int tcp_send_len_max(struct tcp *conn)
+{
+	int seg_len = tcp_segment_len_max(conn);
+	sa_family_t family = net_context_get_family(conn->context);
+
+	if (tcp_send_cb != NULL || !net_if_gso_supported(conn->iface) ||
+	    conn->unacked_len < conn->sent_len) {
+		return seg_len;
 	}
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET &&
+	    (net_ipv4_is_addr_loopback(&conn->dst.sin.sin_addr) ||
+	     net_ipv4_is_my_addr(&conn->dst.sin.sin_addr))) {
+		return seg_len;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6 &&
+	    (net_ipv6_is_addr_loopback(&conn->dst.sin6.sin6_addr) ||
+	     net_ipv6_is_my_addr(&conn->dst.sin6.sin6_addr))) {
+		return seg_len;
+	}
+
+	/* The IP total length field must be able to hold the whole packet */
+	return MIN(seg_len * CONFIG_NET_TCP_GSO_MAX_SEGS,
+		   (UINT16_MAX - NET_IPV6TCPH_LEN - NET_TCP_MAX_OPT_SIZE) / seg_len * seg_len);
+}
+#else
+static int tcp_send_len_max(struct tcp *conn)
+{
+	return tcp_segment_len_max(conn);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+/* Send len bytes of send_data starting at offset from the unacknowledged
+ * sequence number.
+ */
+static int tcp_send_segment(struct tcp *conn, int offset, int len, bool resend)
+{
+	int seg_len = tcp_segment_len_max(conn);
+	struct net_pkt *pkt;
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_GSO) && len > seg_len) {
+		/* The buffer of a GSO packet is larger than the MTU, so the
+		 * allocation must not be capped by it.
+		 */
+		pkt = tcp_pkt_alloc(conn, 0);
+		if (pkt && net_pkt_alloc_buffer_raw(pkt, len, TCP_PKT_ALLOC_TIMEOUT) < 0) {
+			tcp_pkt_unref(pkt);
+			pkt = NULL;
+		}
+
+		if (pkt) {
+			net_pkt_set_gso_size(pkt, seg_len);
+		}
+	} else {
+		pkt = tcp_pkt_alloc(conn, len);
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
 	if (ret == 0) {
-		conn->unacked_len += len;
-
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (resend) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
+
+			for (int sent = 0; sent < len; sent += seg_len) {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
 		}
 	}
 
@@ -1767,12 +2094,215 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len;
+
+	len = MIN(tcp_unsent_len(conn), tcp_send_len_max(conn));
+	if (len < 0) {
+		ret = len;
+		goto out;
+	}
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == 0) {
+		conn->unacked_len += len;
+#ifdef CONFIG_NET_TCP_GSO
+		conn->sent_len = MAX(conn->sent_len, conn->unacked_len);
+#endif
+	}
+
 	conn_send_data_dump(conn);
 
  out:
 	return ret;
 }
 
+#ifdef CONFIG_NET_TCP_SACK
+/* Merge a SACK block received from the peer into the scoreboard. The
+ * scoreboard is kept sorted and its blocks never overlap.
+ */
+static void tcp_sack_scoreboard_add(struct tcp *conn, uint32_t left, uint32_t right)
+{
+	struct tcp_sack_block *sb = conn->sack_sb;
+	uint8_t count = conn->sack_sb_count;
+	uint8_t i;
+
+	/* Ignore D-SACK reports and blocks outside the sent data, queued data
+	 * not sent yet cannot have been received by the peer.
+	 */
+	if (net_tcp_seq_cmp(right, left) <= 0 ||
+	    net_tcp_seq_cmp(left, conn->seq) <= 0 ||
+	    net_tcp_seq_cmp(right, conn->seq + conn->unacked_len) > 0) {
+		return;
+	}
+
+	for (i = 0; i < count; ) {
+		if (net_tcp_seq_cmp(sb[i].left, right) <= 0 &&
+		    net_tcp_seq_cmp(left, sb[i].right) <= 0) {
+			if (net_tcp_seq_cmp(sb[i].left, left) < 0) {
+				left = sb[i].left;
+			}
+
+			if (net_tcp_seq_cmp(sb[i].right, right) > 0) {
+				right = sb[i].right;
+			}
+
+			count--;
+			memmove(&sb[i], &sb[i + 1], (count - i) * sizeof(*sb));
+			continue;
+		}
+
+		i++;
+	}
+
+	for (i = 0; i < count && net_tcp_seq_cmp(sb[i].left, left) < 0; i++) {
+	}
+
+	if (count == NET_TCP_SACK_SCOREBOARD_SIZE) {
+		/* Keep the blocks closest to the cumulative ACK, the holes
+		 * in front of them are the ones retransmitted first.
+		 */
+		if (i == count) {
+			goto out;
+		}
+
+		count--;
+	}
+
+	memmove(&sb[i + 1], &sb[i], (count - i) * sizeof(*sb));
+	sb[i].left = left;
+	sb[i].right = right;
+	count++;
+out:
+	conn->sack_sb_count = count;
+}
+
+static void tcp_sack_update(struct tcp *conn)
+{
+	for (int i = 0; i < conn->recv_options.sack_count; i++) {
+		tcp_sack_scoreboard_add(conn, conn->recv_options.sack[i].left,
+					conn->recv_options.sack[i].right);
+	}
+}
+
+/* Drop the blocks covered by the cumulative ACK */
+static void tcp_sack_scoreboard_prune(struct tcp *conn)
+{
+	struct tcp_sack_block *sb = conn->sack_sb;
+	uint8_t i = 0;
+
+	while (i < conn->sack_sb_count &&
+	       net_tcp_seq_cmp(sb[i].right, conn->seq) <= 0) {
+		i++;
+	}
+
+	conn->sack_sb_count -= i;
+	memmove(&sb[0], &sb[i], conn->sack_sb_count * sizeof(*sb));
+
+	if (conn->sack_sb_count > 0 &&
+	    net_tcp_seq_cmp(sb[0].left, conn->seq) < 0) {
+		sb[0].left = conn->seq;
+	}
+
+	if (conn->sack_sb_count == 0) {
+		conn->sack_recovery = false;
+	}
+}
+
+static void tcp_sack_scoreboard_clear(struct tcp *conn)
+{
+	conn->sack_sb_count = 0;
+	conn->sack_recovery = false;
+}
+
+/* Retransmit the holes between the SACKed blocks which have not been
+ * retransmitted yet during this recovery. A burst sends no more than the
+ * send and congestion windows allow.
+ */
+static void tcp_sack_retransmit(struct tcp *conn)
+{
+	struct tcp_sack_block *sb = conn->sack_sb;
+	uint32_t next = conn->sack_rexmit_next;
+	int burst = TCP_SACK_REXMIT_BURST;
+	int window = conn->send_win;
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	window = MIN(window, conn->ca.cwnd);
+#endif
+
+	if (net_tcp_seq_cmp(next, conn->seq) < 0) {
+		next = conn->seq;
+	}
+
+	for (int i = 0; i < conn->sack_sb_count; i++) {
+		while (net_tcp_seq_cmp(next, sb[i].left) < 0) {
+			int len = MIN((int)(sb[i].left - next), tcp_segment_len_max(conn));
+
+			len = MIN(len, window);
+			if (burst-- == 0 || len <= 0 ||
+			    tcp_send_segment(conn, next - conn->seq, len, true) < 0) {
+				goto out;
+			}
+
+			window -= len;
+			next += len;
+		}
+
+		if (net_tcp_seq_cmp(next, sb[i].right) < 0) {
+			next = sb[i].right;
+		}
+	}
+out:
+	conn->sack_rexmit_next = next;
+}
+
+/* Enter fast recovery, returns false if the scoreboard is empty and the
+ * regular fast retransmit should be done instead.
+ */
+static bool tcp_sack_recovery_start(struct tcp *conn)
+{
+	if (!conn->sack_ok || conn->sack_sb_count == 0) {
+		return false;
+	}
+
+	conn->sack_recovery = true;
+	conn->sack_rexmit_next = conn->seq;
+	tcp_sack_retransmit(conn);
+
+	return true;
+}
+
+static void tcp_sack_recovery_continue(struct tcp *conn)
+{
+	if (conn->sack_recovery) {
+		tcp_sack_retransmit(conn);
+	}
+}
+#else
+
+static void tcp_sack_update(struct tcp *conn) { }
+
+static void tcp_sack_scoreboard_prune(struct tcp *conn) { }
+
+static void tcp_sack_scoreboard_clear(struct tcp *conn) { }
+
+static bool tcp_sack_recovery_start(struct tcp *conn) { return false; }
+
+static void tcp_sack_recovery_continue(struct tcp *conn) { }
+
+#endif
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1871,6 +2401,9 @@ static void tcp_resend_data(struct k_work *work)
 			}
 		}
 
+		/* The peer may have dropped the data it SACKed, RFC2018 ch 8 */
+		tcp_sack_scoreboard_clear(conn);
+
 		conn->data_mode = TCP_DATA_MODE_RESEND;
 		conn->unacked_len = 0;
 
@@ -2900,6 +3433,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	tcp_options_reset(&conn->recv_options, th_flags(th) & SYN);
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2959,6 +3494,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	/* Both the seqnum and the acknum are valid, then do processing. */
+	tcp_ts_recent_update(conn, th_seq(th));
+
 	conn->send_win = ntohs(th_win(th));
 	if (conn->send_win > conn->send_win_max) {
 		NET_DBG("Lowering send window from %u to %u", conn->send_win, conn->send_win_max);
@@ -2986,6 +3523,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			tcp_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
@@ -3101,6 +3639,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			k_work_cancel_delayable(&conn->send_data_timer);
+			tcp_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3174,6 +3713,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		keep_alive_timer_restart(conn);
 
+		tcp_sack_update(conn);
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3194,20 +3735,28 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				/* With SACK only the holes are retransmitted,
+				 * otherwise apply a fast retransmit.
+				 */
+				if (!tcp_sack_recovery_start(conn)) {
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
+			} else if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+				   (conn->dup_ack_cnt > DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
+				/* Further duplicate ACKs may report new holes */
+				tcp_sack_recovery_continue(conn);
 			}
 		}
 #endif
@@ -3246,6 +3795,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			} else {
 				conn->unacked_len -= len_acked;
 			}
+#ifdef CONFIG_NET_TCP_GSO
+			conn->sent_len = MAX(conn->sent_len - (int)len_acked, 0);
+#endif
 
 			if (!tcp_window_full(conn)) {
 				k_sem_give(&conn->tx_sem);
@@ -3254,6 +3806,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+			tcp_ts_rtt_sample(conn);
+			tcp_sack_scoreboard_prune(conn);
+
 			/* Receipt of an acknowledgment that covers a sequence number
 			 * not previously acknowledged indicates that the connection
 			 * makes a "forward progress".
@@ -3271,6 +3826,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				tcp_setup_retransmission(conn);
 			}
 
+			/* A partial ACK during recovery, fill the next holes */
+			tcp_sack_recovery_continue(conn);
+
 			/* We are closing the connection, send a FIN to peer */
 			if (conn->in_close && conn->send_data_total == 0) {
 				next = TCP_FIN_WAIT_1;
@@ -4085,6 +4643,11 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
+	/* GSO packets are checksummed after they are split into segments */
+	if (net_pkt_gso_size(pkt) > 0U) {
+		return net_pkt_set_data(pkt, &tcp_access);
+	}
+
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
@@ -229,18 +229,54 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* TCP header max options size */
+#define NET_TCP_MAX_OPT_SIZE      40
+
+/* Max number of SACK blocks handled per segment, this many still fit
+ * next to the timestamps option.
+ */
+#define NET_TCP_SACK_MAX_BLOCKS   3
+
+/* Number of SACKed ranges remembered by the sender */
+#define NET_TCP_SACK_SCOREBOARD_SIZE 4
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_count;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+#ifdef CONFIG_NET_TCP_SACK
+	bool sack_perm_found : 1;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	bool ts_found : 1;
+#endif
 };
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
@@ -304,6 +340,10 @@ struct tcp { /* TCP connection */
 #endif
 	size_t send_data_total;
 	int unacked_len;
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Length of send_data sent at least once, retransmitted segment by segment */
+	int sent_len;
+#endif
 	atomic_t ref_count;
 	enum tcp_state state;
 	enum tcp_data_mode data_mode;
@@ -320,9 +360,19 @@ struct tcp { /* TCP connection */
 	uint16_t recv_win;
 	uint16_t send_win_max;
 	uint16_t send_win;
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 	uint16_t rto;
 #endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	uint32_t ts_recent;
+	uint16_t srtt;   /* smoothed round-trip time in ms */
+	uint16_t rttvar; /* round-trip time variation in ms */
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	struct tcp_sack_block sack_sb[NET_TCP_SACK_SCOREBOARD_SIZE];
+	uint32_t sack_rexmit_next;
+	uint8_t sack_sb_count;
+#endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 	struct tcp_collision_avoidance_reno ca;
 #endif
@@ -339,6 +389,14 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#ifdef CONFIG_NET_TCP_SACK
+	bool sack_ok : 1;
+	bool sack_recovery : 1;
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	bool ts_ok : 1;
+	bool rtt_measured : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/net/net_pkt.h>
 #include <zephyr/internal/syscall_handler.h>
 
 #include "sockets_internal.h"
@@ -710,6 +711,256 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t bytes_sent;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, sendmsg, sock,
+						&msgvec[i].msg_hdr, flags);
+
+		bytes_sent = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, sendmsg, sock,
+					       bytes_sent < 0 ? -errno : bytes_sent);
+
+		sock_obj_core_update_send_stats(sock, bytes_sent);
+
+		if (bytes_sent < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = bytes_sent;
+	}
+
+	k_mutex_unlock(lock);
+
+	/* The error is only reported if nothing was sent */
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int msg_len;
+	unsigned int i;
+	ssize_t ret;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(struct mmsghdr)));
+
+	/* Every message needs to be copied from user space anyway, so there
+	 * is no benefit in holding the socket lock over the whole batch.
+	 */
+	for (i = 0; i < vlen; i++) {
+		ret = z_vrfy_zsock_sendmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msg_len = ret;
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &msg_len,
+					  sizeof(msg_len)));
+	}
+
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return i;
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t bytes_received;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		int msg_flags = flags & ~ZSOCK_MSG_WAITFORONE;
+
+		if (i > 0 && (flags & ZSOCK_MSG_WAITFORONE)) {
+			msg_flags |= ZSOCK_MSG_DONTWAIT;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, recvmsg, sock,
+						&msgvec[i].msg_hdr, msg_flags);
+
+		bytes_received = vtable->recvmsg(obj, &msgvec[i].msg_hdr, msg_flags);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, recvmsg, sock, &msgvec[i].msg_hdr,
+					       bytes_received < 0 ? -errno : bytes_received);
+
+		sock_obj_core_update_recv_stats(sock, bytes_received);
+
+		if (bytes_received < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = bytes_received;
+	}
+
+	k_mutex_unlock(lock);
+
+	/* The error is only reported if nothing was received */
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int msg_len;
+	unsigned int i;
+	ssize_t ret;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(struct mmsghdr)));
+
+	/* See z_vrfy_zsock_sendmmsg(), each message is received separately */
+	for (i = 0; i < vlen; i++) {
+		int msg_flags = flags & ~ZSOCK_MSG_WAITFORONE;
+
+		if (i > 0 && (flags & ZSOCK_MSG_WAITFORONE)) {
+			msg_flags |= ZSOCK_MSG_DONTWAIT;
+		}
+
+		ret = z_vrfy_zsock_recvmsg(sock, &msgvec[i].msg_hdr, msg_flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msg_len = ret;
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len, &msg_len,
+					  sizeof(msg_len)));
+	}
+
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return i;
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+ssize_t z_impl_zsock_recvmsg_zc(int sock, struct msghdr *msg, void **handle,
+				int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	ssize_t ret;
+	void *obj;
+
+	if (handle == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*handle = NULL;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, recvmsg, sock, msg, flags);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zvfs_fdtable_call_ioctl(&vtable->fd_vtable, obj, ZFD_IOCTL_RECV_ZC,
+				      msg, handle, flags);
+
+	k_mutex_unlock(lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, recvmsg, sock, msg,
+				       ret < 0 ? -errno : ret);
+
+	if (ret < 0 && errno == EOPNOTSUPP) {
+		/* Zero-copy is not supported by this socket, copy the data */
+		if (msg != NULL) {
+			msg->msg_flags = 0;
+		}
+
+		return z_impl_zsock_recvmsg(sock, msg, flags);
+	}
+
+	sock_obj_core_update_recv_stats(sock, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline ssize_t z_vrfy_zsock_recvmsg_zc(int sock, struct msghdr *msg,
+					      void **handle, int flags)
+{
+	void *no_handle = NULL;
+
+	/* Network buffers are not accessible from user mode, so the data is
+	 * always copied to the buffers given by the caller.
+	 */
+	K_OOPS(k_usermode_to_copy(handle, &no_handle, sizeof(no_handle)));
+
+	return z_vrfy_zsock_recvmsg(sock, msg, flags);
+}
+#include <zephyr/syscalls/zsock_recvmsg_zc_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+void zsock_recvmsg_zc_release(void *handle)
+{
+	if (handle == NULL) {
+		return;
+	}
+
+#if defined(CONFIG_NET_SOCKETS_RECV_ZEROCOPY)
+	net_pkt_unref(handle);
+#endif
+}
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1107,6 +1107,40 @@ static int update_msg_controllen(struct msghdr *msg)
 	return 0;
 }
 
+static int sock_fill_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+			      struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		ret = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
+			return ret;
+		}
+	} else {
+		ret = sock_get_pkt_src_addr(ctx, pkt, src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_pkt_src_addr %d", ret);
+			return ret;
+		}
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
 static ssize_t zsock_recv_dgram(struct net_context *ctx,
 				struct msghdr *msg,
 				void *buf,
@@ -1158,37 +1192,11 @@ static ssize_t zsock_recv_dgram(struct net_context *ctx,
 	net_pkt_cursor_backup(pkt, &backup);
 
 	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			int ret;
-
-			ret  = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr,
-								*addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		} else {
-			int ret;
-
-			ret = sock_get_pkt_src_addr(ctx, pkt, src_addr, *addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		}
+		int ret;
 
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
+		ret = sock_fill_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			errno = -ret;
 			goto fail;
 		}
 	}
@@ -1567,6 +1575,215 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 	return -1;
 }
 
+#if defined(CONFIG_NET_SOCKETS_RECV_ZEROCOPY)
+/* Point the msg iovecs to the unread data of the packet, starting from the
+ * current cursor position. Returns the number of bytes lent, and sets
+ * ZSOCK_MSG_TRUNC if the iovecs could not describe all the data.
+ */
+static size_t zsock_recv_zc_lend(struct net_pkt *pkt, struct msghdr *msg)
+{
+	size_t remaining = net_pkt_remaining_data(pkt);
+	struct net_buf *frag = pkt->cursor.buf;
+	size_t offset = (frag != NULL) ? pkt->cursor.pos - frag->data : 0;
+	size_t lent = 0;
+	size_t iovec = 0;
+
+	while (frag != NULL && remaining > 0 && iovec < msg->msg_iovlen) {
+		size_t len = MIN(frag->len - offset, remaining);
+
+		if (len > 0) {
+			msg->msg_iov[iovec].iov_base = frag->data + offset;
+			msg->msg_iov[iovec].iov_len = len;
+			iovec++;
+		}
+
+		lent += len;
+		remaining -= len;
+		frag = frag->frags;
+		offset = 0;
+	}
+
+	msg->msg_iovlen = iovec;
+
+	if (remaining > 0) {
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
+	}
+
+	return lent;
+}
+
+static ssize_t zsock_recv_zc_dgram(struct net_context *ctx, struct msghdr *msg,
+				   void **handle, int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t recv_len;
+	size_t lent;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		int ret;
+
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (pkt == NULL) {
+		return -EAGAIN;
+	}
+
+	if (msg->msg_name != NULL && msg->msg_namelen > 0) {
+		int ret;
+
+		ret = sock_fill_src_addr(ctx, pkt, msg->msg_name, &msg->msg_namelen);
+		if (ret < 0) {
+			net_pkt_unref(pkt);
+			return ret;
+		}
+	}
+
+	recv_len = net_pkt_remaining_data(pkt);
+	lent = zsock_recv_zc_lend(pkt, msg);
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+	    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	/* The reference taken by the receive queue is handed over to the caller */
+	*handle = pkt;
+
+	return (flags & ZSOCK_MSG_TRUNC) ? recv_len : lent;
+}
+
+static ssize_t zsock_recv_zc_stream(struct net_context *ctx, struct msghdr *msg,
+				    void **handle, int flags)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	k_timepoint_t end;
+	size_t lent;
+	int ret;
+
+	if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+		return -ENOTCONN;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (!sock_is_eof(ctx) && !sock_is_error(ctx)) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	for (end = sys_timepoint_calc(timeout); ; timeout = sys_timepoint_timeout(end)) {
+		if (sock_is_error(ctx)) {
+			return -POINTER_TO_INT(ctx->user_data);
+		}
+
+		if (sock_is_eof(ctx)) {
+			msg->msg_iovlen = 0;
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = zsock_wait_data(ctx, &timeout);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (pkt == NULL) {
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				return -EAGAIN;
+			}
+
+			continue;
+		}
+
+		if (net_pkt_remaining_data(pkt) > 0) {
+			break;
+		}
+
+		/* Packets without data are only carrying the EOF indication */
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		net_pkt_unref(pkt);
+	}
+
+	/* Only the data of the first queued packet is lent, so that the
+	 * caller never needs more than one handle per call.
+	 */
+	lent = zsock_recv_zc_lend(pkt, msg);
+	msg->msg_flags &= ~ZSOCK_MSG_TRUNC;
+
+	if (net_pkt_remaining_data(pkt) == lent) {
+		pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+		    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+	} else {
+		/* Rest of the packet stays queued for the next read */
+		net_pkt_ref(pkt);
+		net_pkt_skip(pkt, lent);
+	}
+
+	*handle = pkt;
+
+	net_context_update_recv_wnd(ctx, lent);
+
+	return lent;
+}
+
+static ssize_t zsock_recv_zc_ctx(struct net_context *ctx, struct msghdr *msg,
+				 void **handle, int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	sa_family_t family = net_context_get_family(ctx);
+
+	if (msg == NULL || handle == NULL || msg->msg_iov == NULL ||
+	    msg->msg_iovlen < 1) {
+		return -EINVAL;
+	}
+
+	/* Packet and CAN sockets forward the ioctls they don't handle here */
+	if (family != AF_INET && family != AF_INET6) {
+		return -EOPNOTSUPP;
+	}
+
+	/* Lent data is owned by the caller, let these fall back to copying */
+	if (flags & (ZSOCK_MSG_PEEK | ZSOCK_MSG_WAITALL)) {
+		return -EOPNOTSUPP;
+	}
+
+	*handle = NULL;
+	msg->msg_controllen = 0U;
+	msg->msg_flags = 0;
+
+	if (sock_type == SOCK_DGRAM || sock_type == SOCK_RAW) {
+		return zsock_recv_zc_dgram(ctx, msg, handle, flags);
+	} else if (sock_type == SOCK_STREAM) {
+		return zsock_recv_zc_stream(ctx, msg, handle, flags);
+	}
+
+	return -EOPNOTSUPP;
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_ZEROCOPY */
+
 static int zsock_poll_prepare_ctx(struct net_context *ctx,
 				  struct zsock_pollfd *pfd,
 				  struct k_poll_event **pev,
@@ -3070,6 +3287,27 @@ static int sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		return 0;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_RECV_ZEROCOPY)
+	case ZFD_IOCTL_RECV_ZC: {
+		struct msghdr *msg;
+		void **handle;
+		ssize_t ret;
+		int flags;
+
+		msg = va_arg(args, struct msghdr *);
+		handle = va_arg(args, void **);
+		flags = va_arg(args, int);
+
+		ret = zsock_recv_zc_ctx(obj, msg, handle, flags);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+
+		return ret;
+	}
+#endif
+
 	default:
 		errno = EOPNOTSUPP;
 		return -1;
@@ -0,0 +1,398 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_sock_rtio, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+#include <zephyr/zvfs/eventfd.h>
+
+/* Protects the list of attached sockets and the operations taken from
+ * their queues.  Held by the poller thread while it processes the
+ * sockets, but not while it waits for them.
+ */
+static K_MUTEX_DEFINE(lock);
+static sys_slist_t sockets = SYS_SLIST_STATIC_INIT(&sockets);
+static int num_sockets;
+
+static int wake_fd = -1;
+static atomic_t wake_pending;
+
+static struct zsock_pollfd events[CONFIG_NET_SOCKETS_RTIO_MAX + 1];
+static struct net_socket_rtio *polled[CONFIG_NET_SOCKETS_RTIO_MAX + 1];
+
+static void wake_poller(void)
+{
+	/* A single event is enough until the poller runs again */
+	if (!atomic_set(&wake_pending, 1) && (wake_fd >= 0)) {
+		(void)zvfs_eventfd_write(wake_fd, 1);
+	}
+}
+
+static struct rtio_iodev_sqe *queue_peek(struct mpsc *q, struct rtio_iodev_sqe **curr)
+{
+	if (*curr == NULL) {
+		struct mpsc_node *node = mpsc_pop(q);
+
+		if (node != NULL) {
+			*curr = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+		}
+	}
+
+	return *curr;
+}
+
+/* Complete the canceled operations at the head of a queue, returns
+ * true if an operation is still pending.
+ */
+static bool queue_pending(struct mpsc *q, struct rtio_iodev_sqe **curr)
+{
+	struct rtio_iodev_sqe *iodev_sqe;
+
+	while ((iodev_sqe = queue_peek(q, curr)) != NULL) {
+		if ((iodev_sqe->sqe.flags & RTIO_SQE_CANCELED) == 0U) {
+			return true;
+		}
+
+		*curr = NULL;
+		rtio_iodev_sqe_err(iodev_sqe, -ECANCELED);
+	}
+
+	return false;
+}
+
+static bool rx_pending(struct net_socket_rtio *ctx)
+{
+	return queue_pending(&ctx->rx_q, &ctx->rx_curr);
+}
+
+static bool tx_pending(struct net_socket_rtio *ctx)
+{
+	return queue_pending(&ctx->tx_q, &ctx->tx_curr);
+}
+
+static void complete(struct rtio_iodev_sqe *iodev_sqe, int result)
+{
+	if (result < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, result);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, result);
+	}
+}
+
+/* Returns -EAGAIN if the socket is not ready */
+static int do_rx(struct net_socket_rtio *ctx, struct rtio_iodev_sqe *iodev_sqe)
+{
+	uint8_t *buf;
+	uint32_t buf_len;
+	ssize_t ret;
+
+	ret = rtio_sqe_rx_buf(iodev_sqe, 1, CONFIG_NET_SOCKETS_RTIO_POOL_RX_SIZE, &buf, &buf_len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = zsock_recv(ctx->sock, buf, buf_len, ZSOCK_MSG_DONTWAIT);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	return (int)ret;
+}
+
+/* Returns -EAGAIN if the socket is not ready */
+static int do_tx(struct net_socket_rtio *ctx, struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	ssize_t ret;
+
+	if (sqe->op == RTIO_OP_TINY_TX) {
+		ret = zsock_send(ctx->sock, sqe->tiny_tx.buf, sqe->tiny_tx.buf_len,
+				 ZSOCK_MSG_DONTWAIT);
+	} else {
+		ret = zsock_send(ctx->sock, sqe->tx.buf, sqe->tx.buf_len, ZSOCK_MSG_DONTWAIT);
+	}
+
+	if (ret < 0) {
+		return -errno;
+	}
+
+	return (int)ret;
+}
+
+static void process_rx(struct net_socket_rtio *ctx)
+{
+	struct rtio_iodev_sqe *iodev_sqe;
+	int ret;
+
+	while ((iodev_sqe = queue_peek(&ctx->rx_q, &ctx->rx_curr)) != NULL) {
+		if ((iodev_sqe->sqe.flags & RTIO_SQE_CANCELED) != 0U) {
+			ret = -ECANCELED;
+		} else {
+			ret = do_rx(ctx, iodev_sqe);
+		}
+
+		if ((ret == -EAGAIN) || (ret == -EWOULDBLOCK)) {
+			break;
+		}
+
+		ctx->rx_curr = NULL;
+
+		/* A multishot read would receive the end of the stream
+		 * forever: end it as an error does.
+		 */
+		if ((ret == 0) && ((iodev_sqe->sqe.flags & RTIO_SQE_MULTISHOT) != 0U)) {
+			rtio_iodev_sqe_err(iodev_sqe, 0);
+		} else {
+			complete(iodev_sqe, ret);
+		}
+	}
+}
+
+static void process_tx(struct net_socket_rtio *ctx)
+{
+	struct rtio_iodev_sqe *iodev_sqe;
+	int ret;
+
+	while ((iodev_sqe = queue_peek(&ctx->tx_q, &ctx->tx_curr)) != NULL) {
+		if ((iodev_sqe->sqe.flags & RTIO_SQE_CANCELED) != 0U) {
+			ret = -ECANCELED;
+		} else {
+			ret = do_tx(ctx, iodev_sqe);
+		}
+
+		if ((ret == -EAGAIN) || (ret == -EWOULDBLOCK)) {
+			break;
+		}
+
+		ctx->tx_curr = NULL;
+		complete(iodev_sqe, ret);
+	}
+}
+
+static void cancel_all(struct mpsc *q, struct rtio_iodev_sqe **curr)
+{
+	struct rtio_iodev_sqe *iodev_sqe;
+
+	while ((iodev_sqe = queue_peek(q, curr)) != NULL) {
+		*curr = NULL;
+		rtio_iodev_sqe_err(iodev_sqe, -ECANCELED);
+	}
+}
+
+static void net_socket_rtio_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct net_socket_rtio *ctx = iodev_sqe->sqe.iodev->data;
+	int ret = 0;
+
+	/* Not racing with a detach, which completes the queued operations */
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (ctx->sock < 0) {
+		ret = -EBADF;
+	} else if (iodev_sqe->sqe.op == RTIO_OP_RX) {
+		mpsc_push(&ctx->rx_q, &iodev_sqe->q);
+	} else if ((iodev_sqe->sqe.op == RTIO_OP_TX) || (iodev_sqe->sqe.op == RTIO_OP_TINY_TX)) {
+		mpsc_push(&ctx->tx_q, &iodev_sqe->q);
+	} else {
+		ret = -ENOTSUP;
+	}
+
+	k_mutex_unlock(&lock);
+
+	if (ret < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+		return;
+	}
+
+	wake_poller();
+}
+
+const struct rtio_iodev_api net_socket_rtio_api = {
+	.submit = net_socket_rtio_submit,
+};
+
+int net_socket_rtio_attach(struct rtio_iodev *iodev, int sock)
+{
+	struct net_socket_rtio *ctx = iodev->data;
+	int ret = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (ctx->sock >= 0) {
+		ret = -EBUSY;
+	} else if (num_sockets >= CONFIG_NET_SOCKETS_RTIO_MAX) {
+		ret = -ENOMEM;
+	} else {
+		ctx->sock = sock;
+		sys_slist_append(&sockets, &ctx->node);
+		num_sockets++;
+	}
+
+	k_mutex_unlock(&lock);
+
+	if (ret == 0) {
+		/* Operations may have been submitted before */
+		wake_poller();
+	}
+
+	return ret;
+}
+
+int net_socket_rtio_detach(struct rtio_iodev *iodev)
+{
+	struct net_socket_rtio *ctx = iodev->data;
+	int ret = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (ctx->sock < 0) {
+		ret = -EALREADY;
+	} else {
+		(void)sys_slist_find_and_remove(&sockets, &ctx->node);
+		num_sockets--;
+		ctx->sock = -1;
+
+		cancel_all(&ctx->rx_q, &ctx->rx_curr);
+		cancel_all(&ctx->tx_q, &ctx->tx_curr);
+	}
+
+	k_mutex_unlock(&lock);
+
+	if (ret == 0) {
+		/* Stop polling the socket */
+		wake_poller();
+	}
+
+	return ret;
+}
+
+/* Prepare the poll events of the sockets with pending operations,
+ * completing the canceled ones.
+ */
+static int prepare_events(void)
+{
+	struct net_socket_rtio *ctx;
+	int count = 1;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&sockets, ctx, node) {
+		short ev = 0;
+
+		if (rx_pending(ctx)) {
+			ev |= ZSOCK_POLLIN;
+		}
+		if (tx_pending(ctx)) {
+			ev |= ZSOCK_POLLOUT;
+		}
+		if (ev == 0) {
+			continue;
+		}
+
+		events[count].fd = ctx->sock;
+		events[count].events = ev;
+		events[count].revents = 0;
+		polled[count] = ctx;
+		count++;
+	}
+
+	k_mutex_unlock(&lock);
+
+	return count;
+}
+
+static void process_events(int count)
+{
+	k_mutex_lock(&lock, K_FOREVER);
+
+	for (int i = 1; i < count; i++) {
+		struct net_socket_rtio *ctx = polled[i];
+
+		/* Detached, or attached to another socket, while polled */
+		if ((events[i].revents == 0) || (ctx->sock != events[i].fd)) {
+			continue;
+		}
+
+		/* Errors are reported by the operations themselves */
+		if ((events[i].revents & ~ZSOCK_POLLOUT) != 0) {
+			process_rx(ctx);
+		}
+		if ((events[i].revents & ~ZSOCK_POLLIN) != 0) {
+			process_tx(ctx);
+		}
+	}
+
+	k_mutex_unlock(&lock);
+}
+
+static void socket_rtio_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zvfs_eventfd_t value;
+	int timeout;
+	int count;
+	int ret;
+
+	wake_fd = zvfs_eventfd(0, 0);
+	if (wake_fd < 0) {
+		NET_ERR("zvfs_eventfd failed (%d)", -errno);
+		return;
+	}
+
+	events[0].fd = wake_fd;
+	events[0].events = ZSOCK_POLLIN;
+
+	while (true) {
+		/* Submissions from now on wake the poller up again */
+		atomic_clear(&wake_pending);
+
+		count = prepare_events();
+
+		/* RTIO does not tell iodevs about canceled operations: check
+		 * for them periodically while some are pending.
+		 */
+		timeout = (count > 1) ? CONFIG_NET_SOCKETS_RTIO_CANCEL_CHECK_MS : -1;
+
+		ret = zsock_poll(events, count, timeout);
+		if (ret < 0) {
+			NET_ERR("poll failed (%d)", -errno);
+			break;
+		}
+
+		if ((events[0].revents & ZSOCK_POLLIN) != 0) {
+			(void)zvfs_eventfd_read(wake_fd, &value);
+		}
+
+		process_events(count);
+	}
+}
+
+static int init_socket_rtio(void)
+{
+	static struct k_thread thread;
+	static K_THREAD_STACK_DEFINE(thread_stack, CONFIG_NET_SOCKETS_RTIO_STACK_SIZE);
+	k_tid_t tid;
+
+	tid = k_thread_create(&thread, thread_stack, K_THREAD_STACK_SIZEOF(thread_stack),
+			      socket_rtio_thread, NULL, NULL, NULL,
+			      CLAMP(CONFIG_NET_SOCKETS_RTIO_THREAD_PRIO,
+				    K_HIGHEST_APPLICATION_THREAD_PRIO,
+				    K_LOWEST_APPLICATION_THREAD_PRIO), 0, K_NO_WAIT);
+
+	k_thread_name_set(tid, "net_socket_rtio");
+
+	return 0;
+}
+
+SYS_INIT(init_socket_rtio, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -30,6 +30,9 @@ LOG_MODULE_DECLARE(net_zperf, CONFIG_NET_ZPERF_LOG_LEVEL);
 
 #define TCP_RECEIVER_BUF_SIZE 1500
 
+/* Number of network buffer fragments lent per zero-copy receive call */
+#define TCP_RECEIVER_ZC_IOV_COUNT 8
+
 static zperf_callback tcp_session_cb;
 static void *tcp_user_data;
 static bool tcp_server_running;
@@ -121,9 +124,33 @@ static void tcp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_TCP);
 }
 
-static int tcp_recv_data(struct net_socket_service_event *pev)
+static ssize_t tcp_recv(int sock)
 {
 	static uint8_t buf[TCP_RECEIVER_BUF_SIZE];
+
+#if defined(CONFIG_NET_ZPERF_RECV_ZEROCOPY)
+	struct iovec iov[TCP_RECEIVER_ZC_IOV_COUNT] = {
+		/* Only used if the data needs to be copied after all */
+		{ .iov_base = buf, .iov_len = sizeof(buf) },
+	};
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = ARRAY_SIZE(iov),
+	};
+	void *handle;
+	ssize_t ret;
+
+	ret = zsock_recvmsg_zc(sock, &msg, &handle, 0);
+	zsock_recvmsg_zc_release(handle);
+
+	return ret;
+#else
+	return zsock_recv(sock, buf, sizeof(buf), 0);
+#endif
+}
+
+static int tcp_recv_data(struct net_socket_service_event *pev)
+{
 	int i, ret = 0;
 	int family, sock, sock_error;
 	struct sockaddr addr_incoming_conn;
@@ -189,7 +216,7 @@ static int tcp_recv_data(struct net_socket_service_event *pev)
 		}
 
 	} else {
-		ret = zsock_recv(pev->event.fd, buf, sizeof(buf), 0);
+		ret = tcp_recv(pev->event.fd);
 		if (ret < 0) {
 			(void)zsock_getsockopt(pev->event.fd, SOL_SOCKET,
 					       SO_DOMAIN, &family, &optlen);
@@ -19,6 +19,12 @@ static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
 			     sizeof(struct zperf_client_hdr_v1) +
 			     PACKET_SIZE_MAX];
 
+/* In batch mode each datagram gets its own header, the payload is shared */
+static uint8_t batch_hdr[CONFIG_NET_ZPERF_UDP_BATCH_MAX]
+			[sizeof(struct zperf_udp_datagram) + sizeof(struct zperf_client_hdr_v1)];
+static struct iovec batch_iov[CONFIG_NET_ZPERF_UDP_BATCH_MAX][2];
+static struct mmsghdr batch_msg[CONFIG_NET_ZPERF_UDP_BATCH_MAX];
+
 #if !defined(CONFIG_ZPERF_SESSION_PER_THREAD)
 static struct zperf_async_upload_context udp_async_upload_ctx;
 #endif /* CONFIG_ZPERF_SESSION_PER_THREAD */
@@ -155,6 +161,55 @@ static inline int zperf_upload_fin(int sock,
 	return 0;
 }
 
+static void udp_header_fill(uint8_t *buf, uint32_t id, uint32_t secs, uint32_t usecs,
+			    int port, uint32_t rate_in_kbps, uint32_t packet_size)
+{
+	struct zperf_udp_datagram *datagram;
+	struct zperf_client_hdr_v1 *hdr;
+
+	datagram = (struct zperf_udp_datagram *)buf;
+
+	datagram->id = htonl(id);
+	datagram->tv_sec = htonl(secs);
+	datagram->tv_usec = htonl(usecs);
+
+	hdr = (struct zperf_client_hdr_v1 *)(buf + sizeof(*datagram));
+	hdr->flags = 0;
+	hdr->num_of_threads = htonl(1);
+	hdr->port = htonl(port);
+	hdr->buffer_len = sizeof(sample_packet) -
+		sizeof(*datagram) - sizeof(*hdr);
+	hdr->bandwidth = htonl(rate_in_kbps);
+	hdr->num_of_bytes = htonl(packet_size);
+}
+
+/* Send batch datagrams with a single zsock_sendmmsg() call, returns the
+ * number of datagrams sent.
+ */
+static int udp_send_batch(int sock, uint32_t nb_packets, uint32_t batch,
+			  uint32_t secs, uint32_t usecs, int port,
+			  uint32_t rate_in_kbps, uint32_t packet_size)
+{
+	size_t header_size = sizeof(batch_hdr[0]);
+
+	for (uint32_t i = 0; i < batch; i++) {
+		udp_header_fill(batch_hdr[i], nb_packets + i, secs, usecs, port,
+				rate_in_kbps, packet_size);
+
+		batch_iov[i][0].iov_base = batch_hdr[i];
+		batch_iov[i][0].iov_len = header_size;
+		batch_iov[i][1].iov_base = sample_packet + header_size;
+		batch_iov[i][1].iov_len = packet_size - header_size;
+
+		batch_msg[i].msg_hdr = (struct msghdr) {
+			.msg_iov = batch_iov[i],
+			.msg_iovlen = 2,
+		};
+	}
+
+	return zsock_sendmmsg(sock, batch_msg, batch, 0);
+}
+
 static int udp_upload(int sock, int port,
 		      const struct zperf_upload_params *param,
 		      struct zperf_results *results)
@@ -164,9 +219,10 @@ static int udp_upload(int sock, int port,
 	uint32_t duration_in_ms = param->duration_ms;
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
+	uint32_t batch = CLAMP(param->options.udp_batch, 1, CONFIG_NET_ZPERF_UDP_BATCH_MAX);
 	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps);
-	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
-	uint32_t delay = packet_duration;
+	uint32_t packet_duration;
+	uint32_t delay;
 	uint64_t data_offset = 0U;
 	uint32_t nb_packets = 0U;
 	uint64_t usecs64;
@@ -184,6 +240,15 @@ static int udp_upload(int sock, int port,
 		packet_size = header_size;
 	}
 
+	if (batch > 1 && (param->data_loader != NULL || packet_size < header_size)) {
+		NET_WARN("Batch mode not supported with custom data or short packets");
+		batch = 1;
+	}
+
+	/* The rate is maintained per batch */
+	packet_duration = k_us_to_ticks_ceil32(packet_duration_us * batch);
+	delay = packet_duration;
+
 	/* Start the loop */
 	start_time = k_uptime_ticks();
 	last_loop_time = start_time;
@@ -197,8 +262,6 @@ static int udp_upload(int sock, int port,
 	(void)memset(sample_packet, 'z', sizeof(sample_packet));
 
 	do {
-		struct zperf_udp_datagram *datagram;
-		struct zperf_client_hdr_v1 *hdr;
 		uint32_t secs, usecs;
 		int64_t loop_time;
 		int32_t adjust;
@@ -228,22 +291,21 @@ static int udp_upload(int sock, int port,
 		secs = usecs64 / USEC_PER_SEC;
 		usecs = usecs64 % USEC_PER_SEC;
 
-		/* Fill the packet header */
-		datagram = (struct zperf_udp_datagram *)sample_packet;
+		if (batch > 1) {
+			ret = udp_send_batch(sock, nb_packets, batch, secs, usecs, port,
+					     rate_in_kbps, packet_size);
+			if (ret < 0) {
+				NET_ERR("Failed to send the packets (%d)", errno);
+				return -errno;
+			}
 
-		datagram->id = htonl(nb_packets);
-		datagram->tv_sec = htonl(secs);
-		datagram->tv_usec = htonl(usecs);
+			nb_packets += ret;
+			goto wait;
+		}
 
-		hdr = (struct zperf_client_hdr_v1 *)(sample_packet +
-						     sizeof(*datagram));
-		hdr->flags = 0;
-		hdr->num_of_threads = htonl(1);
-		hdr->port = htonl(port);
-		hdr->buffer_len = sizeof(sample_packet) -
-			sizeof(*datagram) - sizeof(*hdr);
-		hdr->bandwidth = htonl(rate_in_kbps);
-		hdr->num_of_bytes = htonl(packet_size);
+		/* Fill the packet header */
+		udp_header_fill(sample_packet, nb_packets, secs, usecs, port,
+				rate_in_kbps, packet_size);
 
 		/* Load custom data payload if requested */
 		if (param->data_loader != NULL) {
@@ -265,6 +327,7 @@ static int udp_upload(int sock, int port,
 			nb_packets++;
 		}
 
+wait:
 		if (IS_ENABLED(CONFIG_NET_ZPERF_LOG_LEVEL_DBG)) {
 			if (print_time >= loop_time) {
 				NET_DBG("nb_packets=%u\tdelay=%u\tadjust=%d",
@@ -10,11 +10,31 @@
 #include <zephyr/arch/cpu.h>
 #include <zephyr/shell/shell.h>
 #include <zephyr/shell/shell_uart.h>
+#include <zephyr/sys/atomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifdef CONFIG_PROFILING_PERF_FOLDED
+#include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/hash_map.h>
+#endif
+
+#ifdef CONFIG_SYMTAB
+#include <zephyr/debug/symtab.h>
+#endif
 
 size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
 
+/* Samples of one CPU, each one is saved as [length, addr0, addr1, ...] */
+struct perf_cpu_data_t {
+	struct k_spinlock lock;
+
+	size_t idx;
+	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
+	bool buf_full;
+};
+
 struct perf_data_t {
 	struct k_timer timer;
 
@@ -22,54 +42,263 @@ struct perf_data_t {
 
 	struct k_work_delayable dwork;
 
-	size_t idx;
-	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
-	bool buf_full;
+	struct perf_cpu_data_t cpu[CONFIG_MP_MAX_NUM_CPUS];
+
+#ifdef CONFIG_SMP
+	/* Samples the other CPUs on each timer tick */
+	struct k_ipi_work ipi_work;
+	/* Ticks on which the other CPUs were still busy with the previous sample */
+	atomic_t missed;
+#endif
+
+#ifdef CONFIG_PROFILING_PERF_FOLDED
+	/* Folds the CPU buffers into the folded stacks while recording */
+	struct k_work fold_work;
+	struct k_mutex fold_lock;
+	uintptr_t fold_buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
+	/* Samples lost because a CPU buffer or the folded stacks heap was full */
+	uint32_t dropped;
+#endif
 };
 
 static void perf_tracer(struct k_timer *timer);
 static void perf_dwork_handler(struct k_work *work);
+#ifdef CONFIG_PROFILING_PERF_FOLDED
+static void perf_fold_handler(struct k_work *work);
+#endif
 static struct perf_data_t perf_data = {
 	.timer = Z_TIMER_INITIALIZER(perf_data.timer, perf_tracer, NULL),
 	.dwork = Z_WORK_DELAYABLE_INITIALIZER(perf_dwork_handler),
+#ifdef CONFIG_PROFILING_PERF_FOLDED
+	.fold_work = Z_WORK_INITIALIZER(perf_fold_handler),
+	.fold_lock = Z_MUTEX_INITIALIZER(perf_data.fold_lock),
+#endif
 };
 
-static void perf_tracer(struct k_timer *timer)
+#ifdef CONFIG_PROFILING_PERF_FOLDED
+/*
+ * A folded stack is a unique stack trace with the number of samples that hit it.
+ * Stacks are kept in a hash map indexed by the hash of their addresses, stacks with
+ * the same hash are chained.
+ */
+struct perf_folded_stack {
+	struct perf_folded_stack *next;
+	uint32_t count;
+	uint32_t len;
+	uintptr_t addrs[];
+};
+
+K_HEAP_DEFINE(perf_folded_heap, CONFIG_PROFILING_PERF_FOLDED_HEAP_SIZE);
+
+static void *perf_folded_alloc(void *ptr, size_t size)
+{
+	return k_heap_realloc(&perf_folded_heap, ptr, size, K_NO_WAIT);
+}
+
+SYS_HASHMAP_SC_DEFINE_STATIC_ADVANCED(perf_folded_map, sys_hash32, perf_folded_alloc,
+				      SYS_HASHMAP_CONFIG(SIZE_MAX,
+							 SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+
+static bool perf_fold_stack(const uintptr_t *addrs, size_t len)
 {
-	struct perf_data_t *perf_data_ptr =
-		(struct perf_data_t *)k_timer_user_data_get(timer);
+	uint64_t key = sys_hash32(addrs, len * sizeof(uintptr_t));
+	uint64_t value = 0;
+	struct perf_folded_stack *stack;
+
+	(void)sys_hashmap_get(&perf_folded_map, key, &value);
+
+	for (stack = (struct perf_folded_stack *)(uintptr_t)value; stack != NULL;
+	     stack = stack->next) {
+		if (stack->len == len &&
+		    memcmp(stack->addrs, addrs, len * sizeof(uintptr_t)) == 0) {
+			stack->count++;
+			return true;
+		}
+	}
+
+	stack = k_heap_alloc(&perf_folded_heap, sizeof(*stack) + len * sizeof(uintptr_t),
+			     K_NO_WAIT);
+	if (stack == NULL) {
+		return false;
+	}
+
+	stack->next = (struct perf_folded_stack *)(uintptr_t)value;
+	stack->count = 1;
+	stack->len = len;
+	memcpy(stack->addrs, addrs, len * sizeof(uintptr_t));
+
+	if (sys_hashmap_insert(&perf_folded_map, key, (uintptr_t)stack, NULL) < 0) {
+		k_heap_free(&perf_folded_heap, stack);
+		return false;
+	}
+
+	return true;
+}
 
+/* Move the samples of all CPUs into the folded stacks */
+static void perf_fold(void)
+{
+	k_spinlock_key_t key;
+	size_t len;
+
+	k_mutex_lock(&perf_data.fold_lock, K_FOREVER);
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct perf_cpu_data_t *cpu = &perf_data.cpu[i];
+
+		key = k_spin_lock(&cpu->lock);
+		len = cpu->idx;
+		memcpy(perf_data.fold_buf, cpu->buf, len * sizeof(uintptr_t));
+		if (cpu->buf_full) {
+			perf_data.dropped++;
+		}
+		cpu->idx = 0;
+		cpu->buf_full = false;
+		k_spin_unlock(&cpu->lock, key);
+
+		for (size_t idx = 0; idx < len; idx += perf_data.fold_buf[idx] + 1) {
+			if (!perf_fold_stack(&perf_data.fold_buf[idx + 1],
+					     perf_data.fold_buf[idx])) {
+				perf_data.dropped++;
+			}
+		}
+	}
+
+	k_mutex_unlock(&perf_data.fold_lock);
+}
+
+static void perf_fold_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	perf_fold();
+}
+
+static void perf_folded_free(uint64_t key, uint64_t value, void *cookie)
+{
+	struct perf_folded_stack *stack = (struct perf_folded_stack *)(uintptr_t)value;
+	struct perf_folded_stack *next;
+
+	ARG_UNUSED(key);
+	ARG_UNUSED(cookie);
+
+	for (; stack != NULL; stack = next) {
+		next = stack->next;
+		k_heap_free(&perf_folded_heap, stack);
+	}
+}
+
+static void perf_folded_clear(void)
+{
+	k_mutex_lock(&perf_data.fold_lock, K_FOREVER);
+	sys_hashmap_clear(&perf_folded_map, perf_folded_free, NULL);
+	perf_data.dropped = 0;
+	k_mutex_unlock(&perf_data.fold_lock);
+}
+#endif /* CONFIG_PROFILING_PERF_FOLDED */
+
+/* Save a stack trace of the code interrupted on the current CPU */
+static void perf_sample(void)
+{
+	struct perf_cpu_data_t *cpu = &perf_data.cpu[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&cpu->lock);
 	size_t trace_length = 0;
+	bool flush;
 
-	if (++perf_data_ptr->idx < CONFIG_PROFILING_PERF_BUFFER_SIZE) {
+	if (cpu->idx + 1 < CONFIG_PROFILING_PERF_BUFFER_SIZE) {
 		trace_length = arch_perf_current_stack_trace(
-					perf_data_ptr->buf + perf_data_ptr->idx,
-					CONFIG_PROFILING_PERF_BUFFER_SIZE - perf_data_ptr->idx);
+					cpu->buf + cpu->idx + 1,
+					CONFIG_PROFILING_PERF_BUFFER_SIZE - cpu->idx - 1);
 	}
 
 	if (trace_length != 0) {
-		perf_data_ptr->buf[perf_data_ptr->idx - 1] = trace_length;
-		perf_data_ptr->idx += trace_length;
+		cpu->buf[cpu->idx] = trace_length;
+		cpu->idx += trace_length + 1;
 	} else {
-		--perf_data_ptr->idx;
-		perf_data_ptr->buf_full = true;
-		k_work_reschedule(&perf_data_ptr->dwork, K_NO_WAIT);
+		cpu->buf_full = true;
+	}
+
+	/* With folding the buffer is drained before it is full, otherwise recording stops */
+	flush = IS_ENABLED(CONFIG_PROFILING_PERF_FOLDED) ?
+		(cpu->idx >= CONFIG_PROFILING_PERF_BUFFER_SIZE / 2) : cpu->buf_full;
+
+	k_spin_unlock(&cpu->lock, key);
+
+	if (flush) {
+#ifdef CONFIG_PROFILING_PERF_FOLDED
+		k_work_submit(&perf_data.fold_work);
+#else
+		k_work_reschedule(&perf_data.dwork, K_NO_WAIT);
+#endif
 	}
 }
 
-static void perf_dwork_handler(struct k_work *work)
+#ifdef CONFIG_SMP
+static void perf_ipi_tracer(struct k_ipi_work *work)
 {
-	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
-	struct perf_data_t *perf_data_ptr = CONTAINER_OF(dwork, struct perf_data_t, dwork);
+	ARG_UNUSED(work);
 
-	k_timer_stop(&perf_data_ptr->timer);
-	if (perf_data_ptr->buf_full) {
-		shell_error(perf_data_ptr->sh, "Perf buf overflow!");
+	perf_sample();
+}
+#endif
+
+static void perf_tracer(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	perf_sample();
+
+#ifdef CONFIG_SMP
+	if (arch_num_cpus() > 1) {
+		if (k_ipi_work_add(&perf_data.ipi_work, BIT_MASK(arch_num_cpus()),
+				   perf_ipi_tracer) == 0) {
+			k_ipi_work_signal();
+		} else {
+			atomic_inc(&perf_data.missed);
+		}
+	}
+#endif
+}
+
+static bool perf_buf_full(void)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		if (perf_data.cpu[i].buf_full) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void perf_dwork_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_timer_stop(&perf_data.timer);
+#ifdef CONFIG_PROFILING_PERF_FOLDED
+	perf_fold();
+	if (perf_data.dropped != 0) {
+#else
+	if (perf_buf_full()) {
+#endif
+		shell_error(perf_data.sh, "Perf buf overflow!");
 	} else {
-		shell_print(perf_data_ptr->sh, "Perf done!");
+		shell_print(perf_data.sh, "Perf done!");
 	}
 }
 
+#ifdef CONFIG_SMP
+static int perf_init(void)
+{
+	k_ipi_work_init(&perf_data.ipi_work);
+
+	return 0;
+}
+
+SYS_INIT(perf_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif
+
 static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
 {
 	if (k_work_delayable_is_pending(&perf_data.dwork)) {
@@ -77,7 +306,7 @@ static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
 		return -EINPROGRESS;
 	}
 
-	if (perf_data.buf_full) {
+	if (!IS_ENABLED(CONFIG_PROFILING_PERF_FOLDED) && perf_buf_full()) {
 		shell_warn(sh, "Perf buffer is full");
 		return -ENOBUFS;
 	}
@@ -87,7 +316,6 @@ static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
 
 	perf_data.sh = sh;
 
-	k_timer_user_data_set(&perf_data.timer, &perf_data);
 	k_timer_start(&perf_data.timer, K_NO_WAIT, period);
 
 	k_work_schedule(&perf_data.dwork, duration);
@@ -99,6 +327,8 @@ static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
 
 static int cmd_perf_clear(const struct shell *sh, size_t argc, char **argv)
 {
+	k_spinlock_key_t key;
+
 	if (sh != NULL) {
 		if (k_work_delayable_is_pending(&perf_data.dwork)) {
 			shell_warn(sh, "Perf is running");
@@ -107,8 +337,19 @@ static int cmd_perf_clear(const struct shell *sh, size_t argc, char **argv)
 		shell_print(sh, "Perf buffer cleared");
 	}
 
-	perf_data.idx = 0;
-	perf_data.buf_full = false;
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		key = k_spin_lock(&perf_data.cpu[i].lock);
+		perf_data.cpu[i].idx = 0;
+		perf_data.cpu[i].buf_full = false;
+		k_spin_unlock(&perf_data.cpu[i].lock, key);
+	}
+
+#ifdef CONFIG_SMP
+	atomic_clear(&perf_data.missed);
+#endif
+#ifdef CONFIG_PROFILING_PERF_FOLDED
+	perf_folded_clear();
+#endif
 
 	return 0;
 }
@@ -119,22 +360,43 @@ static int cmd_perf_info(const struct shell *sh, size_t argc, char **argv)
 		shell_print(sh, "Perf is running");
 	}
 
-	shell_print(sh, "Perf buf: %zu/%d %s", perf_data.idx, CONFIG_PROFILING_PERF_BUFFER_SIZE,
-		    perf_data.buf_full ? "(full)" : "");
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		shell_print(sh, "Perf buf CPU %u: %zu/%d %s", i, perf_data.cpu[i].idx,
+			    CONFIG_PROFILING_PERF_BUFFER_SIZE,
+			    perf_data.cpu[i].buf_full ? "(full)" : "");
+	}
+
+#ifdef CONFIG_SMP
+	shell_print(sh, "Perf missed samples on other CPUs: %ld",
+		    (long)atomic_get(&perf_data.missed));
+#endif
+#ifdef CONFIG_PROFILING_PERF_FOLDED
+	shell_print(sh, "Perf folded stacks: %zu, dropped samples: %u",
+		    sys_hashmap_size(&perf_folded_map), perf_data.dropped);
+#endif
 
 	return 0;
 }
 
 static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 {
+	size_t len = 0;
+
 	if (k_work_delayable_is_pending(&perf_data.dwork)) {
 		shell_warn(sh, "Perf is running");
 		return -EINPROGRESS;
 	}
 
-	shell_print(sh, "Perf buf length %zu", perf_data.idx);
-	for (size_t i = 0; i < perf_data.idx; i++) {
-		shell_print(sh, "%016lx", perf_data.buf[i]);
+	/* Samples of all CPUs are printed as a single buffer */
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		len += perf_data.cpu[i].idx;
+	}
+
+	shell_print(sh, "Perf buf length %zu", len);
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		for (size_t j = 0; j < perf_data.cpu[i].idx; j++) {
+			shell_print(sh, "%016lx", perf_data.cpu[i].buf[j]);
+		}
 	}
 
 	cmd_perf_clear(NULL, 0, NULL);
@@ -142,13 +404,78 @@ static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+#ifdef CONFIG_PROFILING_PERF_FOLDED
+static void perf_print_folded_stack(const struct shell *sh, const struct perf_folded_stack *stack)
+{
+#ifdef CONFIG_SYMTAB
+	const char *prev = NULL;
+	const char *name;
+	uint32_t offset;
+#endif
+
+	/* The first address is the interrupted one, so the stack is printed in reverse */
+	for (size_t i = stack->len; i > 0; i--) {
+		const char *sep = (i == stack->len) ? "" : ";";
+
+#ifdef CONFIG_SYMTAB
+		name = symtab_find_symbol_name(stack->addrs[i - 1], &offset);
+		/* The interrupted address and the return address can be in the same function */
+		if (name == prev) {
+			continue;
+		}
+		prev = name;
+		shell_fprintf(sh, SHELL_NORMAL, "%s%s", sep, name);
+#else
+		shell_fprintf(sh, SHELL_NORMAL, "%s0x%lx", sep, stack->addrs[i - 1]);
+#endif
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, " %u\n", stack->count);
+}
+
+static void perf_print_folded(uint64_t key, uint64_t value, void *cookie)
+{
+	const struct perf_folded_stack *stack = (const struct perf_folded_stack *)(uintptr_t)value;
+
+	ARG_UNUSED(key);
+
+	for (; stack != NULL; stack = stack->next) {
+		perf_print_folded_stack(cookie, stack);
+	}
+}
+
+static int cmd_perf_print_folded(const struct shell *sh, size_t argc, char **argv)
+{
+	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+		shell_warn(sh, "Perf is running");
+		return -EINPROGRESS;
+	}
+
+	perf_fold();
+
+	k_mutex_lock(&perf_data.fold_lock, K_FOREVER);
+	sys_hashmap_foreach(&perf_folded_map, perf_print_folded, (void *)sh);
+	k_mutex_unlock(&perf_data.fold_lock);
+
+	cmd_perf_clear(NULL, 0, NULL);
+
+	return 0;
+}
+#endif /* CONFIG_PROFILING_PERF_FOLDED */
+
 #define CMD_HELP_RECORD                                                                            \
 	"Start recording for <duration> ms on <frequency> Hz\n"                                    \
 	"Usage: record <duration> <frequency>"
 
+#define CMD_HELP_PRINTFOLDED                                                                       \
+	"Print the folded stacks, one \"frame;frame;... count\" line per stack"
+
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf,
 	SHELL_CMD_ARG(record, NULL, CMD_HELP_RECORD, cmd_perf_record, 3, 0),
 	SHELL_CMD_ARG(printbuf, NULL, "Print the perf buffer", cmd_perf_print, 0, 0),
+#ifdef CONFIG_PROFILING_PERF_FOLDED
+	SHELL_CMD_ARG(printfolded, NULL, CMD_HELP_PRINTFOLDED, cmd_perf_print_folded, 0, 0),
+#endif
 	SHELL_CMD_ARG(clear, NULL, "Clear the perf buffer", cmd_perf_clear, 0, 0),
 	SHELL_CMD_ARG(info, NULL, "Print the perf info", cmd_perf_info, 0, 0),
 	SHELL_SUBCMD_SET_END
@@ -10,7 +10,67 @@
 
 #include <zephyr/sys/sys_heap.h>
 
-extern struct sys_heap _system_heap;
+extern struct k_heap _system_heap;
+
+#ifdef CONFIG_SYS_HEAP_PROFILE
+static void print_histogram(const struct shell *sh, const char *name, const uint32_t *bins)
+{
+	shell_print(sh, "%s cycles:", name);
+
+	for (int i = 0; i < CONFIG_SYS_HEAP_PROFILE_BINS; i++) {
+		if (bins[i] == 0U) {
+			continue;
+		}
+
+		if (i == CONFIG_SYS_HEAP_PROFILE_BINS - 1) {
+			shell_print(sh, "  >= %-10u: %u", (uint32_t)BIT(i), bins[i]);
+		} else {
+			shell_print(sh, "  <  %-10u: %u", (uint32_t)BIT(i + 1), bins[i]);
+		}
+	}
+}
+
+static void print_profile(const struct shell *sh)
+{
+	struct sys_heap_profile profile;
+#ifdef CONFIG_SYS_HEAP_PROFILE_SITES
+	struct sys_heap_profile_site sites[CONFIG_SYS_HEAP_PROFILE_SITES_NUM + 1];
+	size_t num_sites;
+#endif
+
+	K_SPINLOCK(&_system_heap.lock) {
+		(void)sys_heap_profile_get(&_system_heap.heap, &profile);
+	}
+
+	shell_print(sh, "largest free:   %zu", profile.largest_free_bytes);
+	shell_print(sh, "min. largest:   %zu", profile.min_largest_free_bytes);
+	shell_print(sh, "failed allocs:  %u", profile.alloc_failures);
+	print_histogram(sh, "alloc", profile.alloc_cycles);
+	print_histogram(sh, "free", profile.free_cycles);
+
+#ifdef CONFIG_SYS_HEAP_PROFILE_SITES
+	num_sites = sys_heap_profile_sites_get(sites, ARRAY_SIZE(sites));
+	if (num_sites > 0) {
+		shell_print(sh, "%-20s %10s %10s %10s %10s", "thread", "allocs", "alloc B",
+			    "frees", "free B");
+	}
+
+	for (size_t i = 0; i < num_sites; i++) {
+		const char *name = "<other>";
+
+		if (sites[i].thread != NULL) {
+			name = k_thread_name_get((k_tid_t)sites[i].thread);
+			if ((name == NULL) || (name[0] == '\0')) {
+				name = "<unnamed>";
+			}
+		}
+
+		shell_print(sh, "%-20s %10u %10zu %10u %10zu", name, sites[i].alloc_count,
+			    sites[i].alloc_bytes, sites[i].free_count, sites[i].free_bytes);
+	}
+#endif /* CONFIG_SYS_HEAP_PROFILE_SITES */
+}
+#endif /* CONFIG_SYS_HEAP_PROFILE */
 
 static int cmd_kernel_heap(const struct shell *sh, size_t argc, char **argv)
 {
@@ -20,7 +80,7 @@ static int cmd_kernel_heap(const struct shell *sh, size_t argc, char **argv)
 	int err;
 	struct sys_memory_stats stats;
 
-	err = sys_heap_runtime_stats_get(&_system_heap, &stats);
+	err = sys_heap_runtime_stats_get(&_system_heap.heap, &stats);
 	if (err) {
 		shell_error(sh, "Failed to read kernel system heap statistics (err %d)", err);
 		return -ENOEXEC;
@@ -30,6 +90,10 @@ static int cmd_kernel_heap(const struct shell *sh, size_t argc, char **argv)
 	shell_print(sh, "allocated:      %zu", stats.allocated_bytes);
 	shell_print(sh, "max. allocated: %zu", stats.max_allocated_bytes);
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	print_profile(sh);
+#endif
+
 	return 0;
 }
 
@@ -0,0 +1,173 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+
+#define LATENCY_HEADER_FMT "%-24s %10s %10s %10s %10s %10s"
+#define LATENCY_FMT        "%-24s %10u %10u %10u %10u %10u"
+
+static void print_latency(const struct shell *sh, const char *name,
+			  const struct k_sched_latency_stats *stats)
+{
+	uint32_t avg = (uint32_t)(stats->total / stats->count);
+
+	shell_print(sh, LATENCY_FMT, name, stats->count, stats->min, avg,
+		    k_sched_latency_percentile(stats, 99), stats->max);
+}
+
+static void print_header(const struct shell *sh, const char *name)
+{
+	shell_print(sh, "Wakeup latency in cycles:");
+	shell_print(sh, LATENCY_HEADER_FMT, name, "wakeups", "min", "avg", "p99", "max");
+}
+
+static void thread_latency_dump(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *sh = user_data;
+	struct k_sched_latency_stats stats;
+	const char *tname;
+	char name[24];
+
+	if ((k_thread_wakeup_latency_get(thread, &stats) != 0) || (stats.count == 0U)) {
+		return;
+	}
+
+	tname = k_thread_name_get(thread);
+	if ((tname != NULL) && (tname[0] != '\0')) {
+		snprintf(name, sizeof(name), "%s", tname);
+	} else {
+		snprintf(name, sizeof(name), "%p", (void *)thread);
+	}
+
+	print_latency(sh, name, &stats);
+}
+
+static int cmd_kernel_latency_threads(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	print_header(sh, "thread");
+	k_thread_foreach_unlocked(thread_latency_dump, (void *)sh);
+
+	return 0;
+}
+
+static int cmd_kernel_latency_prio(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct k_sched_latency_stats stats;
+	char name[24];
+
+	print_header(sh, "priority");
+
+	for (int prio = K_HIGHEST_THREAD_PRIO; prio <= K_LOWEST_THREAD_PRIO; prio++) {
+		if ((k_sched_wakeup_latency_get(prio, &stats) != 0) || (stats.count == 0U)) {
+			continue;
+		}
+
+		snprintf(name, sizeof(name), "%d", prio);
+		print_latency(sh, name, &stats);
+	}
+
+	return 0;
+}
+
+struct thread_entry {
+	const struct k_thread *const thread;
+	bool valid;
+};
+
+static void thread_valid_cb(const struct k_thread *cthread, void *user_data)
+{
+	struct thread_entry *entry = user_data;
+
+	if (cthread == entry->thread) {
+		entry->valid = true;
+	}
+}
+
+static int cmd_kernel_latency_show(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+
+	struct thread_entry entry = {
+		.thread = (struct k_thread *)strtoul(argv[1], NULL, 16),
+	};
+	struct k_sched_latency_stats stats;
+
+	k_thread_foreach_unlocked(thread_valid_cb, &entry);
+	if (!entry.valid ||
+	    (k_thread_wakeup_latency_get((struct k_thread *)entry.thread, &stats) != 0)) {
+		shell_error(sh, "Invalid thread address");
+		return -EINVAL;
+	}
+
+	if (stats.count == 0U) {
+		shell_print(sh, "No wakeup measured");
+		return 0;
+	}
+
+	print_header(sh, "thread");
+	print_latency(sh, argv[1], &stats);
+
+	shell_print(sh, "Histogram:");
+	for (int i = 0; i < CONFIG_SCHED_WAKEUP_LATENCY_STATS_BINS; i++) {
+		if (stats.bins[i] == 0U) {
+			continue;
+		}
+
+		if (i == CONFIG_SCHED_WAKEUP_LATENCY_STATS_BINS - 1) {
+			shell_print(sh, "  >= %-10u: %u", (uint32_t)BIT(i), stats.bins[i]);
+		} else {
+			shell_print(sh, "  <  %-10u: %u", (uint32_t)BIT(i + 1), stats.bins[i]);
+		}
+	}
+
+	return 0;
+}
+
+static void thread_latency_reset(const struct k_thread *cthread, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	(void)k_thread_wakeup_latency_reset((struct k_thread *)cthread);
+}
+
+static int cmd_kernel_latency_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_thread_foreach_unlocked(thread_latency_reset, NULL);
+	k_sched_wakeup_latency_reset();
+
+	shell_print(sh, "Wakeup latency statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_latency,
+	SHELL_CMD(threads, NULL, "List the wakeup latency of each thread.",
+		  cmd_kernel_latency_threads),
+	SHELL_CMD(prio, NULL, "List the wakeup latency of each priority.",
+		  cmd_kernel_latency_prio),
+	SHELL_CMD_ARG(show, NULL,
+		      "Show the wakeup latency histogram of a thread.\n"
+		      "Usage: show <thread address>",
+		      cmd_kernel_latency_show, 2, 0),
+	SHELL_CMD(reset, NULL, "Reset the wakeup latency statistics.", cmd_kernel_latency_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+KERNEL_CMD_ADD(latency, &sub_kernel_latency, "Thread wakeup latency statistics.", NULL);
@@ -0,0 +1,213 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/obj_core.h>
+
+#ifdef CONFIG_SPIN_LOCK_CONTENTION_STATS
+extern struct k_spinlock _sched_spinlock;
+#endif
+
+struct locks_walk_data {
+	const struct shell *sh;
+	const char *type_name;
+	/* Object to print the histogram of, NULL to list all objects */
+	const void *obj;
+	bool found;
+};
+
+static void print_histogram(const struct shell *sh, const struct k_lock_stats *stats)
+{
+	shell_print(sh, "wait cycles:");
+
+	for (int i = 0; i < CONFIG_LOCK_CONTENTION_STATS_BINS; i++) {
+		if (stats->wait_bins[i] == 0U) {
+			continue;
+		}
+
+		if (i == CONFIG_LOCK_CONTENTION_STATS_BINS - 1) {
+			shell_print(sh, "  >= %-10u: %u", (uint32_t)BIT(i), stats->wait_bins[i]);
+		} else {
+			shell_print(sh, "  <  %-10u: %u", (uint32_t)BIT(i + 1), stats->wait_bins[i]);
+		}
+	}
+}
+
+static void print_stats(const struct shell *sh, const char *type_name, const void *obj,
+			const struct k_lock_stats *stats)
+{
+	uint32_t avg = (stats->contended == 0U) ? 0U :
+		       (uint32_t)(stats->wait_total / stats->contended);
+
+#ifdef CONFIG_THREAD_NAME
+	if (stats->max_holder_name[0] != '\0') {
+		shell_print(sh, "%-6s %-12p %10u %10u %10u %10u %s", type_name, obj,
+			    stats->acquired, stats->contended, avg, stats->wait_max,
+			    stats->max_holder_name);
+		return;
+	}
+#endif
+
+	/* Only print the holder address, the thread may be gone */
+	shell_print(sh, "%-6s %-12p %10u %10u %10u %10u 0x%lx", type_name, obj,
+		    stats->acquired, stats->contended, avg, stats->wait_max,
+		    (unsigned long)stats->max_holder);
+}
+
+static int locks_walk(struct k_obj_core *obj_core, void *data)
+{
+	struct locks_walk_data *walk = data;
+	const void *obj = (const char *)obj_core - obj_core->type->obj_core_offset;
+	struct k_lock_stats stats;
+
+	if ((walk->obj != NULL) && (walk->obj != obj)) {
+		return 0;
+	}
+
+	if (k_obj_core_stats_raw(obj_core, &stats, sizeof(stats)) != 0) {
+		return 0;
+	}
+
+	print_stats(walk->sh, walk->type_name, obj, &stats);
+	if (walk->obj != NULL) {
+		print_histogram(walk->sh, &stats);
+		walk->found = true;
+		return 1;
+	}
+
+	return 0;
+}
+
+static int locks_reset(struct k_obj_core *obj_core, void *data)
+{
+	ARG_UNUSED(data);
+
+	(void)k_obj_core_stats_reset(obj_core);
+
+	return 0;
+}
+
+static void locks_type_walk(uint32_t type_id, int (*func)(struct k_obj_core *, void *),
+			    void *data)
+{
+	struct k_obj_type *type = k_obj_type_find(type_id);
+
+	if (type != NULL) {
+		(void)k_obj_type_walk_unlocked(type, func, data);
+	}
+}
+
+static bool locks_foreach(const struct shell *sh, const void *obj)
+{
+	struct locks_walk_data walk = {
+		.sh = sh,
+		.obj = obj,
+	};
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	walk.type_name = "mutex";
+	locks_type_walk(K_OBJ_TYPE_MUTEX_ID, locks_walk, &walk);
+#endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	walk.type_name = "sem";
+	locks_type_walk(K_OBJ_TYPE_SEM_ID, locks_walk, &walk);
+#endif
+
+#ifdef CONFIG_SPIN_LOCK_CONTENTION_STATS
+	/* Spinlocks are not kernel objects, only the scheduler lock is reported */
+	if ((obj == NULL) || (obj == &_sched_spinlock)) {
+		struct k_lock_stats stats;
+
+		K_SPINLOCK(&_sched_spinlock) {
+			stats = _sched_spinlock.stats;
+		}
+
+		print_stats(sh, "sched", &_sched_spinlock, &stats);
+		if (obj != NULL) {
+			print_histogram(sh, &stats);
+			return true;
+		}
+	}
+#endif
+
+	return walk.found;
+}
+
+static int cmd_kernel_locks_list(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-6s %-12s %10s %10s %10s %10s %s", "type", "object", "acquired",
+		    "waits", "avg wait", "max wait", "max holder");
+
+	(void)locks_foreach(sh, NULL);
+
+	return 0;
+}
+
+static int cmd_kernel_locks_show(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+
+	const void *obj = (const void *)strtoul(argv[1], NULL, 16);
+
+	if (obj == NULL) {
+		shell_error(sh, "Invalid object address");
+		return -EINVAL;
+	}
+
+	shell_print(sh, "%-6s %-12s %10s %10s %10s %10s %s", "type", "object", "acquired",
+		    "waits", "avg wait", "max wait", "max holder");
+
+	if (!locks_foreach(sh, obj)) {
+		shell_error(sh, "Lock %p not found", obj);
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+static int cmd_kernel_locks_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	locks_type_walk(K_OBJ_TYPE_MUTEX_ID, locks_reset, NULL);
+#endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	locks_type_walk(K_OBJ_TYPE_SEM_ID, locks_reset, NULL);
+#endif
+
+#ifdef CONFIG_SPIN_LOCK_CONTENTION_STATS
+	K_SPINLOCK(&_sched_spinlock) {
+		memset(&_sched_spinlock.stats, 0, sizeof(_sched_spinlock.stats));
+	}
+#endif
+
+	shell_print(sh, "Lock statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_locks,
+	SHELL_CMD(list, NULL, "List the lock contention statistics.", cmd_kernel_locks_list),
+	SHELL_CMD_ARG(show, NULL,
+		      "Show the wait histogram of a lock.\n"
+		      "Usage: show <lock address>",
+		      cmd_kernel_locks_show, 2, 0),
+	SHELL_CMD(reset, NULL, "Reset the lock contention statistics.", cmd_kernel_locks_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+KERNEL_CMD_ADD(locks, &sub_kernel_locks, "Lock contention statistics.", NULL);
@@ -80,7 +80,7 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	shell_print(sh, "\toptions: 0x%x, priority: %d timeout: %" PRId64,
 		    thread->base.user_options,
 		    thread->base.prio,
-		    (int64_t)thread->base.timeout.dticks);
+		    (int64_t)z_timeout_remaining(&thread->base.timeout));
 	shell_print(sh, "\tstate: %s, entry: %p",
 		    k_thread_state_str(thread, state_str, sizeof(state_str)),
 		    thread->entry.pEntry);
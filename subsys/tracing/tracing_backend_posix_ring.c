@@ -0,0 +1,115 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <soc.h>
+#include <cmdline.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <tracing_backend.h>
+#include "tracing_backend_posix_ring_bottom.h"
+
+#define RING_SIZE CONFIG_TRACING_BACKEND_POSIX_RING_SIZE
+
+BUILD_ASSERT(IS_POWER_OF_TWO(RING_SIZE), "Ring size must be a power of 2");
+
+static struct tracing_posix_ring rings[CONFIG_MP_MAX_NUM_CPUS];
+static uint8_t ring_bufs[CONFIG_MP_MAX_NUM_CPUS][RING_SIZE];
+static const char *file_name;
+
+static void tracing_backend_posix_ring_init(void)
+{
+	if (file_name == NULL) {
+		file_name = "channel0_0";
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(rings); i++) {
+		rings[i].buf = ring_bufs[i];
+		rings[i].size = RING_SIZE;
+	}
+
+	tracing_posix_ring_init_bottom(rings, ARRAY_SIZE(rings), file_name,
+				       CONFIG_TRACING_BACKEND_POSIX_RING_DRAIN_PERIOD);
+}
+
+/*
+ * Copy the data to the ring of the current CPU. Interrupts are locked so the
+ * CPU is the only producer of its ring. The drain thread is only woken up when
+ * the ring gets half full, otherwise it writes the data in batches every drain
+ * period. When the ring is full, wait for the drain thread so no data is lost.
+ */
+static void tracing_backend_posix_ring_output(
+		const struct tracing_backend *backend,
+		uint8_t *data, uint32_t length)
+{
+	ARG_UNUSED(backend);
+
+	unsigned int key = arch_irq_lock();
+	struct tracing_posix_ring *ring = &rings[arch_curr_cpu()->id];
+	uint32_t head = ring->head;
+	uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+	bool kick = (head - tail) < (RING_SIZE / 2);
+
+	while (length > 0) {
+		uint32_t len = MIN(length, RING_SIZE - (head - tail));
+
+		if (len == 0) {
+			tracing_posix_ring_wait_bottom();
+			tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+			continue;
+		}
+
+		len = MIN(len, RING_SIZE - (head & (RING_SIZE - 1)));
+		memcpy(&ring->buf[head & (RING_SIZE - 1)], data, len);
+		head += len;
+		data += len;
+		length -= len;
+
+		__atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+	}
+
+	if (kick && ((head - tail) >= (RING_SIZE / 2))) {
+		tracing_posix_ring_kick_bottom();
+	}
+
+	arch_irq_unlock(key);
+}
+
+const struct tracing_backend_api tracing_backend_posix_ring_api = {
+	.init = tracing_backend_posix_ring_init,
+	.output  = tracing_backend_posix_ring_output
+};
+
+TRACING_BACKEND_DEFINE(tracing_backend_posix_ring, tracing_backend_posix_ring_api);
+
+static void tracing_backend_posix_ring_cleanup(void)
+{
+	tracing_posix_ring_cleanup_bottom();
+}
+
+static void tracing_backend_posix_ring_option(void)
+{
+	static struct args_struct_t tracing_backend_option[] = {
+		{
+			.manual = false,
+			.is_mandatory = false,
+			.is_switch = false,
+			.option = "trace-file",
+			.name = "file_name",
+			.type = 's',
+			.dest = (void *)&file_name,
+			.call_when_found = NULL,
+			.descript = "File name for tracing output. With several CPUs, the "
+				    "stream of CPU n > 0 is written to file_name_n.",
+		},
+		ARG_TABLE_ENDMARKER
+	};
+
+	native_add_command_line_opts(tracing_backend_option);
+}
+
+NATIVE_TASK(tracing_backend_posix_ring_option, PRE_BOOT_1, 1);
+NATIVE_TASK(tracing_backend_posix_ring_cleanup, ON_EXIT, 1);
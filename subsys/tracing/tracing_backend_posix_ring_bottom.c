@@ -0,0 +1,179 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#undef _XOPEN_SOURCE
+#define _XOPEN_SOURCE 700
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <nsi_tracing.h>
+#include "tracing_backend_posix_ring_bottom.h"
+
+static struct tracing_posix_ring *rings;
+static FILE **out_streams;
+static int ring_count;
+static unsigned int drain_period_ms;
+
+static pthread_t drain_thread;
+static pthread_mutex_t drain_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t drain_cond = PTHREAD_COND_INITIALIZER;
+static bool drain_kicked;
+static bool drain_stop;
+
+/* Write all the data available in a ring, at most two writes when it wraps */
+static uint32_t drain_ring(struct tracing_posix_ring *ring, FILE *f)
+{
+	uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	uint32_t tail = ring->tail;
+	uint32_t mask = ring->size - 1;
+	uint32_t total = head - tail;
+
+	while (tail != head) {
+		uint32_t len = ring->size - (tail & mask);
+
+		if (len > head - tail) {
+			len = head - tail;
+		}
+
+		if (fwrite(&ring->buf[tail & mask], len, 1, f) != 1) {
+			nsi_print_warning("%s: Failure writing to CTF backend file\n", __func__);
+		}
+
+		tail += len;
+	}
+
+	__atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+
+	if (total != 0) {
+		fflush(f);
+	}
+
+	return total;
+}
+
+static void drain_wait(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_nsec += (long)(drain_period_ms % 1000U) * 1000000L;
+	ts.tv_sec += drain_period_ms / 1000U + ts.tv_nsec / 1000000000L;
+	ts.tv_nsec %= 1000000000L;
+
+	pthread_mutex_lock(&drain_mutex);
+	while (!drain_kicked && !drain_stop) {
+		if (pthread_cond_timedwait(&drain_cond, &drain_mutex, &ts) == ETIMEDOUT) {
+			break;
+		}
+	}
+	drain_kicked = false;
+	pthread_mutex_unlock(&drain_mutex);
+}
+
+static void *drain_main(void *arg)
+{
+	bool stop;
+	uint32_t drained;
+
+	(void)arg;
+
+	do {
+		/* Read the stop request before draining so the last data is never left */
+		pthread_mutex_lock(&drain_mutex);
+		stop = drain_stop;
+		pthread_mutex_unlock(&drain_mutex);
+
+		drained = 0;
+		for (int i = 0; i < ring_count; i++) {
+			drained += drain_ring(&rings[i], out_streams[i]);
+		}
+
+		if ((drained == 0) && !stop) {
+			drain_wait();
+		}
+	} while (!stop);
+
+	return NULL;
+}
+
+void tracing_posix_ring_init_bottom(struct tracing_posix_ring *ring_array, int count,
+				    const char *file_name, unsigned int period_ms)
+{
+	int err;
+
+	rings = ring_array;
+	ring_count = count;
+	drain_period_ms = period_ms;
+
+	out_streams = calloc(count, sizeof(*out_streams));
+	if (out_streams == NULL) {
+		nsi_print_error_and_exit("%s: Out of memory\n", __func__);
+	}
+
+	/* CPU 0 writes to file_name, the other CPUs to file_name_<cpu> */
+	for (int i = 0; i < count; i++) {
+		char name[strlen(file_name) + 16];
+
+		if (i == 0) {
+			snprintf(name, sizeof(name), "%s", file_name);
+		} else {
+			snprintf(name, sizeof(name), "%s_%d", file_name, i);
+		}
+
+		out_streams[i] = fopen(name, "wb");
+		if (out_streams[i] == NULL) {
+			nsi_print_error_and_exit("%s: Could not open CTF backend file %s\n",
+						 __func__, name);
+		}
+	}
+
+	err = pthread_create(&drain_thread, NULL, drain_main, NULL);
+	if (err != 0) {
+		nsi_print_error_and_exit("%s: Failed to create the tracing drain thread\n",
+					 __func__);
+	}
+}
+
+void tracing_posix_ring_kick_bottom(void)
+{
+	pthread_mutex_lock(&drain_mutex);
+	drain_kicked = true;
+	pthread_cond_signal(&drain_cond);
+	pthread_mutex_unlock(&drain_mutex);
+}
+
+void tracing_posix_ring_wait_bottom(void)
+{
+	tracing_posix_ring_kick_bottom();
+	sched_yield();
+}
+
+void tracing_posix_ring_cleanup_bottom(void)
+{
+	if (out_streams == NULL) {
+		return;
+	}
+
+	pthread_mutex_lock(&drain_mutex);
+	drain_stop = true;
+	pthread_cond_signal(&drain_cond);
+	pthread_mutex_unlock(&drain_mutex);
+
+	pthread_join(drain_thread, NULL);
+
+	for (int i = 0; i < ring_count; i++) {
+		fclose(out_streams[i]);
+	}
+
+	free(out_streams);
+	out_streams = NULL;
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * "Bottom" of the shared memory ring tracing backend for the native/hosted targets.
+ * When built with the native_simulator this will be built in the runner context,
+ * that is, with the host C library, and with the host include paths.
+ *
+ * Note: None of these functions are public interfaces. But internal to this backend.
+ */
+
+#ifndef SUBSYS_TRACING_TRACING_BACKEND_POSIX_RING_BOTTOM_H
+#define SUBSYS_TRACING_TRACING_BACKEND_POSIX_RING_BOTTOM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Single producer, single consumer byte ring shared between one Zephyr CPU and
+ * the host drain thread. head and tail are free running, size is a power of 2.
+ * They are kept in separate cache lines as they are written by different host
+ * threads.
+ */
+struct tracing_posix_ring {
+	/* Written by the Zephyr CPU only */
+	uint32_t head __attribute__((aligned(64)));
+	/* Written by the drain thread only */
+	uint32_t tail __attribute__((aligned(64)));
+	uint32_t size;
+	uint8_t *buf;
+};
+
+void tracing_posix_ring_init_bottom(struct tracing_posix_ring *rings, int count,
+				    const char *file_name, unsigned int period_ms);
+void tracing_posix_ring_kick_bottom(void);
+void tracing_posix_ring_wait_bottom(void);
+void tracing_posix_ring_cleanup_bottom(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_TRACING_TRACING_BACKEND_POSIX_RING_BOTTOM_H */
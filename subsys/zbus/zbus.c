@@ -6,6 +6,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/net_buf.h>
@@ -50,8 +51,79 @@ static inline struct net_buf *_zbus_create_net_buf(struct net_buf_pool *pool, si
 }
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER_BUF_ALLOC_DYNAMIC */
 
+static inline struct net_buf_pool *_zbus_chan_pool(const struct zbus_channel *chan)
+{
+	return COND_CODE_1(CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_ISOLATION,
+			   (chan->data->msg_subscriber_pool), (&_zbus_msg_subscribers_pool));
+}
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
+/* Mark the channel's message as being changed, for the lock-free readers */
+static inline void chan_write_begin(const struct zbus_channel *chan)
+{
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	atomic_inc(&chan->data->seq);
+	barrier_dmem_fence_full();
+#else
+	ARG_UNUSED(chan);
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+}
+
+static inline void chan_write_end(const struct zbus_channel *chan)
+{
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	barrier_dmem_fence_full();
+	atomic_inc(&chan->data->seq);
+#else
+	ARG_UNUSED(chan);
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+}
+
+/* A publisher is not preempted while it changes the message, so that the lock-free readers
+ * only retry for the duration of a copy.
+ */
+static inline void chan_pub_begin(const struct zbus_channel *chan)
+{
+	if (IS_ENABLED(CONFIG_ZBUS_CHANNEL_SEQLOCK) && !k_is_in_isr()) {
+		k_sched_lock();
+	}
+
+	chan_write_begin(chan);
+}
+
+static inline void chan_pub_end(const struct zbus_channel *chan)
+{
+	chan_write_end(chan);
+
+	if (IS_ENABLED(CONFIG_ZBUS_CHANNEL_SEQLOCK) && !k_is_in_isr()) {
+		k_sched_unlock();
+	}
+}
+
+/* Release the loaned buffer holding the channel's message, keeping its content if required */
+static inline void _zbus_chan_loan_release(const struct zbus_channel *chan, bool keep_msg)
+{
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+	struct net_buf *loan = chan->data->loan;
+
+	if (loan == NULL) {
+		return;
+	}
+
+	/* With the lock-free reads, the channel's storage already holds a copy of the message */
+	if (keep_msg && !IS_ENABLED(CONFIG_ZBUS_CHANNEL_SEQLOCK)) {
+		memcpy(chan->message, loan->data, chan->message_size);
+	}
+
+	chan->data->loan = NULL;
+	net_buf_unref(loan);
+#else
+	ARG_UNUSED(chan);
+	ARG_UNUSED(keep_msg);
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+}
+
 int _zbus_init(void)
 {
 
@@ -136,6 +208,9 @@ static inline int _zbus_notify_observer(const struct zbus_channel *chan,
 	}
 #if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
 	case ZBUS_OBSERVER_MSG_SUBSCRIBER_TYPE: {
+		/* A buffer is queued to a single FIFO, each msg subscriber gets its own one. The
+		 * heap allocated data is only referenced, the data of a static pool is copied.
+		 */
 		struct net_buf *cloned_buf = net_buf_clone(buf, sys_timepoint_timeout(end_time));
 
 		if (cloned_buf == NULL) {
@@ -164,19 +239,25 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 	struct zbus_channel_observation *observation;
 	struct zbus_channel_observation_mask *observation_mask;
 
-#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
-	struct net_buf_pool *pool =
-		COND_CODE_1(CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_ISOLATION,
-			    (chan->data->msg_subscriber_pool), (&_zbus_msg_subscribers_pool));
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+	/* The msg subscribers share the loaned buffer holding the message */
+	if (chan->data->loan != NULL) {
+		buf = net_buf_ref(chan->data->loan);
+	}
+#endif /* CONFIG_ZBUS_MSG_LOAN */
 
-	buf = _zbus_create_net_buf(pool, zbus_chan_msg_size(chan), sys_timepoint_timeout(end_time));
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+	if (buf == NULL) {
+		buf = _zbus_create_net_buf(_zbus_chan_pool(chan), zbus_chan_msg_size(chan),
+					   sys_timepoint_timeout(end_time));
 
-	_ZBUS_ASSERT(buf != NULL, "net_buf zbus_msg_subscribers_pool is "
-				  "unavailable or heap is full");
+		_ZBUS_ASSERT(buf != NULL, "net_buf zbus_msg_subscribers_pool is "
+					  "unavailable or heap is full");
 
-	memcpy(net_buf_user_data(buf), &chan, sizeof(struct zbus_channel *));
+		memcpy(net_buf_user_data(buf), &chan, sizeof(struct zbus_channel *));
 
-	net_buf_add_mem(buf, zbus_chan_msg(chan), zbus_chan_msg_size(chan));
+		net_buf_add_mem(buf, zbus_chan_msg(chan), zbus_chan_msg_size(chan));
+	}
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 	LOG_DBG("Notifing %s's observers. Starting VDED:", _ZBUS_CHAN_NAME(chan));
@@ -405,8 +486,14 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 	chan->data->publish_count += 1;
 #endif /* CONFIG_ZBUS_CHANNEL_PUBLISH_STATS */
 
+	chan_pub_begin(chan);
+
+	_zbus_chan_loan_release(chan, false);
+
 	memcpy(chan->message, msg, chan->message_size);
 
+	chan_pub_end(chan);
+
 	err = _zbus_vded_exec(chan, end_time);
 
 	chan_unlock(chan, context_priority);
@@ -425,16 +512,62 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 		timeout = K_NO_WAIT;
 	}
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	k_timepoint_t end_time = sys_timepoint_calc(timeout);
+	atomic_val_t seq;
+
+	while (true) {
+		seq = atomic_get(&chan->data->seq);
+
+		if ((seq & 1) != 0) {
+			if (k_is_in_isr()) {
+				/* The publisher may be the code interrupted */
+				return -EBUSY;
+			}
+
+			if (chan->data->claimed) {
+				/* A claim can last long, wait for it as a locked read does */
+				int err = k_sem_take(&chan->data->sem,
+						     sys_timepoint_timeout(end_time));
+
+				if (err) {
+					return err;
+				}
+
+				k_sem_give(&chan->data->sem);
+				continue;
+			}
+
+			if (sys_timepoint_expired(end_time)) {
+				return K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -EBUSY : -EAGAIN;
+			}
+
+			/* The publisher runs on another CPU and only copies the message */
+			k_yield();
+			continue;
+		}
+
+		/* Never read a loaned buffer here, it may be released during the copy */
+		memcpy(msg, chan->message, chan->message_size);
+
+		barrier_dmem_fence_full();
+
+		if (atomic_get(&chan->data->seq) == seq) {
+			return 0;
+		}
+	}
+#else
 	int err = k_sem_take(&chan->data->sem, timeout);
 	if (err) {
 		return err;
 	}
 
-	memcpy(msg, chan->message, chan->message_size);
+	memcpy(msg, zbus_chan_const_msg(chan), chan->message_size);
 
 	k_sem_give(&chan->data->sem);
 
 	return 0;
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
 }
 
 int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
@@ -481,13 +614,109 @@ int zbus_chan_claim(const struct zbus_channel *chan, k_timeout_t timeout)
 		return err;
 	}
 
+	/* The message may be changed until the claim is finished */
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	chan->data->claimed = true;
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+	chan_write_begin(chan);
+
+	/* The loaned buffer is shared, the message is changed in the channel's own storage */
+	_zbus_chan_loan_release(chan, true);
+
+	return 0;
+}
+
+#if defined(CONFIG_ZBUS_MSG_LOAN)
+
+int zbus_chan_loan(const struct zbus_channel *chan, struct net_buf **buf, k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+	_ZBUS_ASSERT(k_is_in_isr() ? K_TIMEOUT_EQ(timeout, K_NO_WAIT) : true,
+		     "inside an ISR, the timeout must be K_NO_WAIT");
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	*buf = _zbus_create_net_buf(_zbus_chan_pool(chan), chan->message_size, timeout);
+	if (*buf == NULL) {
+		return -ENOMEM;
+	}
+
+	memcpy(net_buf_user_data(*buf), &chan, sizeof(struct zbus_channel *));
+
+	net_buf_add(*buf, chan->message_size);
+
 	return 0;
 }
 
+int zbus_chan_commit(const struct zbus_channel *chan, struct net_buf *buf, k_timeout_t timeout)
+{
+	int err;
+
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+	_ZBUS_ASSERT(*((struct zbus_channel **)net_buf_user_data(buf)) == chan,
+		     "buf must be loaned for chan");
+	_ZBUS_ASSERT(k_is_in_isr() ? K_TIMEOUT_EQ(timeout, K_NO_WAIT) : true,
+		     "inside an ISR, the timeout must be K_NO_WAIT");
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	k_timepoint_t end_time = sys_timepoint_calc(timeout);
+
+	if (chan->validator != NULL && !chan->validator(buf->data, chan->message_size)) {
+		net_buf_unref(buf);
+		return -ENOMSG;
+	}
+
+	int context_priority = ZBUS_MIN_THREAD_PRIORITY;
+
+	err = chan_lock(chan, timeout, &context_priority);
+	if (err) {
+		net_buf_unref(buf);
+		return err;
+	}
+
+#if defined(CONFIG_ZBUS_CHANNEL_PUBLISH_STATS)
+	chan->data->publish_timestamp = k_uptime_ticks();
+	chan->data->publish_count += 1;
+#endif /* CONFIG_ZBUS_CHANNEL_PUBLISH_STATS */
+
+	chan_pub_begin(chan);
+
+	_zbus_chan_loan_release(chan, false);
+
+	chan->data->loan = buf;
+
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	/* The lock-free readers copy the message from the channel's own storage */
+	memcpy(chan->message, buf->data, chan->message_size);
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
+	chan_pub_end(chan);
+
+	err = _zbus_vded_exec(chan, end_time);
+
+	chan_unlock(chan, context_priority);
+
+	return err;
+}
+
+#endif /* CONFIG_ZBUS_MSG_LOAN */
+
 int zbus_chan_finish(const struct zbus_channel *chan)
 {
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	chan->data->claimed = false;
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+	chan_write_end(chan);
+
 	k_sem_give(&chan->data->sem);
 
 	return 0;
@@ -533,6 +762,28 @@ int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel
 	return 0;
 }
 
+int zbus_sub_wait_msg_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+			  struct net_buf **buf, k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus_sub_wait_msg_buf cannot be used inside ISRs");
+	_ZBUS_ASSERT(sub != NULL, "sub is required");
+	_ZBUS_ASSERT(sub->type == ZBUS_OBSERVER_MSG_SUBSCRIBER_TYPE,
+		     "sub must be a MSG_SUBSCRIBER");
+	_ZBUS_ASSERT(sub->message_fifo != NULL, "sub message_fifo is required");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+
+	*buf = k_fifo_get(sub->message_fifo, timeout);
+
+	if (*buf == NULL) {
+		return -ENOMSG;
+	}
+
+	*chan = *((struct zbus_channel **)net_buf_user_data(*buf));
+
+	return 0;
+}
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 int zbus_obs_set_chan_notification_mask(const struct zbus_observer *obs,
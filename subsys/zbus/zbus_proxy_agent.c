@@ -0,0 +1,218 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/zbus/zbus_proxy_agent.h>
+
+LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
+
+/* Each message sent to the remote is a sequence of frames, one per channel */
+struct frame_hdr {
+	/* Position of the channel in the list of the proxy agent */
+	uint16_t index;
+	/* Message size, the frame is padded to keep the next one aligned */
+	uint16_t size;
+};
+
+#define FRAME_LEN(_size) (sizeof(struct frame_hdr) + ROUND_UP(_size, sizeof(uint32_t)))
+
+static inline const void *current_ctx(const struct zbus_proxy_agent *agent)
+{
+	return k_is_in_isr() ? (const void *)agent : (const void *)k_current_get();
+}
+
+static int chan_index(const struct zbus_proxy_agent *agent, const struct zbus_channel *chan)
+{
+	for (size_t i = 0; i < agent->num_channels; i++) {
+		if (agent->channels[i] == chan) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+void zbus_proxy_agent_forward(struct zbus_proxy_agent *agent, const struct zbus_channel *chan)
+{
+	int index;
+
+	if ((agent->rx_chan == chan) && (agent->rx_ctx == current_ctx(agent))) {
+		/* Received from the remote, the other channels published meanwhile by the
+		 * observers are forwarded
+		 */
+		return;
+	}
+
+	index = chan_index(agent, chan);
+	if (index < 0) {
+		return;
+	}
+
+	/* Only the last message is forwarded when the channel is published again meanwhile */
+	atomic_set_bit(agent->pending, index);
+
+	if (zbus_proxy_agent_is_bound(agent)) {
+		k_work_schedule(&agent->tx_work, K_MSEC(CONFIG_ZBUS_PROXY_AGENT_BATCH_DELAY_MS));
+	}
+}
+
+static int flush(struct zbus_proxy_agent *agent, size_t len)
+{
+	const struct frame_hdr *hdr;
+	int err;
+
+	err = ipc_service_send(&agent->ept, agent->tx_buf, len);
+	if (err >= 0) {
+		return 0;
+	}
+
+	/* Forward the channels of the batch again later */
+	for (size_t off = 0; off < len; off += FRAME_LEN(hdr->size)) {
+		hdr = (const struct frame_hdr *)&agent->tx_buf[off];
+		atomic_set_bit(agent->pending, hdr->index);
+	}
+
+	return err;
+}
+
+static void tx_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct zbus_proxy_agent *agent = CONTAINER_OF(dwork, struct zbus_proxy_agent, tx_work);
+	const struct zbus_channel *chan;
+	struct frame_hdr *hdr;
+	bool retry = false;
+	size_t len = 0;
+	int err;
+
+	for (size_t i = 0; i < agent->num_channels; i++) {
+		if (!atomic_test_and_clear_bit(agent->pending, i)) {
+			continue;
+		}
+
+		chan = agent->channels[i];
+
+		if ((len + FRAME_LEN(chan->message_size)) > sizeof(agent->tx_buf)) {
+			err = flush(agent, len);
+			len = 0;
+
+			if (err != 0) {
+				atomic_set_bit(agent->pending, i);
+				retry = true;
+				break;
+			}
+		}
+
+		hdr = (struct frame_hdr *)&agent->tx_buf[len];
+		hdr->index = i;
+		hdr->size = chan->message_size;
+
+		err = zbus_chan_read(chan, hdr + 1, K_MSEC(CONFIG_ZBUS_PROXY_AGENT_TIMEOUT_MS));
+		if (err != 0) {
+			atomic_set_bit(agent->pending, i);
+			retry = true;
+			continue;
+		}
+
+		len += FRAME_LEN(chan->message_size);
+	}
+
+	if ((len > 0) && (flush(agent, len) != 0)) {
+		retry = true;
+	}
+
+	if (retry) {
+		/* The channels not forwarded are still pending */
+		LOG_DBG("%s: forwarding delayed", agent->ept_cfg.name);
+		k_work_schedule(&agent->tx_work, K_MSEC(CONFIG_ZBUS_PROXY_AGENT_RETRY_DELAY_MS));
+	}
+}
+
+static void received(const void *data, size_t len, void *priv)
+{
+	struct zbus_proxy_agent *agent = priv;
+	const uint8_t *buf = data;
+	const struct frame_hdr *hdr;
+	const struct zbus_channel *chan;
+	int err;
+
+	for (size_t off = 0; (off + sizeof(*hdr)) <= len; off += FRAME_LEN(hdr->size)) {
+		hdr = (const struct frame_hdr *)&buf[off];
+
+		if ((hdr->index >= agent->num_channels) ||
+		    (hdr->size != agent->channels[hdr->index]->message_size) ||
+		    ((off + sizeof(*hdr) + hdr->size) > len)) {
+			LOG_ERR("%s: invalid message received", agent->ept_cfg.name);
+			return;
+		}
+
+		chan = agent->channels[hdr->index];
+
+		agent->rx_ctx = current_ctx(agent);
+		agent->rx_chan = chan;
+		err = zbus_chan_pub(chan, hdr + 1, K_MSEC(CONFIG_ZBUS_PROXY_AGENT_TIMEOUT_MS));
+		agent->rx_chan = NULL;
+		agent->rx_ctx = NULL;
+
+		if (err != 0) {
+			LOG_WRN("%s: message %u dropped (%d)", agent->ept_cfg.name, hdr->index, err);
+		}
+	}
+}
+
+static void bound(void *priv)
+{
+	struct zbus_proxy_agent *agent = priv;
+
+	atomic_set(&agent->bound, 1);
+
+	/* Forward the channels published before */
+	k_work_schedule(&agent->tx_work, K_NO_WAIT);
+}
+
+static void unbound(void *priv)
+{
+	struct zbus_proxy_agent *agent = priv;
+
+	atomic_clear(&agent->bound);
+}
+
+int zbus_proxy_agent_init(struct zbus_proxy_agent *agent, const char *ept_name)
+{
+	int err;
+
+	for (size_t i = 0; i < agent->num_channels; i++) {
+		if (FRAME_LEN(agent->channels[i]->message_size) > sizeof(agent->tx_buf)) {
+			LOG_ERR("%s: message %zu larger than CONFIG_ZBUS_PROXY_AGENT_TX_BUF_SIZE",
+				ept_name, i);
+			return -EINVAL;
+		}
+	}
+
+	k_work_init_delayable(&agent->tx_work, tx_work_handler);
+
+	agent->ept_cfg.name = ept_name;
+	agent->ept_cfg.cb.bound = bound;
+	agent->ept_cfg.cb.unbound = unbound;
+	agent->ept_cfg.cb.received = received;
+	agent->ept_cfg.priv = agent;
+
+	err = ipc_service_open_instance(agent->ipc_instance);
+	if ((err < 0) && (err != -EALREADY)) {
+		LOG_ERR("%s: failed to open the IPC instance (%d)", ept_name, err);
+		return err;
+	}
+
+	err = ipc_service_register_endpoint(agent->ipc_instance, &agent->ept, &agent->ept_cfg);
+	if (err < 0) {
+		LOG_ERR("%s: failed to register the endpoint (%d)", ept_name, err);
+		return err;
+	}
+
+	return 0;
+}
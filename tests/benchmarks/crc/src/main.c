@@ -0,0 +1,156 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main testing module that invokes all the tests.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define BUFFER_SIZE CONFIG_BENCHMARK_BUFFER_SIZE
+
+struct crc_bench {
+	const char *name;
+	uint32_t (*func)(const uint8_t *data, size_t len);
+	/* Reflected polynomial of the bitwise reference, 0 if not checked */
+	uint32_t poly;
+};
+
+static uint8_t buffer[BUFFER_SIZE];
+
+/* Prevents the compiler from removing the measured calls */
+static volatile uint32_t result;
+
+static uint32_t bench_crc32_ieee(const uint8_t *data, size_t len)
+{
+	return crc32_ieee(data, len);
+}
+
+static uint32_t bench_crc32_c(const uint8_t *data, size_t len)
+{
+	return crc32_c(0, data, len, true, true);
+}
+
+static uint32_t bench_crc16_ccitt(const uint8_t *data, size_t len)
+{
+	return crc16_ccitt(0xffff, data, len);
+}
+
+static uint32_t bench_crc8_ccitt(const uint8_t *data, size_t len)
+{
+	return crc8_ccitt(0xff, data, len);
+}
+
+static const struct crc_bench benches[] = {
+	{ "crc32_ieee", bench_crc32_ieee, 0xedb88320 },
+	{ "crc32_c", bench_crc32_c, 0x82f63b78 },
+	{ "crc16_ccitt", bench_crc16_ccitt, 0 },
+	{ "crc8_ccitt", bench_crc8_ccitt, 0 },
+};
+
+static uint32_t crc32_bitwise(uint32_t poly, const uint8_t *data, size_t len)
+{
+	uint32_t crc = ~0U;
+
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+		}
+	}
+
+	return ~crc;
+}
+
+static int run_bench(const struct crc_bench *bench)
+{
+	timing_t start;
+	timing_t finish;
+	uint64_t cycles;
+	uint64_t per_call;
+	uint64_t ns;
+	uint32_t mbps;
+
+	/* Unaligned buffer and odd length exercise the tail handling */
+	if ((bench->poly != 0U) &&
+	    (bench->func(&buffer[1], BUFFER_SIZE - 2) !=
+	     crc32_bitwise(bench->poly, &buffer[1], BUFFER_SIZE - 2))) {
+		printk("%s: wrong result\n", bench->name);
+		return TC_FAIL;
+	}
+
+	start = timing_counter_get();
+	for (int i = 0; i < CONFIG_BENCHMARK_ITERATIONS; i++) {
+		result = bench->func(buffer, BUFFER_SIZE);
+	}
+	finish = timing_counter_get();
+
+	cycles = timing_cycles_get(&start, &finish);
+	per_call = cycles / CONFIG_BENCHMARK_ITERATIONS;
+	ns = timing_cycles_to_ns(cycles);
+	/* Bytes per microsecond is MB/s */
+	mbps = (uint32_t)(((uint64_t)BUFFER_SIZE * CONFIG_BENCHMARK_ITERATIONS * 1000U) /
+			  MAX(ns, 1U));
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: crc.%s - %s, %u bytes : %7llu cycles , %7u ns :\n", bench->name,
+	       bench->name, BUFFER_SIZE, per_call, (uint32_t)timing_cycles_to_ns(per_call));
+#else
+	printk("------------------------------------\n");
+	printk("%s, %u bytes\n", bench->name, BUFFER_SIZE);
+	printk("    Average : %7llu cycles (%7u nsec)\n", per_call,
+	       (uint32_t)timing_cycles_to_ns(per_call));
+#endif
+	printk("    Throughput : %u MB/s\n", mbps);
+
+	return TC_PASS;
+}
+
+static const char *crc32_implementation(void)
+{
+	if (IS_ENABLED(CONFIG_CRC32_HW)) {
+		return "CPU instructions if available";
+	} else if (IS_ENABLED(CONFIG_CRC32_SLICE_BY_8)) {
+		return "slice-by-8";
+	} else if (IS_ENABLED(CONFIG_CRC32_SLICE_BY_4)) {
+		return "slice-by-4";
+	} else if (IS_ENABLED(CONFIG_CRC32_TABLE_256)) {
+		return "256-entry table";
+	} else {
+		return "16-entry table";
+	}
+}
+
+int main(void)
+{
+	int status = TC_PASS;
+
+	for (size_t i = 0; i < sizeof(buffer); i++) {
+		buffer[i] = (uint8_t)(i * 37 + 11);
+	}
+
+	timing_init();
+
+	printk("Time Measurements for CRC, CRC-32 implementation: %s\n",
+	       crc32_implementation());
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (size_t i = 0; (i < ARRAY_SIZE(benches)) && (status == TC_PASS); i++) {
+		status = run_bench(&benches[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
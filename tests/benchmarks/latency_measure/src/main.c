@@ -67,6 +67,7 @@ extern int stack_ops(uint32_t num_iterations, uint32_t options);
 extern int stack_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 			       uint32_t alt_options);
 extern void heap_malloc_free(void);
+extern void sched_wakeup_latency(uint32_t num_iterations);
 
 #if (CONFIG_MP_MAX_NUM_CPUS > 1)
 static void busy_thread_entry(void *arg1, void *arg2, void *arg3)
@@ -203,6 +204,10 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 
 	heap_malloc_free();
 
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY_STATS
+	sched_wakeup_latency(CONFIG_BENCHMARK_NUM_ITERATIONS);
+#endif
+
 	TC_END_REPORT(error_count);
 }
 
@@ -0,0 +1,133 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure the wakeup latency of a thread under load
+ *
+ * This file contains the test that reports the wakeup latency statistics
+ * gathered by the scheduler for a thread woken up by a semaphore while
+ * another thread of the same priority is busy. The woken up thread runs
+ * after the busy thread yields, so the latencies spread over the amount
+ * of work done by the busy thread.
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+
+#ifdef CONFIG_SCHED_WAKEUP_LATENCY_STATS
+
+#define LOAD_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(load_stack, LOAD_STACK_SIZE);
+static struct k_thread load_thread;
+
+static struct k_sem wakeup_sem;
+static volatile bool load_done;
+
+static void load_thread_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; !load_done; i++) {
+		/* Vary the amount of work between the yields */
+		for (volatile uint32_t j = 0; j < 64 + (i * 7919) % 512; j++) {
+		}
+
+		k_yield();
+	}
+}
+
+/* Thread woken up, its wakeup latency is reported */
+static void start_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t num_iterations = (uint32_t)(uintptr_t)p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < num_iterations; i++) {
+		k_sem_take(&wakeup_sem, K_FOREVER);
+	}
+}
+
+static void alt_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t num_iterations = (uint32_t)(uintptr_t)p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Same priority, so <load_thread> does not run until the yield */
+	k_thread_start(&load_thread);
+
+	for (uint32_t i = 0; i < num_iterations; i++) {
+		/* <start_thread> is queued after <load_thread> */
+		k_sem_give(&wakeup_sem);
+		k_yield();
+	}
+
+	load_done = true;
+}
+
+static void print_latency(const char *tag, const char *description, uint32_t cycles)
+{
+	char summary[120];
+
+	snprintf(summary, sizeof(summary), "%-40s - %s", tag, description);
+
+	PRINT_F(summary, cycles, (uint32_t)k_cyc_to_ns_floor64(cycles), 0, "");
+}
+
+void sched_wakeup_latency(uint32_t num_iterations)
+{
+	int priority = k_thread_priority_get(k_current_get()) - 1;
+	struct k_sched_latency_stats stats;
+
+	k_sem_init(&wakeup_sem, 0, 1);
+	load_done = false;
+
+	k_thread_create(&start_thread, start_stack, K_THREAD_STACK_SIZEOF(start_stack),
+			start_thread_entry, (void *)(uintptr_t)num_iterations, NULL, NULL,
+			priority, 0, K_FOREVER);
+	k_thread_create(&alt_thread, alt_stack, K_THREAD_STACK_SIZEOF(alt_stack),
+			alt_thread_entry, (void *)(uintptr_t)num_iterations, NULL, NULL,
+			priority, 0, K_FOREVER);
+	k_thread_create(&load_thread, load_stack, K_THREAD_STACK_SIZEOF(load_stack),
+			load_thread_entry, NULL, NULL, NULL,
+			priority, 0, K_FOREVER);
+
+	/* <start_thread> runs first and waits for the semaphore */
+	k_thread_start(&start_thread);
+	k_thread_start(&alt_thread);
+
+	k_thread_join(&start_thread, K_FOREVER);
+	k_thread_join(&alt_thread, K_FOREVER);
+	k_thread_join(&load_thread, K_FOREVER);
+
+	k_thread_wakeup_latency_get(&start_thread, &stats);
+
+	if (stats.count == 0U) {
+		error_count++;
+		PRINT_F("sched.wakeup.latency - Wakeup latency under load", 0, 0, 1,
+			"no wakeup measured");
+		return;
+	}
+
+	print_latency("sched.wakeup.latency.min", "Wakeup latency under load (min)",
+		      stats.min);
+	print_latency("sched.wakeup.latency.avg", "Wakeup latency under load (avg)",
+		      (uint32_t)(stats.total / stats.count));
+	print_latency("sched.wakeup.latency.p99", "Wakeup latency under load (p99)",
+		      k_sched_latency_percentile(&stats, 99));
+	print_latency("sched.wakeup.latency.max", "Wakeup latency under load (max)",
+		      stats.max);
+}
+
+#endif /* CONFIG_SCHED_WAKEUP_LATENCY_STATS */
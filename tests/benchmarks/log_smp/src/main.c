@@ -0,0 +1,199 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main testing module that invokes all the tests.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+#define MAX_THREADS CONFIG_MP_MAX_NUM_CPUS
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* The main thread stops the rounds */
+#define THREAD_PRIO K_PRIO_PREEMPT(1)
+
+/* Logged by the threads as hexdump */
+struct bench_msg {
+	uint32_t thread;
+	uint32_t seq;
+};
+
+struct thread_stats {
+	uint32_t ops;
+	uint64_t cycles;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(thread_stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+static struct thread_stats thread_stats[MAX_THREADS];
+
+static atomic_t stop;
+
+/* Processed messages, checked by the backend */
+static uint32_t processed;
+static uint32_t unordered;
+static int64_t last_seq[MAX_THREADS];
+
+/* Overwritten messages of each CPU, before the round */
+static uint32_t prev_overwritten[MAX_THREADS];
+
+static void process(struct log_backend const *const backend, union log_msg_generic *msg)
+{
+	struct bench_msg bench_msg;
+	size_t len;
+	uint8_t *data = log_msg_get_data(&msg->log, &len);
+
+	ARG_UNUSED(backend);
+
+	if ((len != sizeof(bench_msg)) || (log_msg_get_level(&msg->log) != LOG_LEVEL_INF)) {
+		return;
+	}
+
+	memcpy(&bench_msg, data, sizeof(bench_msg));
+	if ((bench_msg.thread >= MAX_THREADS) || (bench_msg.seq <= last_seq[bench_msg.thread])) {
+		unordered++;
+	} else {
+		last_seq[bench_msg.thread] = bench_msg.seq;
+	}
+
+	processed++;
+}
+
+static const struct log_backend_api bench_backend_api = {
+	.process = process,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, bench_backend_api, true);
+
+static void thread_entry(void *p1, void *p2, void *p3)
+{
+	struct thread_stats *stats = p1;
+	struct bench_msg msg = {
+		.thread = POINTER_TO_UINT(p2),
+	};
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p3);
+
+	start = timing_counter_get();
+	while (!atomic_get(&stop)) {
+		msg.seq = stats->ops;
+		LOG_HEXDUMP_INF(&msg, sizeof(msg), "msg");
+		stats->ops++;
+	}
+	finish = timing_counter_get();
+
+	stats->cycles = timing_cycles_get(&start, &finish);
+}
+
+static void report(unsigned int cpus, const struct thread_stats *stats)
+{
+	uint64_t per_op = stats->cycles / MAX(stats->ops, 1U);
+	uint32_t rate = stats->ops / CONFIG_BENCHMARK_DURATION_MS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: log.msg.%u_cpu - Log message, %u CPU(s) : %7llu cycles , %7u ns :\n", cpus,
+	       cpus, per_op, (uint32_t)timing_cycles_to_ns(per_op));
+#else
+	printk("------------------------------------\n");
+	printk("Log message, %u CPU(s)\n", cpus);
+	printk("    Average : %7llu cycles (%7u nsec)\n", per_op,
+	       (uint32_t)timing_cycles_to_ns(per_op));
+#endif
+	printk("    Throughput : %u messages/ms\n", rate);
+
+	if (IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) {
+		struct log_cpu_stats cpu_stats;
+
+		for (unsigned int cpu = 0; cpu < cpus; cpu++) {
+			if (log_cpu_stats_get(cpu, &cpu_stats) == 0) {
+				printk("    CPU %u : %u messages overwritten\n", cpu,
+				       cpu_stats.overwritten - prev_overwritten[cpu]);
+				prev_overwritten[cpu] = cpu_stats.overwritten;
+			}
+		}
+	}
+}
+
+static int run_round(unsigned int cpus)
+{
+	struct thread_stats total = {0};
+
+	atomic_clear(&stop);
+	memset(thread_stats, 0, sizeof(thread_stats));
+	processed = 0;
+	unordered = 0;
+
+	for (unsigned int i = 0; i < MAX_THREADS; i++) {
+		last_seq[i] = -1;
+	}
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		k_thread_create(&threads[i], thread_stacks[i],
+				K_THREAD_STACK_SIZEOF(thread_stacks[i]), thread_entry,
+				&thread_stats[i], UINT_TO_POINTER(i), NULL, THREAD_PRIO, 0,
+				K_NO_WAIT);
+	}
+
+	k_msleep(CONFIG_BENCHMARK_DURATION_MS);
+
+	atomic_set(&stop, 1);
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+
+		total.ops += thread_stats[i].ops;
+		total.cycles += thread_stats[i].cycles;
+	}
+
+	while (log_process()) {
+	}
+
+	if ((unordered != 0U) || (processed > total.ops)) {
+		printk("%u of %u messages processed out of order\n", unordered, processed);
+		return TC_FAIL;
+	}
+
+	report(cpus, &total);
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	unsigned int num_cpus = MIN(arch_num_cpus(), MAX_THREADS);
+	int status = TC_PASS;
+
+	timing_init();
+
+	printk("Time Measurements for SMP logging with per-CPU buffers %s\n",
+	       IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS) ? "enabled" : "disabled");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int cpus = 1; (cpus <= num_cpus) && (status == TC_PASS); cpus++) {
+		status = run_round(cpus);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
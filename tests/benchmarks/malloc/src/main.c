@@ -0,0 +1,303 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main testing module that invokes all the tests.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/tc_util.h>
+
+#define MAX_THREADS 4
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define THREAD_PRIO K_PRIO_COOP(1)
+
+/* Size of the blocks of the fixed size rounds */
+#define BLOCK_SIZE 32
+
+/* Blocks held by each thread of the fixed size rounds */
+#define NUM_HELD 8
+
+struct stats {
+	uint64_t minimum;
+	uint64_t maximum;
+	uint64_t total;
+	uint32_t count;
+};
+
+struct worker {
+	struct k_thread thread;
+	struct stats alloc_stats;
+	struct stats free_stats;
+	timing_t start;
+	timing_t finish;
+	int errors;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, MAX_THREADS, STACK_SIZE);
+
+static struct worker workers[MAX_THREADS];
+
+static K_SEM_DEFINE(start_sem, 0, MAX_THREADS);
+
+/* Blocks tracked by the heap stress test, sized like it recommends */
+static uint8_t scratch[CONFIG_HEAP_MEM_POOL_SIZE / 2];
+
+static void stats_reset(struct stats *s)
+{
+	s->minimum = UINT64_MAX;
+	s->maximum = 0ULL;
+	s->total = 0ULL;
+	s->count = 0U;
+}
+
+static void stats_add(struct stats *s, uint64_t cycles)
+{
+	s->minimum = MIN(s->minimum, cycles);
+	s->maximum = MAX(s->maximum, cycles);
+	s->total += cycles;
+	s->count++;
+}
+
+static void stats_merge(struct stats *s, const struct stats *other)
+{
+	s->minimum = MIN(s->minimum, other->minimum);
+	s->maximum = MAX(s->maximum, other->maximum);
+	s->total += other->total;
+	s->count += other->count;
+}
+
+static void report_stats(const struct stats *s, const char *tag, const char *str)
+{
+	uint64_t average = s->total / MAX(s->count, 1U);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	int tag_len = strlen(tag);
+	int descr_len = strlen(str);
+	int stag_len = strlen(".min");
+	int sdescr_len = strlen(", min.");
+
+	stag_len = (tag_len + stag_len < 40) ? 40 - tag_len : stag_len;
+	sdescr_len = (descr_len + sdescr_len < 50) ? 50 - descr_len : sdescr_len;
+
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".min", str,
+	       sdescr_len, ", min.", s->minimum, (uint32_t)timing_cycles_to_ns(s->minimum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".max", str,
+	       sdescr_len, ", max.", s->maximum, (uint32_t)timing_cycles_to_ns(s->maximum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".avg", str,
+	       sdescr_len, ", avg.", average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("------------------------------------\n");
+	printk("%s\n", str);
+
+	printk("    Minimum : %7llu cycles (%7u nsec)\n", s->minimum,
+	       (uint32_t)timing_cycles_to_ns(s->minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n", s->maximum,
+	       (uint32_t)timing_cycles_to_ns(s->maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void *stress_alloc(void *arg, size_t bytes)
+{
+	struct worker *w = arg;
+	timing_t start;
+	timing_t finish;
+	void *ret;
+
+	start = timing_counter_get();
+	ret = k_malloc(bytes);
+	finish = timing_counter_get();
+	stats_add(&w->alloc_stats, timing_cycles_get(&start, &finish));
+
+	return ret;
+}
+
+static void stress_free(void *arg, void *p)
+{
+	struct worker *w = arg;
+	timing_t start;
+	timing_t finish;
+
+	start = timing_counter_get();
+	k_free(p);
+	finish = timing_counter_get();
+	stats_add(&w->free_stats, timing_cycles_get(&start, &finish));
+}
+
+/*
+ * Run the heap stress test through k_malloc() and k_free(), and report the
+ * cost of an allocation and of a free.
+ */
+static int run_stress(void)
+{
+	struct worker *w = &workers[0];
+	struct z_heap_stress_result result;
+
+	stats_reset(&w->alloc_stats);
+	stats_reset(&w->free_stats);
+
+	sys_heap_stress(stress_alloc, stress_free, w, CONFIG_HEAP_MEM_POOL_SIZE,
+			CONFIG_BENCHMARK_NUM_OPS, scratch, sizeof(scratch), 50, &result);
+
+	if (result.successful_allocs == 0U) {
+		printk("No allocation succeeded\n");
+		return TC_FAIL;
+	}
+
+	report_stats(&w->alloc_stats, "malloc.stress.alloc", "Heap stress, allocate");
+	report_stats(&w->free_stats, "malloc.stress.free", "Heap stress, free");
+
+	printk("    Allocations : %u of %u succeeded, %u frees\n", result.successful_allocs,
+	       result.total_allocs, result.total_frees);
+
+	return TC_PASS;
+}
+
+static void worker_entry(void *p1, void *p2, void *p3)
+{
+	struct worker *w = p1;
+	void *held[NUM_HELD];
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	w->start = timing_counter_get();
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_OPS; i++) {
+		void **slot = &held[i % NUM_HELD];
+
+		/* Keep a few blocks around, so that frees don't always return
+		 * the block that was just allocated.
+		 */
+		if (i >= NUM_HELD) {
+			start = timing_counter_get();
+			k_free(*slot);
+			finish = timing_counter_get();
+			stats_add(&w->free_stats, timing_cycles_get(&start, &finish));
+		}
+
+		start = timing_counter_get();
+		*slot = k_malloc(BLOCK_SIZE);
+		finish = timing_counter_get();
+		stats_add(&w->alloc_stats, timing_cycles_get(&start, &finish));
+
+		if (*slot == NULL) {
+			w->errors++;
+		}
+	}
+	w->finish = timing_counter_get();
+
+	for (i = 0; i < MIN(NUM_HELD, CONFIG_BENCHMARK_NUM_OPS); i++) {
+		k_free(held[i]);
+	}
+}
+
+/*
+ * Let @p num threads allocate and free blocks of the same size at the same
+ * time, and report the cost of an allocation, of a free, and the combined
+ * operation rate.
+ */
+static int run_fixed(unsigned int num)
+{
+	struct stats alloc_stats;
+	struct stats free_stats;
+	uint64_t elapsed = 0ULL;
+	uint32_t elapsed_ns;
+	unsigned int total;
+	char tag[48];
+	char descr[64];
+	int errors = 0;
+	unsigned int i;
+
+	stats_reset(&alloc_stats);
+	stats_reset(&free_stats);
+
+	for (i = 0; i < num; i++) {
+		struct worker *w = &workers[i];
+
+		w->errors = 0;
+		stats_reset(&w->alloc_stats);
+		stats_reset(&w->free_stats);
+
+		k_thread_create(&w->thread, worker_stacks[i], STACK_SIZE, worker_entry,
+				w, NULL, NULL, THREAD_PRIO, 0, K_NO_WAIT);
+	}
+
+	/* All threads wait on the semaphore, release them together */
+	for (i = 0; i < num; i++) {
+		k_sem_give(&start_sem);
+	}
+
+	for (i = 0; i < num; i++) {
+		struct worker *w = &workers[i];
+
+		k_thread_join(&w->thread, K_FOREVER);
+		stats_merge(&alloc_stats, &w->alloc_stats);
+		stats_merge(&free_stats, &w->free_stats);
+		elapsed = MAX(elapsed, timing_cycles_get(&w->start, &w->finish));
+		errors += w->errors;
+	}
+
+	if (errors != 0) {
+		printk("%d allocations failed\n", errors);
+		return TC_FAIL;
+	}
+
+	snprintk(tag, sizeof(tag), "malloc.fixed.alloc.%u_cpu", num);
+	snprintk(descr, sizeof(descr), "Allocate %u bytes, %u CPU(s)", BLOCK_SIZE, num);
+	report_stats(&alloc_stats, tag, descr);
+
+	snprintk(tag, sizeof(tag), "malloc.fixed.free.%u_cpu", num);
+	snprintk(descr, sizeof(descr), "Free %u bytes, %u CPU(s)", BLOCK_SIZE, num);
+	report_stats(&free_stats, tag, descr);
+
+	total = alloc_stats.count + free_stats.count;
+	elapsed_ns = (uint32_t)timing_cycles_to_ns(elapsed);
+	printk("    Throughput : %u operations/ms\n",
+	       (uint32_t)((uint64_t)total * NSEC_PER_MSEC / MAX(elapsed_ns, 1U)));
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	unsigned int max_threads = MIN(arch_num_cpus(), MAX_THREADS);
+	int status;
+	unsigned int i;
+
+	timing_init();
+
+	printk("Time Measurements for k_malloc() and k_free() with size class caches %s\n",
+	       IS_ENABLED(CONFIG_HEAP_MEM_POOL_SLAB) ? "enabled" : "disabled");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	status = run_stress();
+
+	for (i = 1; (i <= max_threads) && (status == TC_PASS); i++) {
+		status = run_fixed(i);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main testing module that invokes all the tests.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <tracing_user.h>
+
+#define MAX_BATCH 16
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* The producer only runs once the consumer waits for its completions */
+#define CONSUMER_PRIO K_PRIO_PREEMPT(1)
+#define PRODUCER_PRIO K_PRIO_PREEMPT(2)
+
+static const size_t batch_sizes[] = {1, 4, MAX_BATCH};
+
+RTIO_DEFINE(r, MAX_BATCH, MAX_BATCH);
+
+/* Operations submitted to the iodev, completed by the producer */
+static struct mpsc pending = MPSC_INIT(pending);
+static K_SEM_DEFINE(pending_sem, 0, K_SEM_MAX_LIMIT);
+
+static void bench_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	mpsc_push(&pending, &iodev_sqe->q);
+	k_sem_give(&pending_sem);
+}
+
+static const struct rtio_iodev_api bench_iodev_api = {
+	.submit = bench_iodev_submit,
+};
+
+RTIO_IODEV_DEFINE(bench_iodev, &bench_iodev_api, NULL);
+
+static K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+static struct k_thread producer_thread;
+static struct k_thread consumer_thread;
+
+static atomic_t consumer_switches;
+
+void sys_trace_thread_switched_in_user(void)
+{
+	if (k_sched_current_thread_query() == &consumer_thread) {
+		atomic_inc(&consumer_switches);
+	}
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	struct mpsc_node *node;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&pending_sem, K_FOREVER);
+
+		node = mpsc_pop(&pending);
+		while (node == NULL) {
+			node = mpsc_pop(&pending);
+		}
+
+		rtio_iodev_sqe_ok(CONTAINER_OF(node, struct rtio_iodev_sqe, q), 0);
+	}
+}
+
+struct round {
+	size_t batch;
+	uint32_t ops;
+	uint64_t cycles;
+	uint32_t switches;
+	int errors;
+};
+
+static void consumer_entry(void *p1, void *p2, void *p3)
+{
+	struct round *rnd = p1;
+	struct rtio_cqe *cqes[MAX_BATCH];
+	struct rtio_sqe *sqe;
+	timing_t start;
+	timing_t finish;
+	size_t count;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	atomic_clear(&consumer_switches);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < rnd->ops; i += rnd->batch) {
+		for (size_t j = 0; j < rnd->batch; j++) {
+			sqe = rtio_sqe_acquire(&r);
+			rtio_sqe_prep_nop(sqe, &bench_iodev, NULL);
+		}
+
+		rtio_submit(&r, 0);
+
+		count = rtio_cqe_consume_block_n(&r, cqes, rnd->batch, K_FOREVER);
+		if (count != rnd->batch) {
+			rnd->errors++;
+		}
+
+		for (size_t j = 0; j < count; j++) {
+			rtio_cqe_release(&r, cqes[j]);
+		}
+	}
+	finish = timing_counter_get();
+
+	rnd->cycles = timing_cycles_get(&start, &finish);
+	rnd->switches = (uint32_t)atomic_get(&consumer_switches);
+}
+
+static void report_round(const struct round *rnd)
+{
+	uint64_t per_op = rnd->cycles / MAX(rnd->ops, 1U);
+	uint32_t elapsed_ns = (uint32_t)timing_cycles_to_ns(rnd->cycles);
+	uint32_t rate = (uint32_t)((uint64_t)rnd->ops * NSEC_PER_MSEC / MAX(elapsed_ns, 1U));
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: rtio.completion.batch_%-2zu - Complete and consume, batch of %-2zu"
+	       " : %7llu cycles , %7u ns :\n",
+	       rnd->batch, rnd->batch, per_op, (uint32_t)timing_cycles_to_ns(per_op));
+#else
+	printk("------------------------------------\n");
+	printk("Complete and consume, batch of %zu\n", rnd->batch);
+	printk("    Average : %7llu cycles (%7u nsec)\n", per_op,
+	       (uint32_t)timing_cycles_to_ns(per_op));
+#endif
+	printk("    Throughput : %u operations/ms\n", rate);
+	printk("    Wake-ups : %u for %u operations (%u.%02u per operation)\n", rnd->switches,
+	       rnd->ops, rnd->switches / rnd->ops, (rnd->switches % rnd->ops) * 100U / rnd->ops);
+}
+
+static int run_round(size_t batch)
+{
+	struct round rnd = {
+		.batch = batch,
+		.ops = ROUND_DOWN(CONFIG_BENCHMARK_NUM_OPS, batch),
+	};
+
+	k_thread_create(&consumer_thread, consumer_stack, K_THREAD_STACK_SIZEOF(consumer_stack),
+			consumer_entry, &rnd, NULL, NULL, CONSUMER_PRIO, 0, K_NO_WAIT);
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	if (rnd.errors != 0) {
+		printk("%d batches were not completed\n", rnd.errors);
+		return TC_FAIL;
+	}
+
+	report_round(&rnd);
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	int status = TC_PASS;
+
+	timing_init();
+
+	printk("Time Measurements for RTIO completions with batched wake-ups %s\n",
+	       IS_ENABLED(CONFIG_RTIO_CONSUME_BATCH) ? "enabled" : "disabled");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	k_thread_create(&producer_thread, producer_stack, K_THREAD_STACK_SIZEOF(producer_stack),
+			producer_entry, NULL, NULL, NULL, PRODUCER_PRIO, 0, K_NO_WAIT);
+
+	timing_start();
+
+	for (size_t i = 0; (i < ARRAY_SIZE(batch_sizes)) && (status == TC_PASS); i++) {
+		status = run_round(batch_sizes[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main testing module that invokes all the tests.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/drivers/timer/system_timer.h>
+#include <zephyr/tc_util.h>
+#include <timeout_q.h>
+
+/* Far enough in the future for nothing to expire while measuring */
+#define FAR_TIMEOUT_TICKS 1000000
+
+/* Prime stride used to visit the timeouts in a scattered order */
+#define STRIDE 7919
+
+struct stats {
+	uint64_t minimum;
+	uint64_t maximum;
+	uint64_t total;
+	uint32_t count;
+};
+
+static struct _timeout timeouts[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+
+static uint32_t expired;
+
+static void expiry_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	expired++;
+}
+
+static void stats_reset(struct stats *s)
+{
+	s->minimum = UINT64_MAX;
+	s->maximum = 0ULL;
+	s->total = 0ULL;
+	s->count = 0U;
+}
+
+static void stats_add(struct stats *s, uint64_t cycles)
+{
+	s->minimum = MIN(s->minimum, cycles);
+	s->maximum = MAX(s->maximum, cycles);
+	s->total += cycles;
+	s->count++;
+}
+
+static void report_stats(const struct stats *s, const char *tag, const char *str)
+{
+	uint64_t average = s->total / MAX(s->count, 1U);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	int tag_len = strlen(tag);
+	int descr_len = strlen(str);
+	int stag_len = strlen(".min");
+	int sdescr_len = strlen(", min.");
+
+	stag_len = (tag_len + stag_len < 40) ? 40 - tag_len : stag_len;
+	sdescr_len = (descr_len + sdescr_len < 50) ? 50 - descr_len : sdescr_len;
+
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".min", str,
+	       sdescr_len, ", min.", s->minimum, (uint32_t)timing_cycles_to_ns(s->minimum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".max", str,
+	       sdescr_len, ", max.", s->maximum, (uint32_t)timing_cycles_to_ns(s->maximum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".avg", str,
+	       sdescr_len, ", avg.", average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("------------------------------------\n");
+	printk("%s\n", str);
+
+	printk("    Minimum : %7llu cycles (%7u nsec)\n", s->minimum,
+	       (uint32_t)timing_cycles_to_ns(s->minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n", s->maximum,
+	       (uint32_t)timing_cycles_to_ns(s->maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void test_add(struct stats *s)
+{
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_TIMEOUTS; i++) {
+		k_timeout_t timeout = K_TICKS(FAR_TIMEOUT_TICKS + ((i * STRIDE) % FAR_TIMEOUT_TICKS));
+
+		start = timing_counter_get();
+		z_add_timeout(&timeouts[i], expiry_fn, timeout);
+		finish = timing_counter_get();
+		stats_add(s, timing_cycles_get(&start, &finish));
+	}
+}
+
+static void test_remaining(struct stats *s)
+{
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_TIMEOUTS; i++) {
+		struct _timeout *t = &timeouts[(i * STRIDE) % CONFIG_BENCHMARK_NUM_TIMEOUTS];
+
+		start = timing_counter_get();
+		(void)z_timeout_remaining(t);
+		finish = timing_counter_get();
+		stats_add(s, timing_cycles_get(&start, &finish));
+	}
+}
+
+static void test_abort(struct stats *s)
+{
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+
+	/*
+	 * The stride is prime, so unless it divides the number of timeouts
+	 * every timeout is visited once. Sweep up any leftovers afterwards.
+	 */
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_TIMEOUTS; i++) {
+		struct _timeout *t = &timeouts[(i * STRIDE) % CONFIG_BENCHMARK_NUM_TIMEOUTS];
+
+		start = timing_counter_get();
+		z_abort_timeout(t);
+		finish = timing_counter_get();
+		stats_add(s, timing_cycles_get(&start, &finish));
+	}
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_TIMEOUTS; i++) {
+		z_abort_timeout(&timeouts[i]);
+	}
+}
+
+static void test_announce(struct stats *s)
+{
+	timing_t start;
+	timing_t finish;
+	unsigned int key;
+	unsigned int i;
+
+	/*
+	 * Ticks are announced by hand, keep the system timer from doing the
+	 * same while the timeouts expire.
+	 */
+	key = irq_lock();
+
+	expired = 0U;
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_TIMEOUTS; i++) {
+		z_add_timeout(&timeouts[i], expiry_fn,
+			      K_TICKS((i * STRIDE) % CONFIG_BENCHMARK_ANNOUNCE_TICKS));
+	}
+
+	for (i = 0; expired < CONFIG_BENCHMARK_NUM_TIMEOUTS; i++) {
+		start = timing_counter_get();
+		sys_clock_announce(1);
+		finish = timing_counter_get();
+		stats_add(s, timing_cycles_get(&start, &finish));
+
+		if (i > 2 * CONFIG_BENCHMARK_ANNOUNCE_TICKS) {
+			printk("Only %u of %u timeouts expired\n", expired,
+			       CONFIG_BENCHMARK_NUM_TIMEOUTS);
+			break;
+		}
+	}
+
+	irq_unlock(key);
+}
+
+int main(void)
+{
+	struct stats s;
+
+	timing_init();
+
+	printk("Time Measurements for %s timeout queue with %u timeouts\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "timing wheel" : "simple",
+	       CONFIG_BENCHMARK_NUM_TIMEOUTS);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	stats_reset(&s);
+	test_add(&s);
+	report_stats(&s, "timeout.add", "Add timeout to timeout queue");
+
+	stats_reset(&s);
+	test_remaining(&s);
+	report_stats(&s, "timeout.remaining", "Get remaining ticks of timeout");
+
+	stats_reset(&s);
+	test_abort(&s);
+	report_stats(&s, "timeout.abort", "Abort timeout");
+
+	stats_reset(&s);
+	test_announce(&s);
+	report_stats(&s, "timeout.announce.tick", "Announce tick and expire timeouts");
+	printk("Expired %u timeouts over %u ticks\n", expired, s.count);
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
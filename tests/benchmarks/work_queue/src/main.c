@@ -0,0 +1,243 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main testing module that invokes all the tests.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/tc_util.h>
+
+#define MAX_PRODUCERS 4
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Producers are cooperative so a work queue thread never preempts them */
+#define PRODUCER_PRIO K_PRIO_COOP(1)
+#define QUEUE_PRIO    K_PRIO_PREEMPT(1)
+
+struct stats {
+	uint64_t minimum;
+	uint64_t maximum;
+	uint64_t total;
+	uint32_t count;
+};
+
+struct producer {
+	struct k_thread thread;
+	struct k_work_q *queue;
+	struct stats stats;
+	timing_t start;
+	timing_t finish;
+	int errors;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, MAX_PRODUCERS, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(queue_stacks, MAX_PRODUCERS, STACK_SIZE);
+
+static struct producer producers[MAX_PRODUCERS];
+static struct k_work_q queues[MAX_PRODUCERS];
+static struct k_work works[MAX_PRODUCERS][CONFIG_BENCHMARK_NUM_ITEMS];
+
+static K_SEM_DEFINE(start_sem, 0, MAX_PRODUCERS);
+
+static atomic_t handled;
+
+static void work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	atomic_inc(&handled);
+}
+
+static void stats_reset(struct stats *s)
+{
+	s->minimum = UINT64_MAX;
+	s->maximum = 0ULL;
+	s->total = 0ULL;
+	s->count = 0U;
+}
+
+static void stats_add(struct stats *s, uint64_t cycles)
+{
+	s->minimum = MIN(s->minimum, cycles);
+	s->maximum = MAX(s->maximum, cycles);
+	s->total += cycles;
+	s->count++;
+}
+
+static void stats_merge(struct stats *s, const struct stats *other)
+{
+	s->minimum = MIN(s->minimum, other->minimum);
+	s->maximum = MAX(s->maximum, other->maximum);
+	s->total += other->total;
+	s->count += other->count;
+}
+
+static void report_stats(const struct stats *s, const char *tag, const char *str)
+{
+	uint64_t average = s->total / MAX(s->count, 1U);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	int tag_len = strlen(tag);
+	int descr_len = strlen(str);
+	int stag_len = strlen(".min");
+	int sdescr_len = strlen(", min.");
+
+	stag_len = (tag_len + stag_len < 40) ? 40 - tag_len : stag_len;
+	sdescr_len = (descr_len + sdescr_len < 50) ? 50 - descr_len : sdescr_len;
+
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".min", str,
+	       sdescr_len, ", min.", s->minimum, (uint32_t)timing_cycles_to_ns(s->minimum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".max", str,
+	       sdescr_len, ", max.", s->maximum, (uint32_t)timing_cycles_to_ns(s->maximum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".avg", str,
+	       sdescr_len, ", avg.", average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("------------------------------------\n");
+	printk("%s\n", str);
+
+	printk("    Minimum : %7llu cycles (%7u nsec)\n", s->minimum,
+	       (uint32_t)timing_cycles_to_ns(s->minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n", s->maximum,
+	       (uint32_t)timing_cycles_to_ns(s->maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	struct producer *p = p1;
+	struct k_work *items = p2;
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	p->start = timing_counter_get();
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITEMS; i++) {
+		start = timing_counter_get();
+		if (k_work_submit_to_queue(p->queue, &items[i]) != 1) {
+			p->errors++;
+		}
+		finish = timing_counter_get();
+		stats_add(&p->stats, timing_cycles_get(&start, &finish));
+	}
+	p->finish = timing_counter_get();
+}
+
+/*
+ * Let @p num producers submit their work items at the same time, either each
+ * to its own work queue or all to the first one, and report the cost of a
+ * submission and the combined submission rate.
+ */
+static int run_round(unsigned int num, bool shared)
+{
+	struct stats s;
+	uint64_t elapsed = 0ULL;
+	uint32_t elapsed_ns;
+	unsigned int total;
+	char tag[48];
+	char descr[64];
+	int errors = 0;
+	unsigned int i;
+
+	atomic_set(&handled, 0);
+	stats_reset(&s);
+
+	for (i = 0; i < num; i++) {
+		struct producer *p = &producers[i];
+
+		p->queue = shared ? &queues[0] : &queues[i];
+		p->errors = 0;
+		stats_reset(&p->stats);
+
+		k_thread_create(&p->thread, producer_stacks[i], STACK_SIZE, producer_entry,
+				p, works[i], NULL, PRODUCER_PRIO, 0, K_NO_WAIT);
+	}
+
+	/* All producers wait on the semaphore, release them together */
+	for (i = 0; i < num; i++) {
+		k_sem_give(&start_sem);
+	}
+
+	for (i = 0; i < num; i++) {
+		struct producer *p = &producers[i];
+
+		k_thread_join(&p->thread, K_FOREVER);
+		stats_merge(&s, &p->stats);
+		elapsed = MAX(elapsed, timing_cycles_get(&p->start, &p->finish));
+		errors += p->errors;
+	}
+
+	for (i = 0; i < num; i++) {
+		(void)k_work_queue_drain(&queues[i], false);
+	}
+
+	total = num * CONFIG_BENCHMARK_NUM_ITEMS;
+	if ((errors != 0) || (atomic_get(&handled) != (atomic_val_t)total)) {
+		printk("%d submissions failed, %ld of %u items handled\n", errors,
+		       atomic_get(&handled), total);
+		return TC_FAIL;
+	}
+
+	snprintk(tag, sizeof(tag), "workq.submit.%s.%u_cpu", shared ? "shared" : "own", num);
+	snprintk(descr, sizeof(descr), "Submit work, %u CPU(s), %s queue", num,
+		 shared ? "shared" : "own");
+	report_stats(&s, tag, descr);
+
+	elapsed_ns = (uint32_t)timing_cycles_to_ns(elapsed);
+	printk("    Throughput : %u submissions/ms\n",
+	       (uint32_t)((uint64_t)total * NSEC_PER_MSEC / MAX(elapsed_ns, 1U)));
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	unsigned int max_producers = MIN(arch_num_cpus(), MAX_PRODUCERS);
+	int status = TC_PASS;
+	unsigned int i;
+	unsigned int j;
+
+	for (i = 0; i < MAX_PRODUCERS; i++) {
+		k_work_queue_start(&queues[i], queue_stacks[i], STACK_SIZE, QUEUE_PRIO, NULL);
+
+		for (j = 0; j < CONFIG_BENCHMARK_NUM_ITEMS; j++) {
+			k_work_init(&works[i][j], work_handler);
+		}
+	}
+
+	timing_init();
+
+	printk("Time Measurements for work queue submission with %u producer(s) of %u items\n",
+	       max_producers, CONFIG_BENCHMARK_NUM_ITEMS);
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (i = 1; (i <= max_producers) && (status == TC_PASS); i++) {
+		status = run_round(i, false);
+		if ((status == TC_PASS) && (i > 1)) {
+			status = run_round(i, true);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains the main testing module that invokes all the tests.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <string.h>
+
+#define MSG_WORDS 16
+
+#define MAX_READERS CONFIG_MP_MAX_NUM_CPUS
+
+/* Let the other threads run when there are more threads than CPUs */
+#define YIELD_INTERVAL 64
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* The main thread stops the rounds */
+#define THREAD_PRIO K_PRIO_PREEMPT(1)
+
+struct bench_msg {
+	uint32_t words[MSG_WORDS];
+};
+
+ZBUS_CHAN_DEFINE(bench_chan, struct bench_msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+
+struct thread_stats {
+	uint32_t ops;
+	uint64_t cycles;
+	uint32_t errors;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(reader_stacks, MAX_READERS, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(writer_stack, STACK_SIZE);
+static struct k_thread reader_threads[MAX_READERS];
+static struct k_thread writer_thread;
+static struct thread_stats reader_stats[MAX_READERS];
+static struct thread_stats writer_stats;
+
+static atomic_t stop;
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	struct thread_stats *stats = p1;
+	struct bench_msg msg;
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = timing_counter_get();
+	while (!atomic_get(&stop)) {
+		if (zbus_chan_read(&bench_chan, &msg, K_FOREVER) != 0) {
+			stats->errors++;
+			continue;
+		}
+
+		/* A message copied while being changed mixes two of them */
+		for (int i = 1; i < MSG_WORDS; i++) {
+			if (msg.words[i] != msg.words[0]) {
+				stats->errors++;
+				break;
+			}
+		}
+
+		if ((++stats->ops % YIELD_INTERVAL) == 0U) {
+			k_yield();
+		}
+	}
+	finish = timing_counter_get();
+
+	stats->cycles = timing_cycles_get(&start, &finish);
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	struct thread_stats *stats = p1;
+	struct bench_msg msg;
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = timing_counter_get();
+	while (!atomic_get(&stop)) {
+		for (int i = 0; i < MSG_WORDS; i++) {
+			msg.words[i] = stats->ops;
+		}
+
+		if (zbus_chan_pub(&bench_chan, &msg, K_FOREVER) != 0) {
+			stats->errors++;
+			continue;
+		}
+
+		if ((++stats->ops % YIELD_INTERVAL) == 0U) {
+			k_yield();
+		}
+	}
+	finish = timing_counter_get();
+
+	stats->cycles = timing_cycles_get(&start, &finish);
+}
+
+static void report(const char *tag, const char *what, unsigned int readers,
+		   const struct thread_stats *stats)
+{
+	uint64_t per_op = stats->cycles / MAX(stats->ops, 1U);
+	uint32_t rate = stats->ops / CONFIG_BENCHMARK_DURATION_MS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: zbus.%s.%u_reader - %s, %u reader(s) : %7llu cycles , %7u ns :\n", tag,
+	       readers, what, readers, per_op, (uint32_t)timing_cycles_to_ns(per_op));
+#else
+	ARG_UNUSED(tag);
+
+	printk("------------------------------------\n");
+	printk("%s, %u reader(s)\n", what, readers);
+	printk("    Average : %7llu cycles (%7u nsec)\n", per_op,
+	       (uint32_t)timing_cycles_to_ns(per_op));
+#endif
+	printk("    Throughput : %u operations/ms\n", rate);
+}
+
+static int run_round(unsigned int readers)
+{
+	struct thread_stats total = {0};
+
+	atomic_clear(&stop);
+	memset(reader_stats, 0, sizeof(reader_stats));
+	memset(&writer_stats, 0, sizeof(writer_stats));
+
+	for (unsigned int i = 0; i < readers; i++) {
+		k_thread_create(&reader_threads[i], reader_stacks[i],
+				K_THREAD_STACK_SIZEOF(reader_stacks[i]), reader_entry,
+				&reader_stats[i], NULL, NULL, THREAD_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_thread_create(&writer_thread, writer_stack, K_THREAD_STACK_SIZEOF(writer_stack),
+			writer_entry, &writer_stats, NULL, NULL, THREAD_PRIO, 0, K_NO_WAIT);
+
+	k_msleep(CONFIG_BENCHMARK_DURATION_MS);
+
+	atomic_set(&stop, 1);
+
+	for (unsigned int i = 0; i < readers; i++) {
+		k_thread_join(&reader_threads[i], K_FOREVER);
+
+		total.ops += reader_stats[i].ops;
+		total.cycles += reader_stats[i].cycles;
+		total.errors += reader_stats[i].errors;
+	}
+
+	k_thread_join(&writer_thread, K_FOREVER);
+
+	if ((total.errors != 0U) || (writer_stats.errors != 0U)) {
+		printk("%u reads and %u publications failed\n", total.errors, writer_stats.errors);
+		return TC_FAIL;
+	}
+
+	report("read", "Read", readers, &total);
+	report("pub", "Publish", readers, &writer_stats);
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	unsigned int num_cpus = MIN(arch_num_cpus(), MAX_READERS);
+	int status;
+
+	timing_init();
+
+	printk("Time Measurements for zbus channel reads with lock-free reads %s\n",
+	       IS_ENABLED(CONFIG_ZBUS_CHANNEL_SEQLOCK) ? "enabled" : "disabled");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	status = run_round(1);
+
+	if ((status == TC_PASS) && (num_cpus > 1)) {
+		status = run_round(num_cpus);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#define SLAB_MIN_SIZE 16
+#define SLAB_MAX_SIZE CONFIG_HEAP_MEM_POOL_SLAB_MAX_SIZE
+
+/* Larger than the caches serve, smaller than the heap */
+#define HEAP_SIZE     (4 * SLAB_MAX_SIZE)
+
+static void fill(uint8_t *mem, size_t size, uint8_t seed)
+{
+	for (size_t i = 0; i < size; i++) {
+		mem[i] = (uint8_t)(seed + i);
+	}
+}
+
+static void check(const uint8_t *mem, size_t size, uint8_t seed)
+{
+	for (size_t i = 0; i < size; i++) {
+		zassert_equal(mem[i], (uint8_t)(seed + i), "byte %zu corrupted", i);
+	}
+}
+
+ZTEST(k_malloc_slab, test_malloc_free_classes)
+{
+	for (size_t size = 1; size <= SLAB_MAX_SIZE; size = (size < 4) ? size + 1 : size * 2) {
+		/* Smallest and largest sizes of the class */
+		size_t sizes[] = { (size > SLAB_MIN_SIZE) ? (size / 2 + 1) : size,
+				   MAX(size, SLAB_MIN_SIZE) };
+		uint8_t *mem[ARRAY_SIZE(sizes)];
+		uint8_t *again;
+
+		for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+			mem[i] = k_malloc(sizes[i]);
+			zassert_not_null(mem[i], "size %zu not allocated", sizes[i]);
+			zassert_true(IS_PTR_ALIGNED(mem[i], void *), "size %zu misaligned",
+				     sizes[i]);
+			fill(mem[i], sizes[i], i);
+		}
+
+		for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+			check(mem[i], sizes[i], i);
+		}
+
+		/* A block freed is cached and handed out again */
+		k_free(mem[1]);
+		again = k_malloc(sizes[1]);
+		zassert_equal_ptr(again, mem[1], "size %zu block not cached", sizes[1]);
+
+		k_free(again);
+		k_free(mem[0]);
+	}
+
+	/* Larger sizes go to the heap */
+	uint8_t *mem = k_malloc(SLAB_MAX_SIZE + 1);
+
+	zassert_not_null(mem);
+	fill(mem, SLAB_MAX_SIZE + 1, 3);
+	check(mem, SLAB_MAX_SIZE + 1, 3);
+	k_free(mem);
+
+	k_free(NULL);
+}
+
+ZTEST(k_malloc_slab, test_realloc)
+{
+	uint8_t *mem;
+	uint8_t *ret;
+
+	mem = k_realloc(NULL, 20);
+	zassert_not_null(mem);
+	fill(mem, 20, 1);
+
+	/* Within the size class, the block is kept */
+	ret = k_realloc(mem, 32);
+	zassert_equal_ptr(ret, mem);
+	check(ret, 20, 1);
+
+	/* To a larger size class */
+	mem = k_realloc(ret, SLAB_MAX_SIZE);
+	zassert_not_null(mem);
+	check(mem, 20, 1);
+	fill(mem, SLAB_MAX_SIZE, 2);
+
+	/* Shrinking keeps the class, and the data */
+	ret = k_realloc(mem, 8);
+	zassert_equal_ptr(ret, mem);
+	check(ret, 8, 2);
+
+	/* From a size class to the heap */
+	mem = k_realloc(ret, HEAP_SIZE);
+	zassert_not_null(mem);
+	check(mem, 8, 2);
+	fill(mem, HEAP_SIZE, 3);
+
+	/* From the heap back to a size class size */
+	ret = k_realloc(mem, 24);
+	zassert_not_null(ret);
+	check(ret, 24, 3);
+
+	/* Heap blocks can be freed as size class ones */
+	zassert_is_null(k_realloc(ret, 0));
+
+	/* Too large for the heap, the block is left untouched */
+	mem = k_malloc(64);
+	zassert_not_null(mem);
+	fill(mem, 64, 4);
+	zassert_is_null(k_realloc(mem, CONFIG_HEAP_MEM_POOL_SIZE * 2));
+	check(mem, 64, 4);
+	k_free(mem);
+}
+
+ZTEST(k_malloc_slab, test_calloc)
+{
+	const size_t sizes[] = { 1, SLAB_MIN_SIZE, SLAB_MAX_SIZE, HEAP_SIZE };
+	uint8_t *mem;
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		/* Leave a dirty block in the cache */
+		mem = k_malloc(sizes[i]);
+		zassert_not_null(mem);
+		memset(mem, 0xa5, sizes[i]);
+		k_free(mem);
+
+		mem = k_calloc(1, sizes[i]);
+		zassert_not_null(mem, "size %zu not allocated", sizes[i]);
+		for (size_t j = 0; j < sizes[i]; j++) {
+			zassert_equal(mem[j], 0, "size %zu: byte %zu not zeroed", sizes[i], j);
+		}
+		k_free(mem);
+	}
+
+	zassert_is_null(k_calloc(SIZE_MAX / 2, 4), "overflow not detected");
+}
+
+/* Largest block the heap can provide, with the caches drained by the
+ * allocations failing.
+ */
+static size_t largest_alloc(void)
+{
+	for (size_t size = CONFIG_HEAP_MEM_POOL_SIZE; size > HEAP_SIZE; size -= 8) {
+		void *mem = k_malloc(size);
+
+		if (mem != NULL) {
+			k_free(mem);
+			return size;
+		}
+	}
+
+	return 0;
+}
+
+ZTEST(k_malloc_slab, test_drain_out_of_memory)
+{
+	size_t largest = largest_alloc();
+	void *mem;
+
+	zassert_true(largest > 0U, "heap too small");
+
+	/* Have the caches hold blocks of each size class */
+	for (size_t size = SLAB_MIN_SIZE; size <= SLAB_MAX_SIZE; size *= 2) {
+		mem = k_malloc(size);
+		zassert_not_null(mem);
+		k_free(mem);
+	}
+
+	/* Only fits once the cached blocks are back in the heap */
+	mem = k_malloc(largest);
+	zassert_not_null(mem, "caches not drained");
+	k_free(mem);
+
+	/* Size classes are refilled from the heap again */
+	mem = k_malloc(SLAB_MIN_SIZE);
+	zassert_not_null(mem);
+	k_free(mem);
+}
+
+ZTEST_SUITE(k_malloc_slab, NULL, NULL, ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
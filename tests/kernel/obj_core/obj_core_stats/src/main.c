@@ -693,6 +693,97 @@ ZTEST(obj_core_stats_mem_slab, test_obj_core_stats_mem_slab)
 	k_mem_slab_free(&mem_slab, mem2);
 }
 
+/***************** LOCKS *********************/
+
+#if defined(CONFIG_OBJ_CORE_STATS_MUTEX) && defined(CONFIG_OBJ_CORE_STATS_SEM)
+K_MUTEX_DEFINE(lock_mutex);
+K_SEM_DEFINE(lock_sem, 0, 1);
+K_THREAD_STACK_DEFINE(lock_thread_stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_thread lock_thread;
+
+static void lock_thread_entry(void *p1, void *p2, void *p3)
+{
+	k_mutex_lock(&lock_mutex, K_FOREVER);
+	k_mutex_unlock(&lock_mutex);
+
+	k_sem_take(&lock_sem, K_FOREVER);
+}
+
+static void test_lock_raw(const char *str, struct k_obj_core *obj_core,
+			  uint32_t acquired, uint32_t contended,
+			  struct k_thread *holder)
+{
+	struct k_lock_stats raw;
+	uint32_t waits = 0;
+	int  status;
+
+	status = k_obj_core_stats_raw(obj_core, &raw, sizeof(raw));
+	zassert_equal(status, 0,
+		      "%s: Failed to get raw stats (%d)\n", str, status);
+
+	for (int i = 0; i < CONFIG_LOCK_CONTENTION_STATS_BINS; i++) {
+		waits += raw.wait_bins[i];
+	}
+
+	zassert_equal(raw.acquired, acquired,
+		      "%s: Expected %u acquisitions, got %u\n",
+		      str, acquired, raw.acquired);
+	zassert_equal(raw.contended, contended,
+		      "%s: Expected %u waits, got %u\n",
+		      str, contended, raw.contended);
+	zassert_equal(waits, contended,
+		      "%s: Expected %u waits in histogram, got %u\n",
+		      str, contended, waits);
+	zassert_equal(raw.max_holder, (uintptr_t)holder,
+		      "%s: Expected holder %p, got 0x%lx\n",
+		      str, holder, (unsigned long)raw.max_holder);
+#ifdef CONFIG_THREAD_NAME
+	zassert_str_equal(raw.max_holder_name,
+			  (holder != NULL) ? k_thread_name_get(holder) : "",
+			  "%s: Unexpected holder name %s\n", str, raw.max_holder_name);
+#endif
+	zassert_true((contended == 0) == (raw.wait_max == 0),
+		     "%s: Unexpected max wait %u\n", str, raw.wait_max);
+}
+
+ZTEST(obj_core_stats_lock, test_obj_core_stats_lock)
+{
+	int  status;
+
+	test_lock_raw("Mutex initial", K_OBJ_CORE(&lock_mutex), 0, 0, NULL);
+	test_lock_raw("Sem initial", K_OBJ_CORE(&lock_sem), 0, 0, NULL);
+
+	/* Have the test thread wait on the mutex, then on the semaphore */
+
+	k_mutex_lock(&lock_mutex, K_FOREVER);
+	k_thread_create(&lock_thread, lock_thread_stack,
+			K_THREAD_STACK_SIZEOF(lock_thread_stack),
+			lock_thread_entry, NULL, NULL, NULL,
+			K_HIGHEST_THREAD_PRIO, 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+	k_mutex_unlock(&lock_mutex);
+	k_sleep(K_MSEC(10));
+	k_sem_give(&lock_sem);
+	k_thread_join(&lock_thread, K_FOREVER);
+
+	test_lock_raw("Mutex wait", K_OBJ_CORE(&lock_mutex), 2, 1, k_current_get());
+	test_lock_raw("Sem wait", K_OBJ_CORE(&lock_sem), 1, 1, NULL);
+
+	/* Reset the lock stats */
+
+	status = k_obj_core_stats_reset(K_OBJ_CORE(&lock_mutex));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+	status = k_obj_core_stats_reset(K_OBJ_CORE(&lock_sem));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+
+	test_lock_raw("Mutex reset", K_OBJ_CORE(&lock_mutex), 0, 0, NULL);
+	test_lock_raw("Sem reset", K_OBJ_CORE(&lock_sem), 0, 0, NULL);
+}
+
+ZTEST_SUITE(obj_core_stats_lock, NULL, NULL,
+	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX && CONFIG_OBJ_CORE_STATS_SEM */
+
 ZTEST_SUITE(obj_core_stats_system, NULL, NULL,
 	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
 
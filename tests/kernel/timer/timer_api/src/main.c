@@ -901,6 +901,110 @@ ZTEST_USER(timer_api, test_sleep_abs)
 
 }
 
+/* Durations in ticks, around and beyond the 64 ticks covered by the first
+ * level of the timing wheel, see CONFIG_TIMEOUT_QUEUE_WHEEL
+ */
+static const uint32_t cascade_durations[] = { 1, 63, 64, 65, 130, 200, 4113 };
+/* Timers stopped 20 ticks before they expire, after cascading */
+static const uint32_t cascade_abort_durations[] = { 150, 4196 };
+
+#define CASCADE_TIMERS (ARRAY_SIZE(cascade_durations) + ARRAY_SIZE(cascade_abort_durations))
+#define CASCADE_ABORT_TICKS 20
+#define CASCADE_MAX_MS 2500
+
+static struct k_timer cascade_timers[CASCADE_TIMERS];
+static volatile int64_t cascade_expired_at[CASCADE_TIMERS];
+
+static void cascade_expire(struct k_timer *timer)
+{
+	cascade_expired_at[ARRAY_INDEX(cascade_timers, timer)] = k_uptime_ticks();
+}
+
+static void wait_until_tick(int64_t tick)
+{
+	while (k_uptime_ticks() < tick) {
+		k_busy_wait(100);
+	}
+}
+
+/**
+ * @brief Test timeouts longer than a timing wheel level
+ *
+ * Starts timers expiring within, at the edge of and beyond the first level
+ * of a timing wheel, and checks that each of them expires on time. Other
+ * timers are stopped once they moved down to the first level, checking
+ * that their expiry did not change and that they never expire. Durations
+ * taking more than CASCADE_MAX_MS are skipped on slow tick rates.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start(), k_timer_stop(), k_timer_expires_ticks()
+ */
+ZTEST(timer_api, test_timer_cascade)
+{
+	uint32_t slack = k_us_to_ticks_ceil32(500) + 1;
+	int64_t expires[CASCADE_TIMERS];
+	uint32_t durations[CASCADE_TIMERS];
+	int64_t last = 0;
+
+	for (int i = 0; i < CASCADE_TIMERS; i++) {
+		durations[i] = (i < ARRAY_SIZE(cascade_durations)) ?
+			cascade_durations[i] :
+			cascade_abort_durations[i - ARRAY_SIZE(cascade_durations)];
+
+		k_timer_init(&cascade_timers[i], cascade_expire, NULL);
+		cascade_expired_at[i] = -1;
+	}
+
+	tick_sync();
+
+	for (int i = 0; i < CASCADE_TIMERS; i++) {
+		if (k_ticks_to_ms_ceil64(durations[i]) > CASCADE_MAX_MS) {
+			expires[i] = -1;
+			continue;
+		}
+
+		k_timer_start(&cascade_timers[i], K_TICKS(durations[i]), K_NO_WAIT);
+		expires[i] = k_timer_expires_ticks(&cascade_timers[i]);
+		last = MAX(last, expires[i]);
+	}
+
+	for (int i = ARRAY_SIZE(cascade_durations); i < CASCADE_TIMERS; i++) {
+		if (expires[i] < 0) {
+			continue;
+		}
+
+		wait_until_tick(expires[i] - CASCADE_ABORT_TICKS);
+
+		zassert_equal(k_timer_expires_ticks(&cascade_timers[i]), expires[i],
+			      "timer %d expiry moved", i);
+		zassert_true(k_timer_remaining_ticks(&cascade_timers[i]) <= CASCADE_ABORT_TICKS,
+			     "timer %d remaining ticks too large", i);
+		k_timer_stop(&cascade_timers[i]);
+	}
+
+	wait_until_tick(last + slack);
+
+	for (int i = 0; i < CASCADE_TIMERS; i++) {
+		if (expires[i] < 0) {
+			continue;
+		}
+
+		if (i >= ARRAY_SIZE(cascade_durations)) {
+			zassert_equal(cascade_expired_at[i], -1, "stopped timer %d expired", i);
+			continue;
+		}
+
+		zassert_not_equal(cascade_expired_at[i], -1, "timer %d of %u ticks never expired",
+				  i, durations[i]);
+		zassert_true(cascade_expired_at[i] >= expires[i],
+			     "timer %d of %u ticks expired early", i, durations[i]);
+		zassert_true(cascade_expired_at[i] <= expires[i] + slack,
+			     "timer %d of %u ticks expired %lld ticks late", i, durations[i],
+			     cascade_expired_at[i] - expires[i]);
+	}
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
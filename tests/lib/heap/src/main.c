@@ -7,6 +7,7 @@
 #include <zephyr/ztest.h>
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/heap_listener.h>
+#include <zephyr/stats/stats.h>
 #include <inttypes.h>
 
 /* Guess at a value for heap size based on available memory on the
@@ -259,6 +260,11 @@ ZTEST(lib_heap, test_solo_free_header)
 
 	TC_PRINT("Testing solo free header in a heap\n");
 
+	if (IS_ENABLED(CONFIG_SYS_HEAP_PROFILE)) {
+		/* The heap metadata doesn't leave room for a solo free header */
+		ztest_test_skip();
+	}
+
 	sys_heap_init(&heap, heapmem, SOLO_FREE_HEADER_HEAP_SZ);
 	if (sizeof(void *) > 4U) {
 		sys_heap_alloc(&heap, 1);
@@ -485,4 +491,196 @@ ZTEST(lib_heap, test_heap_listeners)
 #endif /* CONFIG_SYS_HEAP_LISTENER */
 }
 
+static uint32_t bins_total(const uint32_t *bins)
+{
+	uint32_t total = 0;
+
+	for (int i = 0; i < CONFIG_SYS_HEAP_PROFILE_BINS; i++) {
+		total += bins[i];
+	}
+
+	return total;
+}
+
+ZTEST(lib_heap, test_heap_profile)
+{
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	struct sys_heap heap;
+	struct sys_heap_profile profile;
+	size_t initial_largest;
+	void *p1, *p2, *p3;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	zassert_ok(sys_heap_profile_get(&heap, &profile));
+	zassert_equal(bins_total(profile.alloc_cycles), 0);
+	zassert_equal(bins_total(profile.free_cycles), 0);
+	zassert_equal(profile.alloc_failures, 0);
+	zassert_true(profile.largest_free_bytes > SMALL_HEAP_SZ / 2);
+	zassert_true(profile.min_largest_free_bytes <= profile.largest_free_bytes);
+	initial_largest = profile.largest_free_bytes;
+
+	/* The largest block fits, and only once */
+	p1 = sys_heap_alloc(&heap, initial_largest);
+	zassert_not_null(p1);
+	zassert_is_null(sys_heap_alloc(&heap, 1));
+	sys_heap_free(&heap, p1);
+
+	zassert_ok(sys_heap_profile_get(&heap, &profile));
+	zassert_equal(bins_total(profile.alloc_cycles), 2);
+	zassert_equal(bins_total(profile.free_cycles), 1);
+	zassert_equal(profile.alloc_failures, 1);
+	zassert_equal(profile.largest_free_bytes, initial_largest);
+	zassert_equal(profile.min_largest_free_bytes, 0);
+
+	/* Fragment the heap: a block in the middle limits the largest one */
+	zassert_ok(sys_heap_profile_reset(&heap));
+	p1 = sys_heap_alloc(&heap, initial_largest / 2);
+	p2 = sys_heap_alloc(&heap, 8);
+	p3 = sys_heap_aligned_alloc(&heap, 64, initial_largest / 4);
+	zassert_not_null(p1);
+	zassert_not_null(p2);
+	zassert_not_null(p3);
+	sys_heap_free(&heap, p1);
+	sys_heap_free(&heap, p3);
+
+	zassert_ok(sys_heap_profile_get(&heap, &profile));
+	zassert_equal(bins_total(profile.alloc_cycles), 3);
+	zassert_equal(bins_total(profile.free_cycles), 2);
+	zassert_equal(profile.alloc_failures, 0);
+	zassert_true(profile.largest_free_bytes < initial_largest);
+	zassert_true(profile.largest_free_bytes >= initial_largest / 2);
+	zassert_true(profile.min_largest_free_bytes < initial_largest / 2);
+
+	sys_heap_free(&heap, p2);
+	zassert_ok(sys_heap_profile_get(&heap, &profile));
+	zassert_equal(profile.largest_free_bytes, initial_largest);
+
+	zassert_equal(sys_heap_profile_get(NULL, &profile), -EINVAL);
+	zassert_equal(sys_heap_profile_get(&heap, NULL), -EINVAL);
+	zassert_equal(sys_heap_profile_reset(NULL), -EINVAL);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_PROFILE */
+}
+
+#ifdef CONFIG_SYS_HEAP_PROFILE_SITES
+static struct sys_heap sites_heap;
+static K_THREAD_STACK_DEFINE(site_stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_thread site_thread;
+
+static void site_thread_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sys_heap_free(&sites_heap, sys_heap_alloc(&sites_heap, 16));
+}
+#endif /* CONFIG_SYS_HEAP_PROFILE_SITES */
+
+ZTEST(lib_heap, test_heap_profile_sites)
+{
+#ifdef CONFIG_SYS_HEAP_PROFILE_SITES
+	struct sys_heap heap;
+	struct sys_heap_profile_site sites[CONFIG_SYS_HEAP_PROFILE_SITES_NUM + 1];
+	void *p1, *p2;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	zassert_ok(sys_heap_profile_sites_start(&heap));
+	zassert_equal(sys_heap_profile_sites_start(&heap), -EBUSY);
+
+	p1 = sys_heap_alloc(&heap, 32);
+	p2 = sys_heap_alloc(&heap, 64);
+	sys_heap_free(&heap, p1);
+
+	sys_heap_profile_sites_stop();
+
+	/* Not tracked anymore */
+	sys_heap_free(&heap, p2);
+
+	zassert_equal(sys_heap_profile_sites_get(sites, ARRAY_SIZE(sites)), 1);
+	zassert_equal(sites[0].thread, k_current_get());
+	zassert_equal(sites[0].alloc_count, 2);
+	zassert_equal(sites[0].free_count, 1);
+	zassert_true(sites[0].alloc_bytes >= 32 + 64);
+	zassert_true(sites[0].free_bytes >= 32);
+	zassert_true(sites[0].free_bytes < 64);
+
+	/* The site of an exited thread is released, its usage is kept */
+	sys_heap_init(&sites_heap, heapmem, SMALL_HEAP_SZ);
+	zassert_ok(sys_heap_profile_sites_start(&sites_heap));
+
+	k_thread_create(&site_thread, site_stack, K_THREAD_STACK_SIZEOF(site_stack),
+			site_thread_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_ok(k_thread_join(&site_thread, K_FOREVER));
+
+	sys_heap_profile_sites_stop();
+
+	zassert_equal(sys_heap_profile_sites_get(sites, ARRAY_SIZE(sites)), 1);
+	zassert_is_null(sites[0].thread);
+	zassert_equal(sites[0].alloc_count, 1);
+	zassert_equal(sites[0].free_count, 1);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_PROFILE_SITES */
+}
+
+#ifdef CONFIG_SYS_HEAP_PROFILE_STATS
+static int stats_value_cb(struct stats_hdr *hdr, void *arg, const char *name, uint16_t off)
+{
+	uint32_t **next = arg;
+
+	ARG_UNUSED(name);
+
+	**next = *(uint32_t *)((uint8_t *)hdr + off);
+	(*next)++;
+
+	return 0;
+}
+#endif /* CONFIG_SYS_HEAP_PROFILE_STATS */
+
+ZTEST(lib_heap, test_heap_profile_stats)
+{
+#ifdef CONFIG_SYS_HEAP_PROFILE_STATS
+	/* Registered groups cannot be removed, so the heap stays around */
+	static struct sys_heap heap;
+	static void *mem[SMALL_HEAP_SZ / sizeof(void *)];
+	struct sys_heap_profile profile;
+	struct stats_hdr *hdr;
+	/* allocs, frees, alloc_failures, alloc_cycles_max, free_cycles_max,
+	 * min_largest_free_bytes
+	 */
+	uint32_t values[6];
+	uint32_t *next = values;
+	void *p;
+
+	sys_heap_init(&heap, mem, sizeof(mem));
+	zassert_ok(sys_heap_profile_stats_register(&heap, "heap_profile_test"));
+	zassert_equal(sys_heap_profile_stats_register(&heap, "heap_profile_test"), -EALREADY);
+	zassert_equal(sys_heap_profile_stats_register(NULL, "heap_profile_test"), -EINVAL);
+
+	zassert_ok(sys_heap_profile_get(&heap, &profile));
+	p = sys_heap_alloc(&heap, profile.largest_free_bytes);
+	zassert_not_null(p);
+	zassert_is_null(sys_heap_alloc(&heap, 1));
+	sys_heap_free(&heap, p);
+
+	hdr = stats_group_find("heap_profile_test");
+	zassert_not_null(hdr);
+	zassert_equal(hdr->s_cnt, ARRAY_SIZE(values));
+	zassert_ok(stats_walk(hdr, stats_value_cb, &next));
+
+	zassert_equal(values[0], 1);
+	zassert_equal(values[1], 1);
+	zassert_equal(values[2], 1);
+	/* The slowest operations may take no cycle with a slow cycle counter */
+	zassert_equal(values[5], 0);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_PROFILE_STATS */
+}
+
 ZTEST_SUITE(lib_heap, NULL, NULL, NULL, NULL, NULL);
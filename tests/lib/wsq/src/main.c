@@ -0,0 +1,164 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/wsq.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_ITEMS  64
+#define FOR_COUNT  1000
+
+K_WSQ_DEFINE(wsq, STACK_SIZE);
+
+static struct k_work items[NUM_ITEMS];
+static atomic_t run_count;
+static K_SEM_DEFINE(done_sem, 0, NUM_ITEMS);
+
+static struct k_work blocking_item;
+static K_SEM_DEFINE(started_sem, 0, 1);
+static K_SEM_DEFINE(release_sem, 0, 1);
+static atomic_t in_handler;
+static atomic_t concurrent;
+
+static uint8_t hits[FOR_COUNT];
+
+static void count_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	atomic_inc(&run_count);
+	k_sem_give(&done_sem);
+}
+
+ZTEST(wsq, test_submit)
+{
+	atomic_set(&run_count, 0);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], count_handler);
+	}
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal(k_wsq_submit(&wsq, &items[i]), 1, "item %d not queued", i);
+	}
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_ok(k_sem_take(&done_sem, K_SECONDS(1)), "item not run");
+	}
+
+	zassert_equal(atomic_get(&run_count), NUM_ITEMS);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_false(k_work_is_pending(&items[i]), "item %d still pending", i);
+	}
+}
+
+static void blocking_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	if (atomic_inc(&in_handler) != 0) {
+		atomic_inc(&concurrent);
+	}
+
+	if (atomic_inc(&run_count) == 0) {
+		k_sem_give(&started_sem);
+		k_sem_take(&release_sem, K_FOREVER);
+	}
+
+	atomic_dec(&in_handler);
+	k_sem_give(&done_sem);
+}
+
+ZTEST(wsq, test_resubmit_running)
+{
+	atomic_set(&run_count, 0);
+	atomic_set(&in_handler, 0);
+	atomic_set(&concurrent, 0);
+	k_work_init(&blocking_item, blocking_handler);
+
+	zassert_equal(k_wsq_submit(&wsq, &blocking_item), 1);
+	zassert_ok(k_sem_take(&started_sem, K_SECONDS(1)), "item not started");
+	zassert_equal(k_work_busy_get(&blocking_item), K_WORK_RUNNING);
+
+	/* Queued again while running, and only once */
+	zassert_equal(k_wsq_submit(&wsq, &blocking_item), 2);
+	zassert_equal(k_wsq_submit(&wsq, &blocking_item), 0);
+
+	k_sem_give(&release_sem);
+
+	zassert_ok(k_sem_take(&done_sem, K_SECONDS(1)), "first run not complete");
+	zassert_ok(k_sem_take(&done_sem, K_SECONDS(1)), "second run not complete");
+	zassert_equal(atomic_get(&run_count), 2);
+	zassert_equal(atomic_get(&concurrent), 0, "handler ran concurrently");
+}
+
+static void for_fn(size_t start, size_t end, void *user_data)
+{
+	zassert_equal(user_data, hits);
+	zassert_true(start < end, "empty range");
+	zassert_true(end <= FOR_COUNT, "range out of bounds");
+
+	for (size_t i = start; i < end; i++) {
+		hits[i]++;
+	}
+}
+
+static void check_hits(size_t count)
+{
+	for (size_t i = 0; i < FOR_COUNT; i++) {
+		zassert_equal(hits[i], (i < count) ? 1 : 0, "index %u hit %u times", (unsigned int)i,
+			      hits[i]);
+	}
+}
+
+ZTEST(wsq, test_parallel_for)
+{
+	const size_t grains[] = {0, 1, 7, 100, FOR_COUNT, 2 * FOR_COUNT};
+
+	ARRAY_FOR_EACH(grains, i) {
+		memset(hits, 0, sizeof(hits));
+		k_wsq_parallel_for(&wsq, FOR_COUNT, grains[i], for_fn, hits);
+		check_hits(FOR_COUNT);
+	}
+
+	memset(hits, 0, sizeof(hits));
+	k_wsq_parallel_for(&wsq, 1, 0, for_fn, hits);
+	check_hits(1);
+
+	memset(hits, 0, sizeof(hits));
+	k_wsq_parallel_for(&wsq, 0, 0, for_fn, hits);
+	check_hits(0);
+}
+
+static void nested_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_wsq_parallel_for(&wsq, FOR_COUNT, 3, for_fn, hits);
+	k_sem_give(&done_sem);
+}
+
+ZTEST(wsq, test_parallel_for_from_worker)
+{
+	static struct k_work nested_item;
+
+	memset(hits, 0, sizeof(hits));
+	k_work_init(&nested_item, nested_handler);
+
+	zassert_equal(k_wsq_submit(&wsq, &nested_item), 1);
+	zassert_ok(k_sem_take(&done_sem, K_SECONDS(1)), "loop not complete");
+	check_hits(FOR_COUNT);
+}
+
+static void *wsq_setup(void)
+{
+	k_wsq_start(&wsq, K_PRIO_PREEMPT(1));
+
+	return NULL;
+}
+
+ZTEST_SUITE(wsq, NULL, wsq_setup, NULL, NULL, NULL);
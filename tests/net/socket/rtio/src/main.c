@@ -0,0 +1,188 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_rtio.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define BLK_SIZE 16
+
+NET_SOCKET_RTIO_IODEV_DEFINE(sock_iodev);
+RTIO_DEFINE_WITH_MEMPOOL(r, 4, 4, 8, BLK_SIZE, 4);
+
+static int sv[2];
+
+static struct rtio_cqe *wait_cqe(void)
+{
+	struct rtio_cqe *cqe = rtio_cqe_consume_block(&r);
+
+	zassert_not_null(cqe);
+
+	return cqe;
+}
+
+ZTEST(net_socket_rtio, test_read)
+{
+	static const char msg[] = "hello";
+	uint8_t buf[sizeof(msg)];
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+
+	zassert_not_null(sqe);
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, buf, sizeof(buf), buf);
+	zassert_ok(rtio_submit(&r, 0));
+
+	/* Nothing to receive yet */
+	k_msleep(10);
+	zassert_is_null(rtio_cqe_consume(&r));
+
+	zassert_equal(zsock_send(sv[1], msg, sizeof(msg), 0), sizeof(msg));
+
+	cqe = wait_cqe();
+	zassert_equal(cqe->result, sizeof(msg), "unexpected result %d", cqe->result);
+	zassert_equal_ptr(cqe->userdata, buf);
+	rtio_cqe_release(&r, cqe);
+
+	zassert_mem_equal(buf, msg, sizeof(msg));
+}
+
+ZTEST(net_socket_rtio, test_write)
+{
+	static const char msg[] = "world";
+	uint8_t buf[sizeof(msg)];
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+
+	zassert_not_null(sqe);
+	rtio_sqe_prep_write(sqe, &sock_iodev, RTIO_PRIO_NORM, (const uint8_t *)msg, sizeof(msg),
+			    NULL);
+	zassert_ok(rtio_submit(&r, 0));
+
+	cqe = wait_cqe();
+	zassert_equal(cqe->result, sizeof(msg), "unexpected result %d", cqe->result);
+	rtio_cqe_release(&r, cqe);
+
+	zassert_equal(zsock_recv(sv[1], buf, sizeof(buf), 0), sizeof(msg));
+	zassert_mem_equal(buf, msg, sizeof(msg));
+}
+
+ZTEST(net_socket_rtio, test_read_multishot)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+
+	zassert_not_null(sqe);
+	rtio_sqe_prep_read_multishot(sqe, &sock_iodev, RTIO_PRIO_NORM, NULL);
+	zassert_ok(rtio_submit(&r, 0));
+
+	for (uint8_t i = 0; i < 3; i++) {
+		zassert_equal(zsock_send(sv[1], &i, 1, 0), 1);
+
+		cqe = wait_cqe();
+		zassert_equal(cqe->result, 1, "unexpected result %d", cqe->result);
+		zassert_ok(rtio_cqe_get_mempool_buffer(&r, cqe, &buf, &buf_len));
+		zassert_equal(buf_len, 1);
+		zassert_equal(buf[0], i);
+		rtio_release_buffer(&r, buf, buf_len);
+		rtio_cqe_release(&r, cqe);
+	}
+
+	/* The end of the stream ends the read */
+	zassert_ok(zsock_close(sv[1]));
+	sv[1] = -1;
+
+	cqe = wait_cqe();
+	zassert_equal(cqe->result, 0, "unexpected result %d", cqe->result);
+	rtio_cqe_release(&r, cqe);
+
+	k_msleep(10);
+	zassert_is_null(rtio_cqe_consume(&r));
+}
+
+ZTEST(net_socket_rtio, test_detach_cancels)
+{
+	uint8_t buf[4];
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+
+	zassert_not_null(sqe);
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, buf, sizeof(buf), NULL);
+	zassert_ok(rtio_submit(&r, 0));
+
+	k_msleep(10);
+	zassert_ok(net_socket_rtio_detach(&sock_iodev));
+	zassert_equal(net_socket_rtio_detach(&sock_iodev), -EALREADY);
+
+	cqe = wait_cqe();
+	zassert_equal(cqe->result, -ECANCELED, "unexpected result %d", cqe->result);
+	rtio_cqe_release(&r, cqe);
+
+	/* Detached iodevs fail new operations */
+	sqe = rtio_sqe_acquire(&r);
+	zassert_not_null(sqe);
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, buf, sizeof(buf), NULL);
+	zassert_ok(rtio_submit(&r, 0));
+
+	cqe = wait_cqe();
+	zassert_equal(cqe->result, -EBADF, "unexpected result %d", cqe->result);
+	rtio_cqe_release(&r, cqe);
+}
+
+ZTEST(net_socket_rtio, test_cancel)
+{
+	uint8_t buf[4];
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+
+	zassert_not_null(sqe);
+	rtio_sqe_prep_read(sqe, &sock_iodev, RTIO_PRIO_NORM, buf, sizeof(buf), NULL);
+	zassert_ok(rtio_submit(&r, 0));
+
+	k_msleep(10);
+	zassert_is_null(rtio_cqe_consume(&r));
+
+	/* Completes without any data on the socket */
+	zassert_ok(rtio_sqe_cancel(sqe));
+	k_msleep(2 * CONFIG_NET_SOCKETS_RTIO_CANCEL_CHECK_MS);
+
+	cqe = rtio_cqe_consume(&r);
+	zassert_not_null(cqe);
+	zassert_equal(cqe->result, -ECANCELED, "unexpected result %d", cqe->result);
+	rtio_cqe_release(&r, cqe);
+}
+
+ZTEST(net_socket_rtio, test_attach_busy)
+{
+	zassert_equal(net_socket_rtio_attach(&sock_iodev, sv[1]), -EBUSY);
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	zassert_ok(zsock_socketpair(AF_UNIX, SOCK_STREAM, 0, sv));
+	zassert_ok(net_socket_rtio_attach(&sock_iodev, sv[0]));
+}
+
+static void after(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	(void)net_socket_rtio_detach(&sock_iodev);
+
+	for (int i = 0; i < ARRAY_SIZE(sv); i++) {
+		if (sv[i] >= 0) {
+			(void)zsock_close(sv[i]);
+			sv[i] = -1;
+		}
+	}
+}
+
+ZTEST_SUITE(net_socket_rtio, NULL, NULL, before, after, NULL);
@@ -2539,6 +2539,80 @@ ZTEST(net_socket_tcp, test_keepalive_timeout)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_v4_recvmsg_zc)
+{
+	static const char tx_buf[] = TEST_STR_SMALL TEST_STR_SMALL;
+	char rx_buf[sizeof(tx_buf)];
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct iovec iov[1];
+	struct msghdr msg;
+	void *handle;
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	size_t total = 0;
+	ssize_t recved;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, NULL, NULL);
+
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+
+	/* A single iovec, the rest of a segment stays queued for the next call */
+	while (total < strlen(tx_buf)) {
+		iov[0].iov_base = rx_buf;
+		iov[0].iov_len = sizeof(rx_buf);
+
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_iov = iov;
+		msg.msg_iovlen = ARRAY_SIZE(iov);
+		/* Flags are output only */
+		msg.msg_flags = ZSOCK_MSG_TRUNC;
+
+		recved = zsock_recvmsg_zc(new_sock, &msg, &handle, 0);
+		zassert_true(recved > 0, "recvmsg_zc failed (%d)", -errno);
+		zassert_true(total + recved <= strlen(tx_buf), "too much data");
+		zassert_equal(msg.msg_flags, 0, "unexpected flags 0x%x", msg.msg_flags);
+		zassert_equal(msg.msg_iovlen, 1, "invalid iovec count");
+		zassert_true(iov[0].iov_len >= recved, "invalid iovec length");
+		zassert_mem_equal(iov[0].iov_base, tx_buf + total, recved, "invalid data");
+
+		if (IS_ENABLED(CONFIG_NET_SOCKETS_RECV_ZEROCOPY)) {
+			zassert_not_null(handle, "data was not lent");
+			zassert_not_equal(iov[0].iov_base, rx_buf, "data was copied");
+		} else {
+			zassert_is_null(handle, "handle set when copying");
+		}
+
+		zsock_recvmsg_zc_release(handle);
+		total += recved;
+	}
+
+	/* EOF is reported once the peer closed */
+	test_close(c_sock);
+
+	iov[0].iov_base = rx_buf;
+	iov[0].iov_len = sizeof(rx_buf);
+	msg.msg_iovlen = ARRAY_SIZE(iov);
+
+	recved = zsock_recvmsg_zc(new_sock, &msg, &handle, 0);
+	zassert_equal(recved, 0, "EOF not reported (%d)", (int)recved);
+	zassert_is_null(handle, "handle set on EOF");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -3477,6 +3477,139 @@ ZTEST_USER(net_socket_udp, test_44_recvmsg_ancillary_ipv6_hoplimit_data_user)
 					    sizeof(server_addr));
 }
 
+#define MMSG_COUNT 3
+
+ZTEST(net_socket_udp, test_45_v4_sendmmsg_recvmmsg)
+{
+	static const char * const payloads[MMSG_COUNT] = { "first", "second", "third!!" };
+	char rx_buf[MMSG_COUNT][16];
+	struct mmsghdr msgvec[MMSG_COUNT];
+	struct iovec iov[MMSG_COUNT];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	int client_sock;
+	int server_sock;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	memset(msgvec, 0, sizeof(msgvec));
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		iov[i].iov_base = (void *)payloads[i];
+		iov[i].iov_len = strlen(payloads[i]);
+		msgvec[i].msg_hdr.msg_name = &server_addr;
+		msgvec[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		msgvec[i].msg_hdr.msg_iov = &iov[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgvec, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", -errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgvec[i].msg_len, strlen(payloads[i]), "invalid msg_len");
+	}
+
+	/* Let the datagrams reach the server socket */
+	k_msleep(10);
+
+	memset(msgvec, 0, sizeof(msgvec));
+	memset(rx_buf, 0, sizeof(rx_buf));
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		iov[i].iov_base = rx_buf[i];
+		iov[i].iov_len = sizeof(rx_buf[i]);
+		msgvec[i].msg_hdr.msg_iov = &iov[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgvec, MMSG_COUNT, ZSOCK_MSG_WAITFORONE);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", -errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgvec[i].msg_len, strlen(payloads[i]), "invalid msg_len");
+		zassert_mem_equal(rx_buf[i], payloads[i], strlen(payloads[i]), "invalid data");
+	}
+
+	/* Nothing left, with MSG_DONTWAIT the call must not block */
+	rv = zsock_recvmmsg(server_sock, msgvec, MMSG_COUNT, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST(net_socket_udp, test_46_v4_recvmsg_zc)
+{
+	char rx_buf[sizeof(TEST_STR_SMALL)];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in src_addr;
+	struct iovec iov[2];
+	struct msghdr msg;
+	void *handle;
+	int client_sock;
+	int server_sock;
+	ssize_t sent;
+	ssize_t recved;
+	size_t offset;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	sent = zsock_sendto(client_sock, TEST_STR_SMALL, STRLEN(TEST_STR_SMALL), 0,
+			    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(sent, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	/* The buffer is only used if the data cannot be lent */
+	memset(iov, 0, sizeof(iov));
+	iov[0].iov_base = rx_buf;
+	iov[0].iov_len = sizeof(rx_buf);
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = iov;
+	msg.msg_iovlen = ARRAY_SIZE(iov);
+	msg.msg_name = &src_addr;
+	msg.msg_namelen = sizeof(src_addr);
+
+	recved = zsock_recvmsg_zc(server_sock, &msg, &handle, 0);
+	zassert_equal(recved, STRLEN(TEST_STR_SMALL), "recvmsg_zc failed (%d)", -errno);
+	zassert_equal(msg.msg_namelen, sizeof(struct sockaddr_in), "invalid address length");
+	zassert_equal(src_addr.sin_port, client_addr.sin_port, "invalid source port");
+
+	if (IS_ENABLED(CONFIG_NET_SOCKETS_RECV_ZEROCOPY) && !k_is_user_context()) {
+		zassert_not_null(handle, "data was not lent");
+		zassert_not_equal(iov[0].iov_base, rx_buf, "data was copied");
+	} else {
+		zassert_is_null(handle, "handle set when copying");
+	}
+
+	offset = 0;
+	for (int i = 0; offset < (size_t)recved; i++) {
+		zassert_true(i < msg.msg_iovlen, "data missing from iovecs");
+		zassert_mem_equal(iov[i].iov_base, TEST_STR_SMALL + offset,
+				  MIN(iov[i].iov_len, (size_t)recved - offset), "invalid data");
+		offset += iov[i].iov_len;
+	}
+
+	zsock_recvmsg_zc_release(handle);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -116,6 +116,7 @@ static enum test_case_no {
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
 	TEST_CLIENT_SEQ_VALIDATION = 19,
 	TEST_SERVER_ACK_VALIDATION = 20,
+	TEST_SERVER_SACK_TIMESTAMPS = 21,
 } test_case_no;
 
 static enum test_state t_state;
@@ -142,6 +143,7 @@ static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_seq_validation_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_ack_validation_test(struct net_pkt *pkt);
+static void handle_server_sack_timestamps_test(struct net_pkt *pkt, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -239,6 +241,79 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options added by the peer to all its segments when enabled */
+static struct {
+	bool enabled;
+	bool sack_perm;
+	bool ts;
+	uint16_t mss;
+	uint32_t tsval;
+	/* The echoed TSval is this many ms older than the device's last one */
+	uint32_t tsecr_delay;
+	int sack_count;
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+} peer_opts;
+
+/* Options of a segment sent by the device */
+struct tester_tcp_options {
+	bool sack_perm;
+	bool ts_found;
+	uint32_t tsval;
+	uint32_t tsecr;
+	int sack_count;
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+};
+
+static struct tester_tcp_options dev_opts;
+static struct tester_tcp_options dev_syn_ack_opts;
+static uint32_t dev_tsval;
+
+static size_t peer_options_build(uint8_t flags, uint8_t *buf)
+{
+	size_t len = 0;
+
+	if ((flags & SYN) && peer_opts.mss != 0U) {
+		buf[len++] = NET_TCP_MSS_OPT;
+		buf[len++] = NET_TCP_MSS_SIZE;
+		sys_put_be16(peer_opts.mss, &buf[len]);
+		len += sizeof(uint16_t);
+	}
+
+	if ((flags & SYN) && peer_opts.sack_perm) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (peer_opts.ts) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_SIZE;
+		sys_put_be32(peer_opts.tsval, &buf[len]);
+		len += sizeof(uint32_t);
+		sys_put_be32((flags & ACK) ? dev_tsval - peer_opts.tsecr_delay : 0U, &buf[len]);
+		len += sizeof(uint32_t);
+	}
+
+	if (!(flags & SYN) && peer_opts.sack_count > 0) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_SACK_OPT;
+		buf[len++] = 2 + peer_opts.sack_count * NET_TCP_SACK_BLOCK_SIZE;
+
+		for (int i = 0; i < peer_opts.sack_count; i++) {
+			sys_put_be32(peer_opts.sack[i].left, &buf[len]);
+			len += sizeof(uint32_t);
+			sys_put_be32(peer_opts.sack[i].right, &buf[len]);
+			len += sizeof(uint32_t);
+		}
+	}
+
+	return len;
+}
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -247,13 +322,19 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      size_t len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	uint8_t peer_opts_buf[NET_TCP_MAX_OPT_SIZE];
+	const uint8_t *opts = NULL;
 	struct net_pkt *pkt;
 	struct tcphdr *th;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if (peer_opts.enabled) {
+		opts = peer_opts_buf;
+		opts_len = peer_options_build(flags, peer_opts_buf);
 	}
 
 	/* Allocate buffer */
@@ -288,11 +369,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
 	th->th_win = htons(NET_IPV6_MTU);
@@ -307,9 +384,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len > 0) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -424,6 +501,69 @@ fail:
 	return -EINVAL;
 }
 
+static int read_tcp_options(struct net_pkt *pkt, struct tcphdr *th,
+			    struct tester_tcp_options *opts)
+{
+	uint8_t buf[NET_TCP_MAX_OPT_SIZE];
+	size_t len = th->th_off * 4U - sizeof(struct tcphdr);
+	size_t i = 0;
+
+	memset(opts, 0, sizeof(*opts));
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (len > sizeof(buf) ||
+	    net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 sizeof(struct tcphdr)) < 0 ||
+	    net_pkt_read(pkt, buf, len) < 0) {
+		return -EINVAL;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	while (i < len && buf[i] != NET_TCP_END_OPT) {
+		uint8_t opt_len;
+
+		if (buf[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		opt_len = (i + 1 < len) ? buf[i + 1] : 0;
+		if (opt_len < 2 || i + opt_len > len) {
+			return -EINVAL;
+		}
+
+		switch (buf[i]) {
+		case NET_TCP_SACK_PERM_OPT:
+			opts->sack_perm = true;
+			break;
+		case NET_TCP_TIMESTAMP_OPT:
+			opts->ts_found = true;
+			opts->tsval = sys_get_be32(&buf[i + 2]);
+			opts->tsecr = sys_get_be32(&buf[i + 6]);
+			break;
+		case NET_TCP_SACK_OPT:
+			opts->sack_count = MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+					       NET_TCP_SACK_MAX_BLOCKS);
+			for (int j = 0; j < opts->sack_count; j++) {
+				uint8_t *block = &buf[i + 2 + j * NET_TCP_SACK_BLOCK_SIZE];
+
+				opts->sack[j].left = sys_get_be32(block);
+				opts->sack[j].right = sys_get_be32(block + 4);
+			}
+			break;
+		default:
+			break;
+		}
+
+		i += opt_len;
+	}
+
+	return 0;
+}
+
 static int tester_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct tcphdr th;
@@ -439,6 +579,22 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 		goto fail;
 	}
 
+	if (peer_opts.enabled) {
+		ret = read_tcp_options(pkt, &th, &dev_opts);
+		if (ret < 0) {
+			goto fail;
+		}
+
+		/* The peer echoes the last timestamp it got */
+		if (dev_opts.ts_found) {
+			dev_tsval = dev_opts.tsval;
+		}
+
+		if ((th.th_flags & (SYN | ACK)) == (SYN | ACK)) {
+			dev_syn_ack_opts = dev_opts;
+		}
+	}
+
 	switch (test_case_no) {
 	case TEST_CLIENT_IPV4:
 	case TEST_CLIENT_IPV6:
@@ -494,6 +650,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_SERVER_ACK_VALIDATION:
 		handle_server_ack_validation_test(pkt);
 		break;
+	case TEST_SERVER_SACK_TIMESTAMPS:
+		handle_server_sack_timestamps_test(pkt, &th);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -3002,4 +3161,432 @@ ZTEST(net_tcp, test_server_ack_validation)
 	net_context_put(accepted_ctx);
 }
 
-ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
+#if defined(CONFIG_NET_TCP_SACK) && defined(CONFIG_NET_TCP_TIMESTAMPS)
+#define SACK_TS_PEER_MSS 100
+#define SACK_TS_DATA_LEN 400
+/* Time allowed between the device's last TSval and an RTT sample */
+#define SACK_TS_RTT_SLACK_MS 20
+
+struct sack_ts_segment {
+	uint32_t seq;
+	uint32_t ack;
+	uint8_t flags;
+	size_t len;
+	struct tester_tcp_options opts;
+};
+
+static struct sack_ts_segment sack_ts_segs[16];
+static int sack_ts_seg_count;
+static K_SEM_DEFINE(sack_ts_sem, 0, K_SEM_MAX_LIMIT);
+
+static void handle_server_sack_timestamps_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	struct sack_ts_segment *seg;
+
+	if (sack_ts_seg_count >= ARRAY_SIZE(sack_ts_segs)) {
+		zassert_true(false, "Too many segments sent");
+		return;
+	}
+
+	seg = &sack_ts_segs[sack_ts_seg_count];
+	seg->seq = ntohl(th->th_seq);
+	seg->ack = ntohl(th->th_ack);
+	seg->flags = th->th_flags;
+	seg->len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		   net_pkt_ip_opts_len(pkt) - th->th_off * 4U;
+	seg->opts = dev_opts;
+
+	sack_ts_seg_count++;
+	k_sem_give(&sack_ts_sem);
+}
+
+static void sack_ts_reset(void)
+{
+	sack_ts_seg_count = 0;
+	k_sem_reset(&sack_ts_sem);
+}
+
+static void sack_ts_wait(int count, int line)
+{
+	for (int i = 0; i < count; i++) {
+		if (k_sem_take(&sack_ts_sem, K_MSEC(500)) != 0) {
+			zassert_true(false, "segment %d not sent (line %d)", i, line);
+		}
+	}
+}
+
+static void sack_ts_recv(struct net_pkt *pkt)
+{
+	int ret;
+
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+}
+
+static void sack_ts_abort(struct net_context *ctx)
+{
+	/* Just send a RST packet to abort the underlying connection, so that
+	 * the testcase does not need to implement full TCP closing handshake.
+	 */
+	sack_ts_recv(prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+/* Verify that the smoothed RTT and its variation were updated with a single
+ * sample at most SACK_TS_RTT_SLACK_MS longer than rtt, see RFC6298 ch 2.
+ */
+static void verify_rtt_sample(struct tcp *conn, bool measured, uint16_t srtt,
+			      uint16_t rttvar, uint32_t rtt)
+{
+	zassert_true(conn->rtt_measured, "RTT not measured");
+
+	for (uint32_t r = rtt; r <= rtt + SACK_TS_RTT_SLACK_MS; r++) {
+		uint32_t exp_srtt = r;
+		uint32_t exp_rttvar = r / 2U;
+
+		if (measured) {
+			uint32_t delta = (srtt > r) ? srtt - r : r - srtt;
+
+			exp_rttvar = (3U * rttvar + delta) / 4U;
+			exp_srtt = (7U * srtt + r) / 8U;
+		}
+
+		if (conn->srtt == exp_srtt && conn->rttvar == exp_rttvar) {
+			return;
+		}
+	}
+
+	zassert_true(false, "Unexpected srtt %u rttvar %u for an RTT of %u ms",
+		     conn->srtt, conn->rttvar, rtt);
+}
+
+/* Test the negotiation of the SACK and timestamps options: the SYN-ACK
+ * carries both options when the peer offers them and echoes the peer's
+ * TSval, otherwise neither of them is used on the connection.
+ */
+ZTEST(net_tcp, test_server_sack_timestamps_negotiation)
+{
+	struct net_context *ctx;
+
+	peer_opts.enabled = true;
+	peer_opts.sack_perm = true;
+	peer_opts.ts = true;
+	peer_opts.tsval = 1000;
+
+	ctx = create_server_socket(0, 0);
+
+	zassert_true(dev_syn_ack_opts.sack_perm, "SACK not permitted in the SYN-ACK");
+	zassert_true(dev_syn_ack_opts.ts_found, "No timestamp in the SYN-ACK");
+	zassert_equal(dev_syn_ack_opts.tsecr, 1000, "Wrong TSecr %u in the SYN-ACK",
+		      dev_syn_ack_opts.tsecr);
+	zassert_true(accepted_ctx->tcp->sack_ok, "SACK not enabled");
+	zassert_true(accepted_ctx->tcp->ts_ok, "Timestamps not enabled");
+
+	test_case_no = TEST_SERVER_SACK_TIMESTAMPS;
+	sack_ts_reset();
+	sack_ts_abort(ctx);
+
+	/* Without the options from the peer they are not used */
+	peer_opts.sack_perm = false;
+	peer_opts.ts = false;
+
+	ctx = create_server_socket(0, 0);
+
+	zassert_false(dev_syn_ack_opts.sack_perm, "SACK permitted in the SYN-ACK");
+	zassert_false(dev_syn_ack_opts.ts_found, "Timestamp in the SYN-ACK");
+	zassert_false(accepted_ctx->tcp->sack_ok, "SACK enabled");
+	zassert_false(accepted_ctx->tcp->ts_ok, "Timestamps enabled");
+
+	test_case_no = TEST_SERVER_SACK_TIMESTAMPS;
+	sack_ts_reset();
+	sack_ts_abort(ctx);
+}
+
+/* Test the receiver side:
+ *   send out-of-order data, expect a duplicate ACK reporting it in a SACK
+ *   block and echoing the TSval of the last in-order segment,
+ *   send adjacent out-of-order data, expect the SACK block to grow,
+ *   fill the hole, expect the cumulative ACK without SACK block and the
+ *   TSval of the segment filling the hole echoed.
+ */
+ZTEST(net_tcp, test_server_sack_timestamps_receiver)
+{
+	const uint8_t *data = lorem_ipsum + 10;
+	struct sack_ts_segment *seg;
+	struct net_context *ctx;
+	uint32_t base;
+
+	peer_opts.enabled = true;
+	peer_opts.sack_perm = true;
+	peer_opts.ts = true;
+	peer_opts.tsval = 1000;
+
+	ctx = create_server_socket(0, 0);
+	base = seq;
+
+	test_case_no = TEST_SERVER_SACK_TIMESTAMPS;
+	sack_ts_reset();
+
+	/* Out-of-order data does not update the timestamp to echo */
+	peer_opts.tsval = 2000;
+	seq = base + 10;
+	sack_ts_recv(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+					 &data[10], 10));
+	sack_ts_wait(1, __LINE__);
+
+	seg = &sack_ts_segs[0];
+	zassert_equal(seg->flags, ACK, "Not a pure ACK (0x%02x)", seg->flags);
+	zassert_equal(seg->ack, base, "Wrong ACK %u, expected %u", seg->ack, base);
+	zassert_equal(seg->opts.sack_count, 1, "Wrong SACK block count %d",
+		      seg->opts.sack_count);
+	zassert_equal(seg->opts.sack[0].left, base + 10, "Wrong SACK block left edge");
+	zassert_equal(seg->opts.sack[0].right, base + 20, "Wrong SACK block right edge");
+	zassert_true(seg->opts.ts_found, "No timestamp in the ACK");
+	zassert_equal(seg->opts.tsecr, 1000, "Wrong TSecr %u", seg->opts.tsecr);
+
+	peer_opts.tsval = 2500;
+	seq = base + 20;
+	sack_ts_recv(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+					 &data[20], 10));
+	sack_ts_wait(1, __LINE__);
+
+	seg = &sack_ts_segs[1];
+	zassert_equal(seg->ack, base, "Wrong ACK %u, expected %u", seg->ack, base);
+	zassert_equal(seg->opts.sack_count, 1, "Wrong SACK block count %d",
+		      seg->opts.sack_count);
+	zassert_equal(seg->opts.sack[0].left, base + 10, "Wrong SACK block left edge");
+	zassert_equal(seg->opts.sack[0].right, base + 30, "Wrong SACK block right edge");
+	zassert_equal(seg->opts.tsecr, 1000, "Wrong TSecr %u", seg->opts.tsecr);
+	zassert_true((int32_t)(seg->opts.tsval - sack_ts_segs[0].opts.tsval) >= 0,
+		     "TSval went backwards");
+
+	/* Filling the hole acknowledges all the queued data */
+	peer_opts.tsval = 3000;
+	seq = base;
+	sack_ts_recv(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+					 data, 10));
+	sack_ts_wait(1, __LINE__);
+
+	seg = &sack_ts_segs[2];
+	zassert_equal(seg->ack, base + 30, "Wrong ACK %u, expected %u", seg->ack, base + 30);
+	zassert_equal(seg->opts.sack_count, 0, "SACK block without out-of-order data");
+	zassert_equal(seg->opts.tsecr, 3000, "Wrong TSecr %u", seg->opts.tsecr);
+	zassert_true((int32_t)(seg->opts.tsval - sack_ts_segs[1].opts.tsval) >= 0,
+		     "TSval went backwards");
+
+	seq = base + 30;
+	sack_ts_abort(ctx);
+}
+
+/* Test the sender side:
+ *   send data in five segments, the peer SACKs the third and the fifth one
+ *   after the first one is acknowledged, expect the scoreboard to hold both
+ *   blocks and an RTT sample from the echoed timestamp,
+ *   send three duplicate ACKs, expect only the second and the fourth
+ *   segment, the holes, to be retransmitted,
+ *   acknowledge all the data, expect the scoreboard to be empty and a
+ *   second RTT sample.
+ */
+ZTEST(net_tcp, test_server_sack_timestamps_sender)
+{
+	uint32_t off[6];
+	struct net_context *ctx;
+	struct tcp *conn;
+	bool measured;
+	uint16_t srtt, rttvar;
+	uint32_t base;
+	uint32_t rtt;
+	int ret;
+
+	peer_opts.enabled = true;
+	peer_opts.sack_perm = true;
+	peer_opts.ts = true;
+	peer_opts.mss = SACK_TS_PEER_MSS;
+	peer_opts.tsval = 1000;
+
+	ctx = create_server_socket(0, 0);
+	conn = accepted_ctx->tcp;
+	base = ack;
+
+	test_case_no = TEST_SERVER_SACK_TIMESTAMPS;
+	sack_ts_reset();
+
+	/* Send the segments right away so they can be checked one by one */
+	conn->tcp_nodelay = true;
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, SACK_TS_DATA_LEN, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, SACK_TS_DATA_LEN, "Failed to send data to peer %d", ret);
+
+	sack_ts_wait(5, __LINE__);
+
+	/* The timestamp option is taken from the MSS */
+	zassert_equal(sack_ts_segs[0].len, SACK_TS_PEER_MSS - 12U, "Wrong segment length %zu",
+		      sack_ts_segs[0].len);
+
+	for (int i = 0; i < 5; i++) {
+		off[i] = sack_ts_segs[i].seq - base;
+		zassert_true(sack_ts_segs[i].opts.ts_found, "No timestamp in segment %d", i);
+		zassert_equal(sack_ts_segs[i].opts.tsecr, 1000, "Wrong TSecr %u in segment %d",
+			      sack_ts_segs[i].opts.tsecr, i);
+		zassert_equal(sack_ts_segs[i].opts.sack_count, 0, "SACK block in segment %d", i);
+	}
+
+	off[5] = off[4] + sack_ts_segs[4].len;
+	zassert_equal(off[0], 0, "Wrong first segment");
+	zassert_equal(off[5], SACK_TS_DATA_LEN, "Not all the data sent");
+
+	/* Acknowledge the first segment, SACK the third and the fifth ones */
+	measured = conn->rtt_measured;
+	srtt = conn->srtt;
+	rttvar = conn->rttvar;
+
+	sack_ts_reset();
+	peer_opts.tsval = 1100;
+	peer_opts.tsecr_delay = 50;
+	peer_opts.sack_count = 2;
+	peer_opts.sack[0].left = base + off[2];
+	peer_opts.sack[0].right = base + off[3];
+	peer_opts.sack[1].left = base + off[4];
+	peer_opts.sack[1].right = base + off[5];
+	ack = base + off[1];
+
+	/* Lower bound of the RTT computed from the echoed timestamp */
+	rtt = k_uptime_get_32() - (dev_tsval - peer_opts.tsecr_delay);
+	sack_ts_recv(prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+	k_msleep(10);
+
+	verify_rtt_sample(conn, measured, srtt, rttvar, rtt);
+	zassert_equal(conn->sack_sb_count, 2, "Wrong scoreboard size %u", conn->sack_sb_count);
+	zassert_equal(conn->sack_sb[0].left, base + off[2], "Wrong scoreboard block");
+	zassert_equal(conn->sack_sb[0].right, base + off[3], "Wrong scoreboard block");
+	zassert_equal(conn->sack_sb[1].left, base + off[4], "Wrong scoreboard block");
+	zassert_equal(conn->sack_sb[1].right, base + off[5], "Wrong scoreboard block");
+
+	/* Only the holes are retransmitted on the third duplicate ACK */
+	peer_opts.tsecr_delay = 0;
+	for (int i = 0; i < 3; i++) {
+		sack_ts_recv(prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+	}
+
+	sack_ts_wait(2, __LINE__);
+	k_msleep(30);
+
+	zassert_equal(sack_ts_seg_count, 2, "Wrong number of retransmissions %d",
+		      sack_ts_seg_count);
+	zassert_equal(sack_ts_segs[0].seq, base + off[1], "First hole not retransmitted");
+	zassert_equal(sack_ts_segs[0].len, off[2] - off[1], "Wrong retransmission length");
+	zassert_equal(sack_ts_segs[1].seq, base + off[3], "Second hole not retransmitted");
+	zassert_equal(sack_ts_segs[1].len, off[4] - off[3], "Wrong retransmission length");
+
+	/* Acknowledge all the data */
+	measured = conn->rtt_measured;
+	srtt = conn->srtt;
+	rttvar = conn->rttvar;
+
+	peer_opts.tsval = 1200;
+	peer_opts.tsecr_delay = 200;
+	peer_opts.sack_count = 0;
+	ack = base + SACK_TS_DATA_LEN;
+
+	rtt = k_uptime_get_32() - (dev_tsval - peer_opts.tsecr_delay);
+	sack_ts_recv(prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+	k_msleep(10);
+
+	verify_rtt_sample(conn, measured, srtt, rttvar, rtt);
+	zassert_equal(conn->sack_sb_count, 0, "Scoreboard not pruned");
+
+	sack_ts_abort(ctx);
+}
+
+/* Test SACK blocks covering queued data which has not been sent:
+ *   send data, the last part of it is held back by the Nagle algorithm,
+ *   acknowledge the first segment and SACK the data not sent, expect the
+ *   block to be ignored and nothing to be sent,
+ *   send three duplicate ACKs with the same block, expect a regular fast
+ *   retransmit of the first unacknowledged segment only.
+ */
+ZTEST(net_tcp, test_server_sack_beyond_sent_data)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t sent;
+	uint32_t base;
+	int ret;
+
+	peer_opts.enabled = true;
+	peer_opts.sack_perm = true;
+	peer_opts.ts = true;
+	peer_opts.mss = SACK_TS_PEER_MSS;
+	peer_opts.tsval = 1000;
+
+	ctx = create_server_socket(0, 0);
+	conn = accepted_ctx->tcp;
+	base = ack;
+
+	test_case_no = TEST_SERVER_SACK_TIMESTAMPS;
+	sack_ts_reset();
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, SACK_TS_DATA_LEN, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, SACK_TS_DATA_LEN, "Failed to send data to peer %d", ret);
+
+	/* Full segments are sent, the remainder waits for an ACK */
+	sack_ts_wait(4, __LINE__);
+	k_msleep(30);
+
+	zassert_equal(sack_ts_seg_count, 4, "Wrong number of segments %d", sack_ts_seg_count);
+	sent = sack_ts_segs[3].seq + sack_ts_segs[3].len - base;
+	zassert_true(sent < SACK_TS_DATA_LEN, "No data held back");
+
+	sack_ts_reset();
+	peer_opts.tsval = 1100;
+	peer_opts.sack_count = 1;
+	peer_opts.sack[0].left = base + sent + 8;
+	peer_opts.sack[0].right = base + SACK_TS_DATA_LEN;
+	ack = base + sack_ts_segs[0].len;
+
+	sack_ts_recv(prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+	k_msleep(30);
+
+	zassert_equal(conn->sack_sb_count, 0, "Block of data not sent accepted");
+	zassert_equal(sack_ts_seg_count, 0, "Unexpected segment sent");
+
+	/* Without a valid block the whole first segment is retransmitted */
+	for (int i = 0; i < 3; i++) {
+		sack_ts_recv(prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+	}
+
+	sack_ts_wait(1, __LINE__);
+	k_msleep(30);
+
+	zassert_equal(sack_ts_seg_count, 1, "Wrong number of retransmissions %d",
+		      sack_ts_seg_count);
+	zassert_equal(sack_ts_segs[0].seq, ack, "Wrong retransmission");
+	zassert_equal(conn->sack_sb_count, 0, "Block of data not sent accepted");
+
+	sack_ts_abort(ctx);
+}
+#else
+static void handle_server_sack_timestamps_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(th);
+}
+#endif /* CONFIG_NET_TCP_SACK && CONFIG_NET_TCP_TIMESTAMPS */
+
+static void net_tcp_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&peer_opts, 0, sizeof(peer_opts));
+}
+
+ZTEST_SUITE(net_tcp, NULL, presetup, net_tcp_before, NULL, NULL);
@@ -0,0 +1,390 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
+
+#include <string.h>
+#include <errno.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/ztest.h>
+
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_private.h"
+
+#define TEST_SRC_PORT 4242
+#define TEST_DST_PORT 8080
+#define TEST_SEQ      0xfffff000U
+#define TEST_ACK      0x12345678U
+
+#define MAX_FRAMES 4
+#define FRAME_MAX  2600
+#define WAIT_TIME  K_MSEC(500)
+
+static struct in_addr in4addr_my = { { { 192, 0, 2, 1 } } };
+static struct in_addr in4addr_dst = { { { 192, 0, 2, 2 } } };
+static struct in6_addr in6addr_my = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr in6addr_dst = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					   0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+static uint8_t lladdr_dst[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x02 };
+
+struct eth_context {
+	struct net_if *iface;
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_context_sw;
+static struct eth_context eth_context_tso;
+
+/* Frames handed to the drivers, in order */
+static uint8_t frames[MAX_FRAMES][FRAME_MAX];
+static size_t frame_len[MAX_FRAMES];
+static int frame_count;
+
+static K_SEM_DEFINE(frame_sent, 0, UINT_MAX);
+
+static uint8_t payload[2500];
+
+static void eth_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	context->iface = iface;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_tx(const struct device *dev, struct net_pkt *pkt)
+{
+	size_t len = net_pkt_get_len(pkt);
+	struct net_eth_hdr hdr;
+
+	ARG_UNUSED(dev);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_read(pkt, &hdr, sizeof(hdr)) < 0) {
+		return -EIO;
+	}
+
+	/* Only the TCP packets of the test are recorded */
+	if (hdr.type != htons(NET_ETH_PTYPE_IP) && hdr.type != htons(NET_ETH_PTYPE_IPV6)) {
+		return 0;
+	}
+
+	zassert_true(frame_count < MAX_FRAMES, "Too many frames");
+	zassert_true(len <= FRAME_MAX, "Frame too long (%zu)", len);
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_read(pkt, frames[frame_count], len) < 0) {
+		return -EIO;
+	}
+
+	frame_len[frame_count++] = len;
+	k_sem_give(&frame_sent);
+
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_sw_caps(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_tso_caps(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return ETHERNET_HW_TSO;
+}
+
+static struct ethernet_api api_funcs_sw = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_sw_caps,
+	.send = eth_tx,
+};
+
+static struct ethernet_api api_funcs_tso = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_tso_caps,
+	.send = eth_tx,
+};
+
+static int eth_init(const struct device *dev)
+{
+	struct eth_context *context = dev->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = sys_rand8_get();
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_gso_sw_test, "eth_gso_sw_test",
+		    eth_init, NULL, &eth_context_sw, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &api_funcs_sw, NET_ETH_MTU);
+
+ETH_NET_DEVICE_INIT(eth_gso_tso_test, "eth_gso_tso_test",
+		    eth_init, NULL, &eth_context_tso, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &api_funcs_tso, NET_ETH_MTU);
+
+/* Ones' complement sum of a buffer in network byte order */
+static uint32_t chksum_add(uint32_t sum, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i + 1 < len; i += 2) {
+		sum += sys_get_be16(&data[i]);
+	}
+
+	if (len & 1) {
+		sum += data[len - 1] << 8;
+	}
+
+	return sum;
+}
+
+static uint16_t chksum_fold(uint32_t sum)
+{
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+/* A buffer with a valid checksum sums up to 0xffff */
+static bool tcp_chksum_valid(sa_family_t family, const uint8_t *ip, size_t tcp_len)
+{
+	uint8_t pseudo[4];
+	uint32_t sum = 0;
+
+	sys_put_be16(IPPROTO_TCP, &pseudo[0]);
+	sys_put_be16(tcp_len, &pseudo[2]);
+
+	if (family == AF_INET) {
+		const struct net_ipv4_hdr *hdr = (const struct net_ipv4_hdr *)ip;
+
+		sum = chksum_add(sum, hdr->src, sizeof(hdr->src) + sizeof(hdr->dst));
+		sum = chksum_add(sum, pseudo, sizeof(pseudo));
+		sum = chksum_add(sum, ip + sizeof(*hdr), tcp_len);
+	} else {
+		const struct net_ipv6_hdr *hdr = (const struct net_ipv6_hdr *)ip;
+
+		sum = chksum_add(sum, hdr->src, sizeof(hdr->src) + sizeof(hdr->dst));
+		sum = chksum_add(sum, pseudo, sizeof(pseudo));
+		sum = chksum_add(sum, ip + sizeof(*hdr), tcp_len);
+	}
+
+	return chksum_fold(sum) == 0xffff;
+}
+
+static struct net_if *test_iface(bool tso)
+{
+	struct net_if *iface = tso ? eth_context_tso.iface : eth_context_sw.iface;
+
+	zassert_not_null(iface, "Interface not initialized");
+
+	return iface;
+}
+
+/* Build a GSO packet the way TCP does and send it on the interface */
+static void send_gso_pkt(struct net_if *iface, sa_family_t family,
+			 size_t len, uint16_t gso_size)
+{
+	struct net_tcp_hdr tcp_hdr = { 0 };
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface, 0, family, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	ret = net_pkt_alloc_buffer_raw(pkt, len, K_NO_WAIT);
+	zassert_equal(ret, 0, "Cannot allocate payload (%d)", ret);
+
+	if (family == AF_INET) {
+		ret = net_ipv4_create(pkt, &in4addr_my, &in4addr_dst);
+	} else {
+		ret = net_ipv6_create(pkt, &in6addr_my, &in6addr_dst);
+	}
+
+	zassert_equal(ret, 0, "Cannot create IP header (%d)", ret);
+
+	tcp_hdr.src_port = htons(TEST_SRC_PORT);
+	tcp_hdr.dst_port = htons(TEST_DST_PORT);
+	sys_put_be32(TEST_SEQ, tcp_hdr.seq);
+	sys_put_be32(TEST_ACK, tcp_hdr.ack);
+	tcp_hdr.offset = (sizeof(tcp_hdr) / 4) << 4;
+	tcp_hdr.flags = ACK | PSH;
+	sys_put_be16(0xffff, tcp_hdr.wnd);
+
+	zassert_equal(net_pkt_write(pkt, &tcp_hdr, sizeof(tcp_hdr)), 0, "TCP header");
+	zassert_equal(net_pkt_write(pkt, payload, len), 0, "Payload");
+
+	net_pkt_set_gso_size(pkt, gso_size);
+	net_pkt_cursor_init(pkt);
+
+	/* Known peer, so no neighbor resolution is needed */
+	(void)net_linkaddr_set(net_pkt_lladdr_dst(pkt), lladdr_dst, sizeof(lladdr_dst));
+
+	if (family == AF_INET) {
+		ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	} else {
+		ret = net_ipv6_finalize(pkt, IPPROTO_TCP);
+	}
+
+	zassert_equal(ret, 0, "Cannot finalize packet (%d)", ret);
+
+	zassert_equal(net_if_send_data(iface, pkt), NET_OK, "Send failed");
+}
+
+static void wait_frames(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_equal(k_sem_take(&frame_sent, WAIT_TIME), 0,
+			      "Frame %d of %d not sent", i, count);
+	}
+
+	/* No frame after the expected ones */
+	zassert_not_equal(k_sem_take(&frame_sent, K_MSEC(50)), 0, "Extra frame sent");
+	zassert_equal(frame_count, count, "Invalid number of frames");
+}
+
+/* Check the frames are the segments of the payload sent by send_gso_pkt() */
+static void verify_segments(sa_family_t family, size_t len, uint16_t gso_size, bool csum)
+{
+	size_t ip_len = family == AF_INET ? sizeof(struct net_ipv4_hdr) :
+					    sizeof(struct net_ipv6_hdr);
+	size_t hdr_len = sizeof(struct net_eth_hdr) + ip_len + sizeof(struct net_tcp_hdr);
+	size_t offset = 0;
+
+	for (int i = 0; i < frame_count; i++) {
+		const uint8_t *ip = &frames[i][sizeof(struct net_eth_hdr)];
+		const struct net_tcp_hdr *tcp_hdr = (const struct net_tcp_hdr *)(ip + ip_len);
+		size_t seg_len = MIN(gso_size, len - offset);
+
+		zassert_equal(frame_len[i], hdr_len + seg_len,
+			      "Segment %d: invalid length %zu", i, frame_len[i]);
+
+		if (family == AF_INET) {
+			const struct net_ipv4_hdr *hdr = (const struct net_ipv4_hdr *)ip;
+
+			zassert_equal(ntohs(hdr->len), ip_len + sizeof(*tcp_hdr) + seg_len,
+				      "Segment %d: invalid IPv4 length", i);
+			zassert_equal(chksum_fold(chksum_add(0, ip, ip_len)), 0xffff,
+				      "Segment %d: invalid IPv4 header checksum", i);
+		} else {
+			const struct net_ipv6_hdr *hdr = (const struct net_ipv6_hdr *)ip;
+
+			zassert_equal(ntohs(hdr->len), sizeof(*tcp_hdr) + seg_len,
+				      "Segment %d: invalid IPv6 length", i);
+		}
+
+		zassert_equal(ntohs(tcp_hdr->src_port), TEST_SRC_PORT, "Invalid source port");
+		zassert_equal(ntohs(tcp_hdr->dst_port), TEST_DST_PORT, "Invalid destination port");
+		zassert_equal(sys_get_be32(tcp_hdr->seq), (uint32_t)(TEST_SEQ + offset),
+			      "Segment %d: invalid sequence number", i);
+		zassert_equal(sys_get_be32(tcp_hdr->ack), TEST_ACK,
+			      "Segment %d: invalid acknowledgment number", i);
+
+		if (csum) {
+			zassert_true(tcp_chksum_valid(family, ip, sizeof(*tcp_hdr) + seg_len),
+				     "Segment %d: invalid TCP checksum", i);
+		}
+
+		zassert_mem_equal(&frames[i][hdr_len], &payload[offset], seg_len,
+				  "Segment %d: invalid payload", i);
+
+		offset += seg_len;
+	}
+
+	zassert_equal(offset, len, "Payload not sent entirely");
+}
+
+static void test_gso(sa_family_t family, size_t len, uint16_t gso_size)
+{
+	int count = DIV_ROUND_UP(len, gso_size);
+
+	send_gso_pkt(test_iface(false), family, len, gso_size);
+	wait_frames(count);
+	verify_segments(family, len, gso_size, true);
+}
+
+ZTEST(net_tcp_gso, test_ipv4_segments)
+{
+	/* Last segment shorter than the others */
+	test_gso(AF_INET, 2500, 1000);
+}
+
+ZTEST(net_tcp_gso, test_ipv6_segments)
+{
+	test_gso(AF_INET6, 2500, 1000);
+}
+
+ZTEST(net_tcp_gso, test_ipv4_full_segments)
+{
+	/* No empty segment when the payload is a multiple of the segment size */
+	test_gso(AF_INET, 2 * 1220, 1220);
+}
+
+ZTEST(net_tcp_gso, test_ipv6_single_segment)
+{
+	test_gso(AF_INET6, 500, 1000);
+}
+
+ZTEST(net_tcp_gso, test_tso_offloaded)
+{
+	/* The driver segments the packet itself, so it gets it as is */
+	send_gso_pkt(test_iface(true), AF_INET, 2500, 1000);
+	wait_frames(1);
+	verify_segments(AF_INET, 2500, 2500, false);
+}
+
+static void *net_tcp_gso_setup(void)
+{
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (uint8_t)(i * 7 + i / 251);
+	}
+
+	net_if_up(test_iface(false));
+	net_if_up(test_iface(true));
+
+	return NULL;
+}
+
+static void net_tcp_gso_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&frame_sent);
+	memset(frame_len, 0, sizeof(frame_len));
+	frame_count = 0;
+}
+
+ZTEST_SUITE(net_tcp_gso, NULL, net_tcp_gso_setup, net_tcp_gso_before, NULL, NULL);
@@ -0,0 +1,209 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/fs_sys.h>
+#include <zephyr/fs/fs_rtio.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define TEST_FS_MNTP "/RAM:"
+#define TEST_FILE    TEST_FS_MNTP "/file"
+#define BLK_SIZE     8
+
+/* Single file RAM file system */
+static uint8_t file_data[64];
+static size_t file_len;
+static size_t file_pos;
+
+static int ram_open(struct fs_file_t *zfp, const char *name, fs_mode_t flags)
+{
+	zfp->filep = file_data;
+	file_pos = 0;
+
+	if ((flags & FS_O_TRUNC) != 0) {
+		file_len = 0;
+	}
+
+	return 0;
+}
+
+static int ram_close(struct fs_file_t *zfp)
+{
+	return 0;
+}
+
+static ssize_t ram_read(struct fs_file_t *zfp, void *ptr, size_t size)
+{
+	size = MIN(size, file_len - file_pos);
+	memcpy(ptr, &file_data[file_pos], size);
+	file_pos += size;
+
+	return size;
+}
+
+static ssize_t ram_write(struct fs_file_t *zfp, const void *ptr, size_t size)
+{
+	size = MIN(size, sizeof(file_data) - file_pos);
+	memcpy(&file_data[file_pos], ptr, size);
+	file_pos += size;
+	file_len = MAX(file_len, file_pos);
+
+	return size;
+}
+
+static int ram_lseek(struct fs_file_t *zfp, off_t offset, int whence)
+{
+	if ((whence != FS_SEEK_SET) || (offset < 0) || (offset > file_len)) {
+		return -EINVAL;
+	}
+
+	file_pos = offset;
+
+	return 0;
+}
+
+static int ram_mount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static int ram_unmount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static struct fs_file_system_t ram_fs = {
+	.open = ram_open,
+	.close = ram_close,
+	.read = ram_read,
+	.write = ram_write,
+	.lseek = ram_lseek,
+	.mount = ram_mount,
+	.unmount = ram_unmount,
+};
+
+static struct fs_mount_t ram_mnt = {
+	.type = FS_LITTLEFS,
+	.mnt_point = TEST_FS_MNTP,
+};
+
+static struct fs_file_t file;
+
+FS_RTIO_IODEV_DEFINE(file_iodev, &file);
+RTIO_DEFINE_WITH_MEMPOOL(r, 4, 4, 4, BLK_SIZE, 4);
+
+static void rewind_cb(struct rtio *r, const struct rtio_sqe *sqe, void *arg0)
+{
+	zassert_ok(fs_seek(arg0, 0, FS_SEEK_SET));
+}
+
+ZTEST(fs_rtio, test_write_read_chain)
+{
+	static const uint8_t msg[] = "data logger";
+	uint8_t buf[sizeof(msg)];
+	struct rtio_sqe *wr = rtio_sqe_acquire(&r);
+	struct rtio_sqe *cb = rtio_sqe_acquire(&r);
+	struct rtio_sqe *rd = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+
+	zassert_not_null(wr);
+	zassert_not_null(cb);
+	zassert_not_null(rd);
+
+	rtio_sqe_prep_write(wr, &file_iodev, RTIO_PRIO_NORM, msg, sizeof(msg), NULL);
+	wr->flags |= RTIO_SQE_CHAINED;
+	rtio_sqe_prep_callback_no_cqe(cb, rewind_cb, &file, NULL);
+	cb->flags |= RTIO_SQE_CHAINED;
+	rtio_sqe_prep_read(rd, &file_iodev, RTIO_PRIO_NORM, buf, sizeof(buf), buf);
+
+	zassert_ok(rtio_submit(&r, 2));
+
+	cqe = rtio_cqe_consume_block(&r);
+	zassert_equal(cqe->result, sizeof(msg), "unexpected result %d", cqe->result);
+	zassert_is_null(cqe->userdata);
+	rtio_cqe_release(&r, cqe);
+
+	cqe = rtio_cqe_consume_block(&r);
+	zassert_equal(cqe->result, sizeof(msg), "unexpected result %d", cqe->result);
+	zassert_equal_ptr(cqe->userdata, buf);
+	rtio_cqe_release(&r, cqe);
+
+	zassert_mem_equal(buf, msg, sizeof(msg));
+}
+
+ZTEST(fs_rtio, test_read_multishot)
+{
+	static const uint8_t msg[BLK_SIZE + 2] = "0123456789";
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+	uint8_t *buf;
+	uint32_t buf_len;
+	size_t read = 0;
+
+	zassert_equal(fs_write(&file, msg, sizeof(msg)), sizeof(msg));
+	zassert_ok(fs_seek(&file, 0, FS_SEEK_SET));
+
+	zassert_not_null(sqe);
+	rtio_sqe_prep_read_multishot(sqe, &file_iodev, RTIO_PRIO_NORM, NULL);
+	zassert_ok(rtio_submit(&r, 0));
+
+	/* The file is read until its end */
+	while (true) {
+		cqe = rtio_cqe_consume_block(&r);
+		if (cqe->result == 0) {
+			rtio_cqe_release(&r, cqe);
+			break;
+		}
+
+		zassert_true(cqe->result > 0, "unexpected result %d", cqe->result);
+		zassert_ok(rtio_cqe_get_mempool_buffer(&r, cqe, &buf, &buf_len));
+		zassert_mem_equal(buf, &msg[read], cqe->result);
+		read += cqe->result;
+		rtio_release_buffer(&r, buf, buf_len);
+		rtio_cqe_release(&r, cqe);
+	}
+
+	zassert_equal(read, sizeof(msg));
+}
+
+ZTEST(fs_rtio, test_unsupported_op)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+	struct rtio_cqe *cqe;
+
+	zassert_not_null(sqe);
+	rtio_sqe_prep_nop(sqe, &file_iodev, NULL);
+	sqe->op = RTIO_OP_TXRX;
+	zassert_ok(rtio_submit(&r, 1));
+
+	cqe = rtio_cqe_consume_block(&r);
+	zassert_equal(cqe->result, -ENOTSUP, "unexpected result %d", cqe->result);
+	rtio_cqe_release(&r, cqe);
+}
+
+static void *fs_rtio_setup(void)
+{
+	zassert_ok(fs_register(FS_LITTLEFS, &ram_fs));
+	zassert_ok(fs_mount(&ram_mnt));
+
+	return NULL;
+}
+
+static void fs_rtio_before(void *fixture)
+{
+	fs_file_t_init(&file);
+	zassert_ok(fs_open(&file, TEST_FILE, FS_O_CREATE | FS_O_RDWR | FS_O_TRUNC));
+}
+
+static void fs_rtio_after(void *fixture)
+{
+	zassert_ok(fs_close(&file));
+}
+
+ZTEST_SUITE(fs_rtio, NULL, fs_rtio_setup, fs_rtio_before, fs_rtio_after, NULL);
@@ -0,0 +1,266 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/storage/flash_map.h>
+#include "nvs_priv.h"
+
+#define TEST_NVS_FLASH_AREA		storage_partition
+#define TEST_NVS_FLASH_AREA_OFFSET	FIXED_PARTITION_OFFSET(TEST_NVS_FLASH_AREA)
+#define TEST_NVS_FLASH_AREA_DEV \
+	DEVICE_DT_GET(DT_MTD_FROM_FIXED_PARTITION(DT_NODELABEL(TEST_NVS_FLASH_AREA)))
+#define TEST_SECTOR_COUNT		4U
+#define TEST_ID_COUNT			20U
+
+static const struct device *const flash_dev = TEST_NVS_FLASH_AREA_DEV;
+
+struct nvs_index_fixture {
+	struct nvs_fs fs;
+	uint32_t *read_calls;
+	uint32_t values[TEST_ID_COUNT];
+};
+
+static int flash_sim_read_calls_find(struct stats_hdr *hdr, void *arg,
+				     const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_read_calls")) {
+		uint32_t **flash_read_stat = (uint32_t **)arg;
+		*flash_read_stat = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static void *setup(void)
+{
+	int err;
+	struct flash_pages_info info;
+	static struct nvs_index_fixture fixture;
+
+	zassert_true(device_is_ready(flash_dev), "flash device not ready");
+
+	fixture.fs.offset = TEST_NVS_FLASH_AREA_OFFSET;
+	err = flash_get_page_info_by_offs(flash_dev, fixture.fs.offset, &info);
+	zassert_ok(err, "Unable to get page info: %d", err);
+
+	fixture.fs.sector_size = info.size;
+	fixture.fs.sector_count = TEST_SECTOR_COUNT;
+	fixture.fs.flash_device = flash_dev;
+
+	stats_walk(stats_group_find("flash_sim_stats"), flash_sim_read_calls_find,
+		   &fixture.read_calls);
+	zassert_not_null(fixture.read_calls, "flash_read_calls stat not found");
+
+	return &fixture;
+}
+
+static void before(void *data)
+{
+	struct nvs_index_fixture *fixture = data;
+	int err;
+
+	err = flash_erase(flash_dev, fixture->fs.offset,
+			  fixture->fs.sector_size * fixture->fs.sector_count);
+	zassert_ok(err, "flash_erase failed: %d", err);
+
+	memset(fixture->values, 0, sizeof(fixture->values));
+
+	err = nvs_mount(&fixture->fs);
+	zassert_ok(err, "nvs_mount call failure: %d", err);
+}
+
+static void after(void *data)
+{
+	struct nvs_index_fixture *fixture = data;
+
+	if (fixture->fs.ready) {
+		zassert_ok(nvs_clear(&fixture->fs));
+	}
+}
+
+ZTEST_SUITE(nvs_index, NULL, setup, before, after, NULL);
+
+static off_t index_sector_offset(struct nvs_fs *fs)
+{
+	return fs->offset + (off_t)fs->sector_size * (fs->sector_count - 1);
+}
+
+/* Write entries until the data sector in use is sector, gc is done on each sector change */
+static void write_until_sector(struct nvs_index_fixture *fixture, uint16_t sector)
+{
+	uint32_t i = 0;
+	ssize_t len;
+
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != sector) {
+		fixture->values[i]++;
+		len = nvs_write(&fixture->fs, i, &fixture->values[i], sizeof(uint32_t));
+		zassert_equal(len, sizeof(uint32_t), "nvs_write failed: %d", len);
+		i = (i + 1) % TEST_ID_COUNT;
+	}
+}
+
+/* Write one entry for a few ids without triggering gc */
+static void write_some(struct nvs_index_fixture *fixture)
+{
+	ssize_t len;
+
+	for (uint32_t i = 0; i < TEST_ID_COUNT / 2; i++) {
+		fixture->values[i]++;
+		len = nvs_write(&fixture->fs, i, &fixture->values[i], sizeof(uint32_t));
+		zassert_equal(len, sizeof(uint32_t), "nvs_write failed: %d", len);
+	}
+}
+
+static void check_values(struct nvs_index_fixture *fixture)
+{
+	uint32_t value;
+	ssize_t len;
+
+	for (uint32_t i = 0; i < TEST_ID_COUNT; i++) {
+		len = nvs_read(&fixture->fs, i, &value, sizeof(value));
+		zassert_equal(len, sizeof(value), "nvs_read failed: %d", len);
+		zassert_equal(value, fixture->values[i], "unexpected value for id %u", i);
+	}
+}
+
+/* Remount and return the number of flash reads done by the mount */
+static uint32_t remount(struct nvs_index_fixture *fixture)
+{
+	uint32_t reads = *fixture->read_calls;
+	int err;
+
+	memset(fixture->fs.lookup_cache, 0xAA, sizeof(fixture->fs.lookup_cache));
+	err = nvs_mount(&fixture->fs);
+	zassert_ok(err, "nvs_mount call failure: %d", err);
+
+	return *fixture->read_calls - reads;
+}
+
+/*
+ * Test that the index sector is not used for data.
+ */
+ZTEST_F(nvs_index, test_nvs_index_sector_reserved)
+{
+	/* Go around all data sectors */
+	write_until_sector(fixture, 1);
+	write_until_sector(fixture, 2);
+	write_until_sector(fixture, 0);
+
+	check_values(fixture);
+
+	fixture->fs.sector_count = 2;
+	zassert_equal(nvs_mount(&fixture->fs), -EINVAL,
+		      "nvs_mount did not return expected err for sector count");
+	fixture->fs.sector_count = TEST_SECTOR_COUNT;
+}
+
+/*
+ * Test that the lookup cache is restored from the index at mount, with the
+ * entries written after the last checkpoint.
+ */
+ZTEST_F(nvs_index, test_nvs_index_restore)
+{
+	uint32_t cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+	uint32_t index_reads, rebuild_reads;
+	int err;
+
+	write_until_sector(fixture, 1);
+	write_until_sector(fixture, 2);
+	write_some(fixture);
+	memcpy(cache, fixture->fs.lookup_cache, sizeof(cache));
+
+	index_reads = remount(fixture);
+	zassert_mem_equal(cache, fixture->fs.lookup_cache, sizeof(cache),
+			  "lookup cache not restored from index");
+	check_values(fixture);
+
+	/* Without the index, the lookup cache is rebuilt from all entries */
+	err = flash_erase(flash_dev, index_sector_offset(&fixture->fs), fixture->fs.sector_size);
+	zassert_ok(err, "flash_erase failed: %d", err);
+
+	rebuild_reads = remount(fixture);
+	check_values(fixture);
+	zassert_true(index_reads < rebuild_reads, "index not used: %u reads, rebuild %u reads",
+		     index_reads, rebuild_reads);
+
+	/* A checkpoint is written after the rebuild */
+	zassert_equal(fixture->fs.index_slot, 1U, "index not written after rebuild");
+	memcpy(cache, fixture->fs.lookup_cache, sizeof(cache));
+	zassert_true(remount(fixture) < rebuild_reads, "index not used after rebuild");
+	zassert_mem_equal(cache, fixture->fs.lookup_cache, sizeof(cache),
+			  "lookup cache not restored from index");
+}
+
+/*
+ * Test that mount falls back to a rebuild of the lookup cache when the latest
+ * checkpoint is corrupted.
+ */
+ZTEST_F(nvs_index, test_nvs_index_corrupted)
+{
+	struct nvs_index_hdr hdr;
+	off_t offset;
+	int err;
+
+	write_until_sector(fixture, 1);
+	write_some(fixture);
+
+	/* Append a checkpoint with an invalid crc */
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.magic = NVS_INDEX_MAGIC;
+	hdr.ate_wra = fixture->fs.ate_wra;
+	hdr.data_wra = fixture->fs.data_wra;
+	hdr.cache_size = CONFIG_NVS_LOOKUP_CACHE_SIZE;
+
+	offset = index_sector_offset(&fixture->fs) + fixture->fs.index_slot *
+		 (sizeof(hdr) + sizeof(fixture->fs.lookup_cache));
+	err = flash_write(flash_dev, offset, &hdr, sizeof(hdr));
+	zassert_ok(err, "flash_write failed: %d", err);
+
+	(void)remount(fixture);
+	check_values(fixture);
+
+	/* Data written after the fallback is found after the next mount */
+	write_some(fixture);
+	write_until_sector(fixture, 2);
+	write_some(fixture);
+	(void)remount(fixture);
+	check_values(fixture);
+}
+
+/*
+ * Test that a checkpoint older than the last gc is not used.
+ */
+ZTEST_F(nvs_index, test_nvs_index_stale)
+{
+	static uint8_t index[KB(1)];
+	size_t len = fixture->fs.sector_size;
+	int err;
+
+	zassert_true(len <= sizeof(index), "sector too large for the test");
+
+	write_until_sector(fixture, 1);
+	write_some(fixture);
+
+	/* Keep the index sector content, go to the next sector and restore it */
+	err = flash_read(flash_dev, index_sector_offset(&fixture->fs), index, len);
+	zassert_ok(err, "flash_read failed: %d", err);
+
+	write_until_sector(fixture, 2);
+	write_some(fixture);
+
+	err = flash_erase(flash_dev, index_sector_offset(&fixture->fs), fixture->fs.sector_size);
+	zassert_ok(err, "flash_erase failed: %d", err);
+	err = flash_write(flash_dev, index_sector_offset(&fixture->fs), index, len);
+	zassert_ok(err, "flash_write failed: %d", err);
+
+	(void)remount(fixture);
+	check_values(fixture);
+}
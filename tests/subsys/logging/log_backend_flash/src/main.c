@@ -0,0 +1,211 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_backend_flash.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_output_dict.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+struct read_result {
+	uint32_t normal;
+	uint32_t dropped;
+	uint32_t first_seq;
+	uint32_t last_seq;
+	bool in_order;
+};
+
+static void log_flush(void)
+{
+	while (log_process()) {
+	}
+}
+
+/* Messages are hexdumps of a sequence number */
+static int read_cb(const uint8_t *data, size_t len, void *user_data)
+{
+	struct read_result *res = user_data;
+	struct log_dict_output_normal_msg_hdr_t hdr;
+	struct log_dict_output_dropped_msg_t dropped;
+	uint32_t seq;
+
+	if (data[0] == MSG_DROPPED_MSG) {
+		zassert_equal(len, sizeof(dropped));
+		memcpy(&dropped, data, sizeof(dropped));
+		res->dropped += dropped.num_dropped_messages;
+		return 0;
+	}
+
+	zassert_equal(data[0], MSG_NORMAL);
+	zassert_true(len >= sizeof(hdr));
+	memcpy(&hdr, data, sizeof(hdr));
+	zassert_equal(len, sizeof(hdr) + hdr.package_len + hdr.data_len);
+	zassert_equal(hdr.level, LOG_LEVEL_INF);
+	zassert_equal(hdr.data_len, sizeof(seq));
+
+	memcpy(&seq, &data[sizeof(hdr) + hdr.package_len], sizeof(seq));
+
+	if (res->normal == 0U) {
+		res->first_seq = seq;
+	} else if (seq != (res->last_seq + 1U)) {
+		res->in_order = false;
+	}
+
+	res->last_seq = seq;
+	res->normal++;
+
+	return 0;
+}
+
+static int stop_cb(const uint8_t *data, size_t len, void *user_data)
+{
+	return 1;
+}
+
+static void log_seq(uint32_t first, uint32_t count)
+{
+	for (uint32_t seq = first; seq < (first + count); seq++) {
+		LOG_HEXDUMP_INF(&seq, sizeof(seq), "seq");
+		log_flush();
+	}
+}
+
+static void read_all(struct read_result *res)
+{
+	memset(res, 0, sizeof(*res));
+	res->in_order = true;
+
+	zassert_ok(log_backend_flash_read(read_cb, res));
+	zassert_true(res->in_order, "records not in order");
+}
+
+ZTEST(log_backend_flash, test_store)
+{
+	struct read_result res;
+
+	log_seq(0, 10);
+
+	read_all(&res);
+	zassert_equal(res.normal, 10);
+	zassert_equal(res.first_seq, 0);
+	zassert_equal(res.last_seq, 9);
+	zassert_equal(res.dropped, 0);
+}
+
+ZTEST(log_backend_flash, test_wrap)
+{
+	const uint32_t count = FIXED_PARTITION_SIZE(log_partition) / 16;
+	struct read_result res;
+
+	/* More messages than the partition holds */
+	log_seq(0, count);
+
+	read_all(&res);
+	zassert_true(res.normal > 0U);
+	zassert_true(res.first_seq > 0U, "oldest records not erased");
+	zassert_equal(res.last_seq, count - 1);
+	zassert_equal(res.dropped, 0);
+}
+
+ZTEST(log_backend_flash, test_stop_read)
+{
+	log_seq(0, 10);
+
+	zassert_equal(log_backend_flash_read(stop_cb, NULL), 1);
+}
+
+ZTEST(log_backend_flash, test_dropped)
+{
+	uint8_t large[CONFIG_LOG_BACKEND_FLASH_RECORD_SIZE] = {0};
+	struct read_result res;
+
+	log_seq(0, 1);
+
+	/* Too large to be stored, reported before the next message */
+	LOG_HEXDUMP_INF(large, sizeof(large), "large");
+	log_flush();
+
+	log_seq(1, 1);
+
+	read_all(&res);
+	zassert_equal(res.normal, 2);
+	zassert_equal(res.dropped, 1);
+}
+
+/* Offset of the erase count in the header of a sector */
+#define SECTOR_ERASE_COUNT_OFF 12
+
+static uint32_t sector_erase_counts(const struct flash_area *fa, size_t sector_size,
+				    uint32_t *counts, uint32_t max)
+{
+	uint32_t num = MIN(fa->fa_size / sector_size, max);
+
+	for (uint32_t i = 0; i < num; i++) {
+		zassert_ok(flash_area_read(fa, i * sector_size + SECTOR_ERASE_COUNT_OFF,
+					   &counts[i], sizeof(counts[i])));
+		counts[i] = sys_le32_to_cpu(counts[i]);
+	}
+
+	return num;
+}
+
+ZTEST(log_backend_flash, test_clear_keeps_erase_counts)
+{
+	const struct flash_area *fa;
+	struct flash_pages_info info;
+	struct read_result res;
+	uint32_t prev[16];
+	uint32_t cur[16];
+	uint32_t num;
+
+	zassert_ok(flash_area_open(FIXED_PARTITION_ID(log_partition), &fa));
+	zassert_ok(flash_get_page_info_by_offs(flash_area_get_device(fa), fa->fa_off, &info));
+
+	log_seq(0, 10);
+
+	num = sector_erase_counts(fa, info.size, prev, ARRAY_SIZE(prev));
+	zassert_ok(log_backend_flash_clear());
+	zassert_equal(sector_erase_counts(fa, info.size, cur, ARRAY_SIZE(cur)), num);
+
+	/* Every sector was erased once more, none lost its count */
+	for (uint32_t i = 0; i < num; i++) {
+		zassert_true(prev[i] > 0U, "sector %u has no erase count", i);
+		zassert_equal(cur[i], prev[i] + 1U, "sector %u: erase count %u after %u", i,
+			      cur[i], prev[i]);
+	}
+
+	read_all(&res);
+	zassert_equal(res.normal, 0);
+
+	flash_area_close(fa);
+}
+
+static void *setup(void)
+{
+	const struct log_backend *backend = log_backend_get_by_name("log_backend_flash");
+
+	zassert_not_null(backend);
+	log_backend_enable(backend, NULL, LOG_LEVEL_DBG);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	log_flush();
+	zassert_ok(log_backend_flash_clear());
+}
+
+ZTEST_SUITE(log_backend_flash, NULL, setup, before, NULL, NULL);
@@ -0,0 +1,189 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/sys/cbprintf.h>
+#include <zephyr/ztest.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_INF);
+
+#define MAX_MSGS 16
+#define MAX_MSG_LEN 64
+
+#define TEST_INTERVAL_MS 100
+
+struct out_ctx {
+	char *str;
+	size_t len;
+};
+
+static char msgs[MAX_MSGS][MAX_MSG_LEN];
+static uint32_t msg_cnt;
+
+static int out(int c, void *ctx)
+{
+	struct out_ctx *out_ctx = ctx;
+
+	if (out_ctx->len < (MAX_MSG_LEN - 1)) {
+		out_ctx->str[out_ctx->len++] = (char)c;
+	}
+
+	return c;
+}
+
+static void process(struct log_backend const *const backend, union log_msg_generic *msg)
+{
+	struct out_ctx ctx;
+	size_t len;
+	uint8_t *package = log_msg_get_package(&msg->log, &len);
+
+	ARG_UNUSED(backend);
+
+	if (msg_cnt == MAX_MSGS) {
+		return;
+	}
+
+	ctx.str = msgs[msg_cnt++];
+	ctx.len = 0;
+	(void)cbpprintf(out, &ctx, package);
+	ctx.str[ctx.len] = '\0';
+}
+
+static const struct log_backend_api test_backend_api = {
+	.process = process,
+};
+
+LOG_BACKEND_DEFINE(test_backend, test_backend_api, true);
+
+static void log_flush(void)
+{
+	while (log_process()) {
+	}
+}
+
+static void check_msgs(const char *const *expected, uint32_t cnt)
+{
+	log_flush();
+
+	zassert_equal(msg_cnt, cnt, "got %u messages", msg_cnt);
+	for (uint32_t i = 0; i < cnt; i++) {
+		zassert_str_equal(msgs[i], expected[i]);
+	}
+}
+
+static void config_set(uint32_t burst, bool collapse)
+{
+	struct log_throttle_config config = {
+		.burst = burst,
+		.interval_ms = TEST_INTERVAL_MS,
+		.collapse = collapse,
+	};
+
+	zassert_ok(log_throttle_config_set(&config));
+	log_flush();
+	msg_cnt = 0;
+}
+
+ZTEST(log_throttle, test_collapse)
+{
+	static const char *const expected[] = {
+		"repeated 1",
+		"Last message repeated 4 times",
+		"other",
+	};
+
+	config_set(0, true);
+
+	for (int i = 0; i < 5; i++) {
+		LOG_INF("repeated %d", 1);
+	}
+	LOG_INF("other");
+
+	check_msgs(expected, ARRAY_SIZE(expected));
+}
+
+ZTEST(log_throttle, test_collapse_args)
+{
+	static const char *const expected[] = {
+		"value 0",
+		"value 1",
+		"value 2",
+	};
+
+	config_set(0, true);
+
+	for (int i = 0; i < 3; i++) {
+		LOG_INF("value %d", i);
+	}
+
+	check_msgs(expected, ARRAY_SIZE(expected));
+}
+
+ZTEST(log_throttle, test_collapse_interval)
+{
+	static const char *const expected[] = {
+		"repeated 1",
+		"Last message repeated 1 times",
+		"repeated 1",
+	};
+
+	config_set(0, true);
+
+	LOG_INF("repeated %d", 1);
+	LOG_INF("repeated %d", 1);
+
+	/* Repeated message is logged again once per interval */
+	k_msleep(TEST_INTERVAL_MS);
+	LOG_INF("repeated %d", 1);
+
+	check_msgs(expected, ARRAY_SIZE(expected));
+}
+
+ZTEST(log_throttle, test_rate)
+{
+	static const char *const expected[] = {
+		"rate 0",
+		"rate 1",
+		"rate 2",
+		"7 messages dropped by rate limiting",
+		"rate 10",
+	};
+
+	config_set(3, false);
+
+	for (int i = 0; i < 10; i++) {
+		LOG_INF("rate %d", i);
+	}
+
+	k_msleep(TEST_INTERVAL_MS);
+	LOG_INF("rate %d", 10);
+
+	check_msgs(expected, ARRAY_SIZE(expected));
+}
+
+ZTEST(log_throttle, test_disabled)
+{
+	config_set(0, false);
+
+	for (int i = 0; i < 5; i++) {
+		LOG_INF("repeated %d", 1);
+	}
+
+	log_flush();
+	zassert_equal(msg_cnt, 5);
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	config_set(CONFIG_LOG_THROTTLE_BURST, IS_ENABLED(CONFIG_LOG_THROTTLE_COLLAPSE));
+}
+
+ZTEST_SUITE(log_throttle, NULL, NULL, NULL, after, NULL);
@@ -746,6 +746,54 @@ ZTEST(rtio_api, test_rtio_delay)
 	}
 }
 
+#define RTIO_BATCH_NUM_ELEMS 4
+
+RTIO_DEFINE(r_batch, RTIO_BATCH_NUM_ELEMS, RTIO_BATCH_NUM_ELEMS);
+
+/**
+ * @brief Test consuming a batch of completions
+ *
+ * Ensures that all the completions of a batch are returned once available,
+ * and that waiting for completions that never come times out.
+ */
+ZTEST(rtio_api, test_rtio_consume_block_n)
+{
+	struct rtio *r = &r_batch;
+	struct rtio_cqe *cqes[RTIO_BATCH_NUM_ELEMS];
+	struct rtio_sqe *sqe;
+	size_t count;
+
+	for (size_t i = 0; i < RTIO_BATCH_NUM_ELEMS; i++) {
+		sqe = rtio_sqe_acquire(r);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_delay(sqe, K_MSEC(10 * (i + 1)), (void *)i);
+	}
+
+	zassert_ok(rtio_submit(r, 0), "Should return ok from rtio_execute");
+
+	count = rtio_cqe_consume_block_n(r, cqes, RTIO_BATCH_NUM_ELEMS, K_SECONDS(1));
+	zassert_equal(count, RTIO_BATCH_NUM_ELEMS, "Expected all the cqes, got %zu", count);
+
+	for (size_t i = 0; i < count; i++) {
+		zassert_ok(cqes[i]->result, "Result should be ok");
+		zassert_equal((size_t)cqes[i]->userdata, i, "Expected cqes in order");
+		rtio_cqe_release(r, cqes[i]);
+	}
+
+	count = rtio_cqe_consume_block_n(r, cqes, 1, K_MSEC(50));
+	zassert_equal(count, 0, "Expected no cqe");
+
+	/* A partial batch is returned when the timeout expires */
+	sqe = rtio_sqe_acquire(r);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_delay(sqe, K_MSEC(10), NULL);
+	zassert_ok(rtio_submit(r, 0), "Should return ok from rtio_execute");
+
+	count = rtio_cqe_consume_block_n(r, cqes, 2, K_MSEC(100));
+	zassert_equal(count, 1, "Expected a single cqe, got %zu", count);
+	rtio_cqe_release(r, cqes[0]);
+}
+
 #define THROUGHPUT_ITERS 100000
 RTIO_DEFINE(r_throughput, SQE_POOL_SIZE, CQE_POOL_SIZE);
 
@@ -0,0 +1,221 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+
+struct frame_msg {
+	uint32_t seq;
+	uint8_t data[60];
+};
+
+static bool frame_validator(const void *msg, size_t msg_size)
+{
+	const struct frame_msg *frame = msg;
+
+	return (msg_size == sizeof(struct frame_msg)) && (frame->seq != 0U);
+}
+
+ZBUS_CHAN_DEFINE(frame_chan, struct frame_msg, frame_validator, NULL,
+		 ZBUS_OBSERVERS(frame_lis, frame_msub), ZBUS_MSG_INIT(.seq = 0));
+
+static const void *lis_msg;
+static uint32_t lis_seq;
+
+static void frame_lis_cb(const struct zbus_channel *chan)
+{
+	const struct frame_msg *frame = zbus_chan_const_msg(chan);
+
+	lis_msg = frame;
+	lis_seq = frame->seq;
+}
+
+ZBUS_LISTENER_DEFINE(frame_lis, frame_lis_cb);
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(frame_msub);
+
+static void publish_loan(uint32_t seq, const void **data)
+{
+	struct net_buf *buf;
+	struct frame_msg *frame;
+
+	zassert_ok(zbus_chan_loan(&frame_chan, &buf, K_NO_WAIT));
+	zassert_equal(buf->len, sizeof(struct frame_msg));
+
+	frame = (struct frame_msg *)buf->data;
+	frame->seq = seq;
+	memset(frame->data, (uint8_t)seq, sizeof(frame->data));
+	*data = frame;
+
+	zassert_ok(zbus_chan_commit(&frame_chan, buf, K_MSEC(100)));
+}
+
+ZTEST(msg_loan, test_commit_zero_copy)
+{
+	const struct zbus_channel *chan;
+	const struct frame_msg *frame;
+	const void *data;
+	struct net_buf *buf;
+	struct frame_msg msg;
+
+	publish_loan(1, &data);
+
+	/* Listeners see the loaned buffer as the channel's message */
+	zassert_equal(lis_seq, 1);
+	zassert_equal_ptr(lis_msg, data);
+
+	/* Msg subscribers get a reference to the same buffer */
+	zassert_ok(zbus_sub_wait_msg_buf(&frame_msub, &chan, &buf, K_MSEC(100)));
+	zassert_equal_ptr(chan, &frame_chan);
+	zassert_equal_ptr(buf->data, data);
+	frame = (const struct frame_msg *)buf->data;
+	zassert_equal(frame->seq, 1);
+	net_buf_unref(buf);
+
+	zassert_ok(zbus_chan_read(&frame_chan, &msg, K_MSEC(100)));
+	zassert_equal(msg.seq, 1);
+	zassert_equal(msg.data[0], 1);
+}
+
+ZTEST(msg_loan, test_claim_keeps_message)
+{
+	const struct zbus_channel *chan;
+	const void *data;
+	struct frame_msg msg;
+
+	publish_loan(2, &data);
+	zassert_ok(zbus_sub_wait_msg(&frame_msub, &chan, &msg, K_MSEC(100)));
+	zassert_equal(msg.seq, 2);
+
+	/* The message claimed is the channel's own, not the shared buffer */
+	zassert_ok(zbus_chan_claim(&frame_chan, K_MSEC(100)));
+	zassert_equal_ptr(zbus_chan_msg(&frame_chan), frame_chan.message);
+	zassert_equal(((struct frame_msg *)zbus_chan_msg(&frame_chan))->seq, 2);
+	((struct frame_msg *)zbus_chan_msg(&frame_chan))->seq = 3;
+	zassert_ok(zbus_chan_finish(&frame_chan));
+
+	zassert_ok(zbus_chan_read(&frame_chan, &msg, K_MSEC(100)));
+	zassert_equal(msg.seq, 3);
+}
+
+ZTEST(msg_loan, test_pub_after_commit)
+{
+	const struct zbus_channel *chan;
+	const void *data;
+	struct frame_msg msg = {.seq = 5};
+
+	publish_loan(4, &data);
+
+	zassert_ok(zbus_chan_pub(&frame_chan, &msg, K_MSEC(100)));
+	zassert_equal(lis_seq, 5);
+	zassert_equal_ptr(lis_msg, frame_chan.message);
+
+	zassert_ok(zbus_sub_wait_msg(&frame_msub, &chan, &msg, K_MSEC(100)));
+	zassert_equal(msg.seq, 4);
+	zassert_ok(zbus_sub_wait_msg(&frame_msub, &chan, &msg, K_MSEC(100)));
+	zassert_equal(msg.seq, 5);
+}
+
+ZTEST(msg_loan, test_commit_invalid)
+{
+	const struct zbus_channel *chan;
+	struct net_buf *buf;
+	struct frame_msg msg;
+
+	zassert_ok(zbus_chan_loan(&frame_chan, &buf, K_NO_WAIT));
+	((struct frame_msg *)buf->data)->seq = 0;
+
+	zassert_equal(zbus_chan_commit(&frame_chan, buf, K_MSEC(100)), -ENOMSG);
+	zassert_equal(zbus_sub_wait_msg(&frame_msub, &chan, &msg, K_NO_WAIT), -ENOMSG);
+}
+
+static void drain_msub(void)
+{
+	const struct zbus_channel *chan;
+	struct net_buf *buf;
+
+	while (zbus_sub_wait_msg_buf(&frame_msub, &chan, &buf, K_NO_WAIT) == 0) {
+		net_buf_unref(buf);
+	}
+}
+
+#define READER_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define READ_COMMITS      200
+
+static K_THREAD_STACK_DEFINE(reader_stack, READER_STACK_SIZE);
+static struct k_thread reader_thread;
+static atomic_t reader_stop;
+static uint32_t reader_reads;
+static uint32_t reader_torn;
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	struct frame_msg msg;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&reader_stop)) {
+		if (zbus_chan_read(&frame_chan, &msg, K_MSEC(100)) != 0) {
+			reader_torn++;
+			continue;
+		}
+
+		reader_reads++;
+
+		/* Every message committed has all its data bytes equal to its sequence number */
+		for (size_t i = 0; i < sizeof(msg.data); i++) {
+			if (msg.data[i] != (uint8_t)msg.seq) {
+				reader_torn++;
+				break;
+			}
+		}
+	}
+}
+
+ZTEST(msg_loan, test_read_during_commits)
+{
+	const void *data;
+
+	publish_loan(100, &data);
+	drain_msub();
+
+	atomic_clear(&reader_stop);
+	reader_reads = 0;
+	reader_torn = 0;
+
+	/* The reader is preempted by the commits, in the middle of its reads at times */
+	k_thread_create(&reader_thread, reader_stack, K_THREAD_STACK_SIZEOF(reader_stack),
+			reader_entry, NULL, NULL, NULL, K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+
+	for (uint32_t seq = 101; seq < 101 + READ_COMMITS; seq++) {
+		k_sleep(K_TICKS(1));
+		publish_loan(seq, &data);
+		drain_msub();
+	}
+
+	atomic_set(&reader_stop, 1);
+	zassert_ok(k_thread_join(&reader_thread, K_SECONDS(1)));
+
+	zassert_true(reader_reads > 0U, "No read done");
+	zassert_equal(reader_torn, 0U, "%u reads of %u failed or torn", reader_torn,
+		      reader_reads);
+}
+
+static void msg_loan_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	drain_msub();
+
+	lis_msg = NULL;
+	lis_seq = 0;
+}
+
+ZTEST_SUITE(msg_loan, NULL, NULL, msg_loan_before, NULL, NULL);
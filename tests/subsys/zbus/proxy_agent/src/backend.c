@@ -0,0 +1,94 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Backend delivering the messages sent on an instance to the endpoint of its
+ * peer instance, as if both instances were on different cores.
+ */
+
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/ipc/ipc_service_backend.h>
+#include <zephyr/kernel.h>
+
+#include "backend.h"
+
+#define DT_DRV_COMPAT zephyr_zbus_proxy_test_backend
+
+struct backend_data {
+	const struct ipc_ept_cfg *cfg;
+	uint32_t sends;
+};
+
+struct backend_config {
+	const struct device *peer;
+};
+
+static int send(const struct device *instance, void *token, const void *data, size_t len)
+{
+	const struct backend_config *config = instance->config;
+	struct backend_data *peer_data = config->peer->data;
+	struct backend_data *own_data = instance->data;
+
+	if ((peer_data->cfg == NULL) || (strcmp(peer_data->cfg->name, own_data->cfg->name) != 0)) {
+		return -ENOTCONN;
+	}
+
+	own_data->sends++;
+
+	peer_data->cfg->cb.received(data, len, peer_data->cfg->priv);
+
+	return len;
+}
+
+static int register_ept(const struct device *instance, void **token,
+			const struct ipc_ept_cfg *cfg)
+{
+	const struct backend_config *config = instance->config;
+	struct backend_data *peer_data = config->peer->data;
+	struct backend_data *data = instance->data;
+
+	data->cfg = cfg;
+
+	if ((peer_data->cfg != NULL) && (strcmp(peer_data->cfg->name, cfg->name) == 0)) {
+		peer_data->cfg->cb.bound(peer_data->cfg->priv);
+		cfg->cb.bound(cfg->priv);
+	}
+
+	return 0;
+}
+
+static int deregister_ept(const struct device *instance, void *token)
+{
+	struct backend_data *data = instance->data;
+
+	data->cfg = NULL;
+
+	return 0;
+}
+
+static const struct ipc_service_backend backend_ops = {
+	.send = send,
+	.register_endpoint = register_ept,
+	.deregister_endpoint = deregister_ept,
+};
+
+uint32_t test_backend_sends(const struct device *instance)
+{
+	const struct backend_data *data = instance->data;
+
+	return data->sends;
+}
+
+#define DEFINE_BACKEND_DEVICE(i)                                                                   \
+	static const struct backend_config backend_config_##i = {                                  \
+		.peer = DEVICE_DT_GET(DT_INST_PHANDLE(i, peer)),                                   \
+	};                                                                                         \
+                                                                                                   \
+	static struct backend_data backend_data_##i;                                               \
+                                                                                                   \
+	DEVICE_DT_INST_DEFINE(i, NULL, NULL, &backend_data_##i, &backend_config_##i, POST_KERNEL,  \
+			      CONFIG_IPC_SERVICE_REG_BACKEND_PRIORITY, &backend_ops);
+
+DT_INST_FOREACH_STATUS_OKAY(DEFINE_BACKEND_DEVICE)
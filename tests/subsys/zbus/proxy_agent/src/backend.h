@@ -0,0 +1,15 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TEST_ZBUS_PROXY_AGENT_BACKEND_H_
+#define TEST_ZBUS_PROXY_AGENT_BACKEND_H_
+
+#include <zephyr/device.h>
+
+/* Number of messages sent on an instance */
+uint32_t test_backend_sends(const struct device *instance);
+
+#endif /* TEST_ZBUS_PROXY_AGENT_BACKEND_H_ */
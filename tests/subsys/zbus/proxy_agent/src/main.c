@@ -0,0 +1,181 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/zbus/zbus_proxy_agent.h>
+#include <zephyr/ztest.h>
+
+#include "backend.h"
+
+#define BATCH_WAIT K_MSEC(CONFIG_ZBUS_PROXY_AGENT_BATCH_DELAY_MS * 2)
+
+struct temp_msg {
+	int32_t value;
+};
+
+struct cmd_msg {
+	uint8_t op;
+	uint8_t arg[5];
+};
+
+/* Channels of the first core, and their copies on the second one */
+ZBUS_CHAN_DEFINE(temp_chan, struct temp_msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+ZBUS_CHAN_DEFINE(cmd_mirror_chan, struct cmd_msg, NULL, NULL, ZBUS_OBSERVERS(cmd_lis),
+		 ZBUS_MSG_INIT(0));
+ZBUS_CHAN_DEFINE(temp_mirror_chan, struct temp_msg, NULL, NULL,
+		 ZBUS_OBSERVERS(temp_lis, republish_lis), ZBUS_MSG_INIT(0));
+ZBUS_CHAN_DEFINE(cmd_chan, struct cmd_msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+static atomic_t temp_notifications;
+static atomic_t cmd_notifications;
+static atomic_t republish;
+
+static void temp_lis_cb(const struct zbus_channel *chan)
+{
+	atomic_inc(&temp_notifications);
+}
+
+ZBUS_LISTENER_DEFINE(temp_lis, temp_lis_cb);
+
+static void cmd_lis_cb(const struct zbus_channel *chan)
+{
+	atomic_inc(&cmd_notifications);
+}
+
+ZBUS_LISTENER_DEFINE(cmd_lis, cmd_lis_cb);
+
+#define REPUBLISH_OP 21
+
+/* Publishes another channel of the second core when a temperature is received */
+static void republish_lis_cb(const struct zbus_channel *chan)
+{
+	struct cmd_msg cmd = {.op = REPUBLISH_OP};
+
+	if (atomic_get(&republish) != 0) {
+		zassert_ok(zbus_chan_pub(&cmd_chan, &cmd, K_NO_WAIT));
+	}
+}
+
+ZBUS_LISTENER_DEFINE(republish_lis, republish_lis_cb);
+
+#define IPC0 DEVICE_DT_GET(DT_NODELABEL(ipc0))
+#define IPC1 DEVICE_DT_GET(DT_NODELABEL(ipc1))
+
+ZBUS_PROXY_AGENT_DEFINE(agent0, IPC0, "zbus", temp_chan, cmd_mirror_chan);
+ZBUS_PROXY_AGENT_DEFINE(agent1, IPC1, "zbus", temp_mirror_chan, cmd_chan);
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Let the publications of the previous test be forwarded */
+	k_sleep(BATCH_WAIT);
+
+	atomic_clear(&temp_notifications);
+	atomic_clear(&cmd_notifications);
+}
+
+ZTEST(proxy_agent, test_bound)
+{
+	zassert_true(zbus_proxy_agent_is_bound(&agent0));
+	zassert_true(zbus_proxy_agent_is_bound(&agent1));
+}
+
+ZTEST(proxy_agent, test_forward)
+{
+	struct temp_msg temp = {.value = 42};
+	struct cmd_msg cmd = {.op = 7, .arg = {1, 2, 3, 4, 5}};
+	struct cmd_msg cmd_read;
+
+	zassert_ok(zbus_chan_pub(&temp_chan, &temp, K_MSEC(100)));
+	zassert_ok(zbus_chan_pub(&cmd_chan, &cmd, K_MSEC(100)));
+
+	k_sleep(BATCH_WAIT);
+
+	temp.value = 0;
+	zassert_ok(zbus_chan_read(&temp_mirror_chan, &temp, K_MSEC(100)));
+	zassert_equal(temp.value, 42);
+	zassert_equal(atomic_get(&temp_notifications), 1);
+
+	zassert_ok(zbus_chan_read(&cmd_mirror_chan, &cmd_read, K_MSEC(100)));
+	zassert_mem_equal(&cmd_read, &cmd, sizeof(cmd));
+	zassert_equal(atomic_get(&cmd_notifications), 1);
+}
+
+ZTEST(proxy_agent, test_coalescing)
+{
+	uint32_t sends0 = test_backend_sends(IPC0);
+	struct temp_msg temp;
+
+	for (int i = 1; i <= 5; i++) {
+		temp.value = i;
+		zassert_ok(zbus_chan_pub(&temp_chan, &temp, K_MSEC(100)));
+	}
+
+	k_sleep(BATCH_WAIT);
+
+	/* Only the last message is forwarded */
+	zassert_ok(zbus_chan_read(&temp_mirror_chan, &temp, K_MSEC(100)));
+	zassert_equal(temp.value, 5);
+	zassert_equal(atomic_get(&temp_notifications), 1);
+	zassert_equal(test_backend_sends(IPC0), sends0 + 1);
+}
+
+ZTEST(proxy_agent, test_batching)
+{
+	uint32_t sends0 = test_backend_sends(IPC0);
+	uint32_t sends1 = test_backend_sends(IPC1);
+	struct temp_msg temp = {.value = -3};
+	struct cmd_msg cmd = {.op = 9};
+
+	/* Both channels of the first core, forwarded in one message */
+	zassert_ok(zbus_chan_pub(&temp_chan, &temp, K_MSEC(100)));
+	zassert_ok(zbus_chan_pub(&cmd_mirror_chan, &cmd, K_MSEC(100)));
+	zassert_equal(atomic_get(&cmd_notifications), 1);
+
+	k_sleep(BATCH_WAIT);
+
+	zassert_equal(test_backend_sends(IPC0), sends0 + 1);
+	zassert_equal(atomic_get(&temp_notifications), 1);
+
+	cmd.op = 0;
+	zassert_ok(zbus_chan_read(&cmd_chan, &cmd, K_MSEC(100)));
+	zassert_equal(cmd.op, 9);
+
+	/* The messages received are not forwarded back */
+	zassert_equal(test_backend_sends(IPC1), sends1);
+}
+
+ZTEST(proxy_agent, test_republish_received)
+{
+	uint32_t sends1 = test_backend_sends(IPC1);
+	struct temp_msg temp = {.value = 11};
+	struct cmd_msg cmd;
+
+	atomic_set(&republish, 1);
+
+	zassert_ok(zbus_chan_pub(&temp_chan, &temp, K_MSEC(100)));
+
+	/* The temperature is forwarded, then the command published by the listener */
+	k_sleep(BATCH_WAIT);
+	k_sleep(BATCH_WAIT);
+
+	atomic_clear(&republish);
+
+	zassert_equal(atomic_get(&temp_notifications), 1);
+
+	cmd.op = 0;
+	zassert_ok(zbus_chan_read(&cmd_mirror_chan, &cmd, K_MSEC(100)));
+	zassert_equal(cmd.op, REPUBLISH_OP);
+	zassert_equal(atomic_get(&cmd_notifications), 1);
+
+	/* Only the command is forwarded, not the temperature received */
+	zassert_equal(test_backend_sends(IPC1), sends1 + 1);
+}
+
+ZTEST_SUITE(proxy_agent, NULL, NULL, before, NULL, NULL);
@@ -74,6 +74,40 @@ ZTEST(crc, test_crc32_ieee)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4);
 }
 
+static uint32_t crc32_reflected_bitwise(uint32_t poly, uint32_t crc, const uint8_t *data,
+					size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+		}
+	}
+
+	return crc;
+}
+
+/* Check all CRC-32 implementations with lengths and alignments covering the sliced loops */
+ZTEST(crc, test_crc32_lengths)
+{
+	uint8_t data[80];
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 37 + 11);
+	}
+
+	for (size_t offset = 0; offset < 8; offset++) {
+		for (size_t len = 0; len <= sizeof(data) - offset; len++) {
+			zassert_equal(crc32_ieee(&data[offset], len),
+				      ~crc32_reflected_bitwise(0xedb88320, ~0U, &data[offset], len),
+				      "crc32_ieee offset %zu len %zu", offset, len);
+			zassert_equal(crc32_c(0, &data[offset], len, true, true),
+				      ~crc32_reflected_bitwise(0x82f63b78, ~0U, &data[offset], len),
+				      "crc32_c offset %zu len %zu", offset, len);
+		}
+	}
+}
+
 ZTEST(crc, test_crc24_pgp)
 {
 	uint8_t test1[] = { 'A' };